@@ -0,0 +1,131 @@
+#include "bench_core.h"
+#include <stdio.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_ll.h"
+
+#if defined(_WIN32)
+#include "windows.h"
+#else
+#include <time.h>
+#endif /* defined(_WIN32) */
+
+/* Memory for built-in allocator */
+static uint8_t mem_region_1[0x40000];
+static const lwcell_mem_region_t mem_regions[] = {
+    {mem_region_1, sizeof(mem_region_1)},
+};
+
+/* Send function assigned to low-level structure on initialization */
+static lwcell_ll_send_fn ll_send_fn;
+
+/**
+ * \brief           Assign memory regions to built-in allocator
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_core_mem_init(void) {
+    if (!lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions))) {
+        fprintf(stderr, "Could not assign memory\r\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Set send function, used when stack is started with \ref lwcell_init
+ * \param[in]       send_fn: Function to receive data sent to device
+ */
+void
+bench_core_set_send_fn(lwcell_ll_send_fn send_fn) {
+    ll_send_fn = send_fn;
+}
+
+/**
+ * \brief           Setup minimal core state without threads
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_core_init(void) {
+    if (bench_core_mem_init() != 0) {
+        return -1;
+    }
+    lwcell_sys_init();
+    if (!lwcell_sys_sem_create(&lwcell.sem_sync, 1)
+        || !lwcell_sys_mbox_create(&lwcell.mbox_producer, LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE)
+        || !lwcell_sys_mbox_create(&lwcell.mbox_process, LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE)) {
+        fprintf(stderr, "Could not create system resources\r\n");
+        return -1;
+    }
+    lwcell.status.f.initialized = 1;
+    lwcell.status.f.dev_present = 1;
+    lwcell.m.sim.state = LWCELL_SIM_STATE_READY;
+    return 0;
+}
+
+/**
+ * \brief           Drain commands generated internally by the stack,
+ *                  as there is no producer thread to execute them
+ */
+void
+bench_core_drain(void) {
+    lwcell_msg_t* msg;
+    void* m;
+
+    while (lwcell_sys_mbox_getnow(&lwcell.mbox_producer, (void**)&msg)) {
+        if (msg != NULL && !msg->is_blocking) {
+            LWCELL_MSG_VAR_FREE(msg);
+        }
+    }
+    while (lwcell_sys_mbox_getnow(&lwcell.mbox_process, &m)) {}
+}
+
+/**
+ * \brief           Get monotonic time in nanoseconds
+ * \return          Time in nanoseconds
+ */
+uint64_t
+bench_now_ns(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1000000000.0 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif /* defined(_WIN32) */
+}
+
+/**
+ * \brief           Sleep for specific time
+ * \param[in]       ns: Time to sleep in nanoseconds
+ */
+void
+bench_sleep_ns(uint64_t ns) {
+#if defined(_WIN32)
+    Sleep((DWORD)(ns / 1000000ULL));
+#else
+    struct timespec ts = {
+        .tv_sec = (time_t)(ns / 1000000000ULL),
+        .tv_nsec = (long)(ns % 1000000000ULL),
+    };
+    nanosleep(&ts, NULL);
+#endif /* defined(_WIN32) */
+}
+
+/**
+ * \brief           Low-level initialization, only send function is set for host tools
+ */
+lwcellr_t
+lwcell_ll_init(lwcell_ll_t* ll) {
+    ll->send_fn = ll_send_fn;
+    return lwcellOK;
+}
+
+lwcellr_t
+lwcell_ll_deinit(lwcell_ll_t* ll) {
+    LWCELL_UNUSED(ll);
+    return lwcellOK;
+}
@@ -0,0 +1,29 @@
+/*
+ * Minimal core setup shared by host tools.
+ *
+ * With bench_core_init, threads are not started and tools call internal functions directly,
+ * with message queues created so that internally generated commands can be drained.
+ * Tools running full stack with lwcell_init only use memory setup and send function hook.
+ */
+#ifndef BENCH_CORE_HDR_H
+#define BENCH_CORE_HDR_H
+
+#include <stdint.h>
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+int bench_core_mem_init(void);
+void bench_core_set_send_fn(lwcell_ll_send_fn send_fn);
+int bench_core_init(void);
+void bench_core_drain(void);
+uint64_t bench_now_ns(void);
+void bench_sleep_ns(uint64_t ns);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* BENCH_CORE_HDR_H */
@@ -0,0 +1,545 @@
+/*
+ * Host benchmark suite for library hot paths.
+ *
+ * Each benchmark runs fixed workload several times and reports
+ * best result as machine readable JSON, to stdout or to file given as first argument.
+ * When second argument is given and LWCELL_CFG_TRACE is enabled, trace ring is dumped to that file
+ * at the end, to be decoded with lwcell_trace_decode.
+ *
+ * Benchmarks run without device communication and without threads,
+ * they manipulate internal state directly, the same way device would do it.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_private.h"
+#include "bench_core.h"
+
+/*
+ * Include MQTT client source directly to get access
+ * to its private encoder and parser functions
+ */
+#include "apps/mqtt/lwcell_mqtt_client.c"
+
+/* Number of times each benchmark is repeated, best run is reported */
+#define BENCH_RUNS 5
+
+/**
+ * \brief           Single benchmark result
+ */
+typedef struct {
+    const char* name;    /*!< Benchmark name */
+    uint64_t iterations; /*!< Number of operations per run */
+    uint64_t bytes;      /*!< Number of bytes processed per run, `0` if not applicable */
+    uint64_t lines;      /*!< Number of AT lines processed per run, `0` if not applicable */
+    uint64_t ns;         /*!< Duration of best run in nanoseconds */
+} bench_result_t;
+
+static bench_result_t results[32];
+static size_t results_cnt;
+
+/* Transcripts used for parser benchmark */
+static char transcript[0x10000];
+static size_t transcript_len, transcript_lines;
+
+/* Dummy message to simulate active command */
+static lwcell_msg_t bench_msg;
+
+/* Prevent compiler from removing benchmarked code */
+static volatile size_t bench_sink;
+
+/**
+ * \brief           Run benchmark and save best result
+ * \param[in]       name: Benchmark name
+ * \param[in]       fn: Function to run, returns number of operations executed
+ * \param[in]       bytes: Number of bytes processed in single run
+ * \param[in]       lines: Number of lines processed in single run
+ */
+static void
+bench_run(const char* name, uint64_t (*fn)(void), uint64_t bytes, uint64_t lines) {
+    bench_result_t* r = &results[results_cnt++];
+
+    r->name = name;
+    r->bytes = bytes;
+    r->lines = lines;
+    r->ns = UINT64_MAX;
+    fn(); /* Warm-up */
+    for (size_t i = 0; i < BENCH_RUNS; ++i) {
+        uint64_t start, duration;
+
+        start = bench_now_ns();
+        r->iterations = fn();
+        duration = bench_now_ns() - start;
+        if (duration < r->ns) {
+            r->ns = duration > 0 ? duration : 1;
+        }
+    }
+}
+
+/******************************************************************************************************/
+/* Parser benchmarks                                                                                  */
+/******************************************************************************************************/
+
+#define PARSER_LOOPS 200
+
+static lwcellr_t
+bench_conn_evt_fn(lwcell_evt_t* evt) {
+    if (lwcell_evt_get_type(evt) == LWCELL_EVT_CONN_RECV) {
+        bench_sink += lwcell_pbuf_length(lwcell_evt_conn_recv_get_buff(evt), 1);
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Append string to transcript
+ * \param[in]       str: String to append
+ */
+static void
+transcript_add(const char* str) {
+    size_t len = strlen(str);
+
+    memcpy(&transcript[transcript_len], str, len);
+    transcript_len += len;
+    for (; *str != '\0'; ++str) {
+        transcript_lines += *str == '\n';
+    }
+}
+
+/**
+ * \brief           Prepare core state for parser benchmarks
+ */
+static void
+parser_prepare(void) {
+    lwcell.m.conns[0].status.f.active = 1;
+    lwcell.m.conns[0].evt_func = bench_conn_evt_fn;
+}
+
+static uint64_t
+bench_parser_run(void) {
+    for (size_t i = 0; i < PARSER_LOOPS; ++i) {
+        lwcelli_process(transcript, transcript_len);
+    }
+    return PARSER_LOOPS;
+}
+
+/**
+ * \brief           Parse command responses while command is active
+ */
+static void
+bench_parser_cmd(void) {
+    transcript_len = transcript_lines = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        transcript_add("\r\n+CSQ: 21,0\r\n\r\nOK\r\n");
+    }
+    bench_msg.cmd_def = bench_msg.cmd = LWCELL_CMD_CSQ_GET;
+    lwcell.msg = &bench_msg;
+    bench_run("parser_cmd_csq", bench_parser_run, PARSER_LOOPS * transcript_len, PARSER_LOOPS * transcript_lines);
+    lwcell.msg = NULL;
+}
+
+/**
+ * \brief           Parse unsolicited result codes without active command
+ */
+static void
+bench_parser_urc(void) {
+    transcript_len = transcript_lines = 0;
+    for (size_t i = 0; i < 50; ++i) {
+        transcript_add("\r\nRING\r\n");
+        transcript_add("\r\n+CLCC: 1,1,4,0,0,\"+38640123456\",145,\"\"\r\n");
+        transcript_add("\r\n+CPIN: READY\r\n");
+        transcript_add("\r\nCall Ready\r\n");
+        transcript_add("\r\nSMS Ready\r\n");
+    }
+    bench_run("parser_urc", bench_parser_run, PARSER_LOOPS * transcript_len, PARSER_LOOPS * transcript_lines);
+}
+
+/**
+ * \brief           Parse received network data
+ */
+static void
+bench_parser_ipd(void) {
+    char hdr[32];
+
+    transcript_len = transcript_lines = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        sprintf(hdr, "\r\n+RECEIVE,0,%d:\r\n", 1024);
+        transcript_add(hdr);
+        memset(&transcript[transcript_len], 'a', 1024);
+        transcript_len += 1024;
+    }
+    bench_run("parser_ipd", bench_parser_run, PARSER_LOOPS * transcript_len, PARSER_LOOPS * transcript_lines);
+}
+
+/******************************************************************************************************/
+/* Memory benchmarks                                                                                  */
+/******************************************************************************************************/
+
+#define MEM_LOOPS 10000
+
+static uint64_t
+bench_mem_same_size(void) {
+    for (size_t i = 0; i < MEM_LOOPS; ++i) {
+        void* ptr = lwcell_mem_malloc(64);
+        lwcell_mem_free(ptr);
+    }
+    return MEM_LOOPS;
+}
+
+static uint64_t
+bench_mem_fragmented(void) {
+    void* ptrs[32];
+
+    for (size_t i = 0; i < MEM_LOOPS / LWCELL_ARRAYSIZE(ptrs); ++i) {
+        for (size_t j = 0; j < LWCELL_ARRAYSIZE(ptrs); ++j) {
+            ptrs[j] = lwcell_mem_malloc(16 + (j * 37) % 512);
+        }
+        /* Free even first, then odd to force block merging */
+        for (size_t j = 0; j < LWCELL_ARRAYSIZE(ptrs); j += 2) {
+            lwcell_mem_free(ptrs[j]);
+        }
+        for (size_t j = 1; j < LWCELL_ARRAYSIZE(ptrs); j += 2) {
+            lwcell_mem_free(ptrs[j]);
+        }
+    }
+    return (MEM_LOOPS / LWCELL_ARRAYSIZE(ptrs)) * LWCELL_ARRAYSIZE(ptrs);
+}
+
+/******************************************************************************************************/
+/* Packet buffer benchmarks                                                                           */
+/******************************************************************************************************/
+
+#define PBUF_LOOPS      2000
+#define PBUF_CHAIN_LEN  8
+#define PBUF_CHAIN_SIZE 256
+
+static lwcell_pbuf_p pbuf_chain;
+static uint8_t pbuf_linear[PBUF_CHAIN_LEN * PBUF_CHAIN_SIZE];
+
+/**
+ * \brief           Create chain of packet buffers, needle is placed at the end
+ * \return          Head of new chain
+ */
+static lwcell_pbuf_p
+pbuf_chain_create(void) {
+    lwcell_pbuf_p head = NULL, p;
+
+    for (size_t i = 0; i < PBUF_CHAIN_LEN; ++i) {
+        p = lwcell_pbuf_new(PBUF_CHAIN_SIZE);
+        memset(lwcell_pbuf_data(p), 'x', PBUF_CHAIN_SIZE);
+        if (head == NULL) {
+            head = p;
+        } else {
+            lwcell_pbuf_cat(head, p);
+        }
+    }
+    lwcell_pbuf_take(head, "\r\nSEND OK\r\n", 11, PBUF_CHAIN_LEN * PBUF_CHAIN_SIZE - 11);
+    return head;
+}
+
+static uint64_t
+bench_pbuf_cat(void) {
+    for (size_t i = 0; i < PBUF_LOOPS; ++i) {
+        lwcell_pbuf_free(pbuf_chain_create());
+    }
+    return PBUF_LOOPS;
+}
+
+static uint64_t
+bench_pbuf_memfind(void) {
+    for (size_t i = 0; i < PBUF_LOOPS; ++i) {
+        bench_sink += lwcell_pbuf_memfind(pbuf_chain, "SEND OK", 7, 0);
+    }
+    return PBUF_LOOPS;
+}
+
+static uint64_t
+bench_pbuf_copy(void) {
+    for (size_t i = 0; i < PBUF_LOOPS; ++i) {
+        bench_sink += lwcell_pbuf_copy(pbuf_chain, pbuf_linear, sizeof(pbuf_linear), 0);
+    }
+    return PBUF_LOOPS;
+}
+
+/******************************************************************************************************/
+/* Ring buffer benchmarks                                                                             */
+/******************************************************************************************************/
+
+#define BUFF_LOOPS 100000
+
+static lwcell_buff_t bench_buff;
+
+static uint64_t
+bench_buff_write_read(void) {
+    uint8_t data[64] = {0};
+
+    for (size_t i = 0; i < BUFF_LOOPS; ++i) {
+        lwcell_buff_write(&bench_buff, data, sizeof(data));
+        bench_sink += lwcell_buff_read(&bench_buff, data, sizeof(data));
+    }
+    return BUFF_LOOPS;
+}
+
+/******************************************************************************************************/
+/* Timeout benchmarks                                                                                 */
+/******************************************************************************************************/
+
+#define TIMEOUT_LOOPS 200
+#define TIMEOUT_CNT   32
+
+static void
+bench_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+}
+
+static uint64_t
+bench_timeout_add_remove(void) {
+    for (size_t i = 0; i < TIMEOUT_LOOPS; ++i) {
+        for (size_t j = 0; j < TIMEOUT_CNT; ++j) {
+            lwcell_timeout_add(1000 + (uint32_t)((j * 7919) % 5000), bench_timeout_fn, NULL);
+        }
+        for (size_t j = 0; j < TIMEOUT_CNT; ++j) {
+            lwcell_timeout_remove(bench_timeout_fn);
+        }
+        bench_core_drain(); /* Drain wake-up messages */
+    }
+    return TIMEOUT_LOOPS * TIMEOUT_CNT;
+}
+
+#if LWCELL_CFG_TRACE
+
+/******************************************************************************************************/
+/* Trace benchmarks                                                                                   */
+/******************************************************************************************************/
+
+#define TRACE_LOOPS 100000
+
+static uint64_t
+bench_trace_write(void) {
+    for (size_t i = 0; i < TRACE_LOOPS; ++i) {
+        LWCELL_TRACE(IPD_DATA, 0, i, TRACE_LOOPS - i, 0);
+    }
+    return TRACE_LOOPS;
+}
+
+static void
+bench_trace_file_write(const void* data, size_t len, void* arg) {
+    fwrite(data, 1, len, arg);
+}
+
+#endif /* LWCELL_CFG_TRACE */
+
+#if LWCELL_CFG_CMD_STATS
+
+/******************************************************************************************************/
+/* Command statistics benchmarks                                                                      */
+/******************************************************************************************************/
+
+#define CMD_STATS_LOOPS 100000
+
+static uint64_t
+bench_cmd_stats_record(void) {
+    static const lwcell_cmd_t cmds[] = {LWCELL_CMD_CSQ_GET, LWCELL_CMD_CREG_GET, LWCELL_CMD_CIPSEND,
+                                        LWCELL_CMD_CIPSTATUS};
+
+    lwcell_core_lock();
+    for (size_t i = 0; i < CMD_STATS_LOOPS; ++i) {
+        lwcelli_cmd_stats_record(cmds[i % LWCELL_ARRAYSIZE(cmds)], lwcellOK, (uint32_t)(i % 50),
+                                 (uint32_t)(i % 3000));
+    }
+    lwcell_core_unlock();
+    return CMD_STATS_LOOPS;
+}
+
+#endif /* LWCELL_CFG_CMD_STATS */
+
+#if LWCELL_CFG_METRICS
+
+/******************************************************************************************************/
+/* Metrics benchmarks                                                                                 */
+/******************************************************************************************************/
+
+#define METRICS_LOOPS 100000
+
+static uint64_t
+bench_metrics_rx(void) {
+    for (size_t i = 0; i < METRICS_LOOPS; ++i) {
+        LWCELL_METRICS_RX(i & 0x3FF);
+    }
+    return METRICS_LOOPS;
+}
+
+#endif /* LWCELL_CFG_METRICS */
+
+/******************************************************************************************************/
+/* MQTT benchmarks                                                                                    */
+/******************************************************************************************************/
+
+#define MQTT_LOOPS       10000
+#define MQTT_PARSE_PKTS  16
+#define MQTT_TOPIC       "lwcell/bench/topic"
+#define MQTT_PAYLOAD_LEN 64
+
+static lwcell_mqtt_client_p mqtt_client;
+static lwcell_pbuf_p mqtt_rx_pbuf;
+
+static void
+bench_mqtt_evt_fn(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
+    LWCELL_UNUSED(client);
+    bench_sink += evt->type;
+}
+
+static uint64_t
+bench_mqtt_encode(void) {
+    static const uint8_t payload[MQTT_PAYLOAD_LEN];
+    uint16_t len_topic = LWCELL_U16(strlen(MQTT_TOPIC));
+    uint16_t rem_len = 2 + len_topic + 2 + sizeof(payload);
+
+    for (size_t i = 0; i < MQTT_LOOPS; ++i) {
+        if (prv_output_check_enough_memory(mqtt_client, rem_len)) {
+            prv_write_fixed_header(mqtt_client, MQTT_MSG_TYPE_PUBLISH, 0, LWCELL_MQTT_QOS_AT_LEAST_ONCE, 0, rem_len);
+            prv_write_string(mqtt_client, MQTT_TOPIC, len_topic);
+            prv_write_u16(mqtt_client, prv_create_packet_id(mqtt_client));
+            prv_write_data(mqtt_client, payload, sizeof(payload));
+        }
+        lwcell_buff_reset(&mqtt_client->tx_buff);
+    }
+    return MQTT_LOOPS;
+}
+
+static uint64_t
+bench_mqtt_parse(void) {
+    for (size_t i = 0; i < MQTT_LOOPS / MQTT_PARSE_PKTS; ++i) {
+        prv_mqtt_parse_incoming(mqtt_client, mqtt_rx_pbuf);
+    }
+    return (MQTT_LOOPS / MQTT_PARSE_PKTS) * MQTT_PARSE_PKTS;
+}
+
+/**
+ * \brief           Prepare MQTT client and received data with publish packets (QoS 0)
+ */
+static void
+bench_mqtt(void) {
+    uint8_t pkt[128];
+    size_t pkt_len = 0, topic_len = strlen(MQTT_TOPIC), rem_len = 2 + topic_len + MQTT_PAYLOAD_LEN;
+
+    mqtt_client = lwcell_mqtt_client_new(256, 256);
+    mqtt_client->conn_state = LWCELL_MQTT_CONNECTED;
+    mqtt_client->evt_fn = bench_mqtt_evt_fn;
+    mqtt_client->is_sending = 1; /* Keep data in TX buffer, do not send anything */
+
+    pkt[pkt_len++] = MQTT_MSG_TYPE_PUBLISH << 0x04;
+    pkt[pkt_len++] = LWCELL_U8(rem_len);
+    pkt[pkt_len++] = LWCELL_U8(topic_len >> 8);
+    pkt[pkt_len++] = LWCELL_U8(topic_len);
+    memcpy(&pkt[pkt_len], MQTT_TOPIC, topic_len);
+    pkt_len += topic_len;
+    memset(&pkt[pkt_len], 'p', MQTT_PAYLOAD_LEN);
+    pkt_len += MQTT_PAYLOAD_LEN;
+
+    mqtt_rx_pbuf = lwcell_pbuf_new(pkt_len * MQTT_PARSE_PKTS);
+    for (size_t i = 0; i < MQTT_PARSE_PKTS; ++i) {
+        lwcell_pbuf_take(mqtt_rx_pbuf, pkt, pkt_len, i * pkt_len);
+    }
+
+    bench_run("mqtt_encode_publish", bench_mqtt_encode, 0, 0);
+    bench_run("mqtt_parse_publish", bench_mqtt_parse, (uint64_t)(MQTT_LOOPS / MQTT_PARSE_PKTS) * pkt_len * MQTT_PARSE_PKTS,
+              0);
+
+    lwcell_pbuf_free(mqtt_rx_pbuf);
+    lwcell_mqtt_client_delete(mqtt_client);
+}
+
+/******************************************************************************************************/
+/* Output                                                                                             */
+/******************************************************************************************************/
+
+/**
+ * \brief           Write results in JSON format
+ * \param[in]       f: Output file
+ */
+static void
+bench_write_json(FILE* f) {
+    fprintf(f, "{\n  \"suite\": \"lwcell_bench\",\n  \"runs\": %d,\n  \"results\": [\n", BENCH_RUNS);
+    for (size_t i = 0; i < results_cnt; ++i) {
+        const bench_result_t* r = &results[i];
+
+        fprintf(f, "    {\"name\": \"%s\", \"iterations\": %llu, \"total_ns\": %llu, \"ns_per_op\": %.2f", r->name,
+                (unsigned long long)r->iterations, (unsigned long long)r->ns, (double)r->ns / (double)r->iterations);
+        if (r->bytes > 0) {
+            fprintf(f, ", \"bytes\": %llu, \"bytes_per_sec\": %.0f", (unsigned long long)r->bytes,
+                    (double)r->bytes * 1e9 / (double)r->ns);
+        }
+        if (r->lines > 0) {
+            fprintf(f, ", \"lines\": %llu, \"ns_per_line\": %.2f", (unsigned long long)r->lines,
+                    (double)r->ns / (double)r->lines);
+        }
+        fprintf(f, "}%s\n", i + 1 < results_cnt ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+/**
+ * \brief           Program entry point
+ */
+int
+main(int argc, char** argv) {
+    FILE* f = stdout;
+
+    if (bench_core_init() != 0) {
+        return -1;
+    }
+
+    parser_prepare();
+    bench_parser_cmd();
+    bench_parser_urc();
+    bench_parser_ipd();
+
+    bench_run("mem_alloc_free_same_size", bench_mem_same_size, 0, 0);
+    bench_run("mem_alloc_free_fragmented", bench_mem_fragmented, 0, 0);
+
+    pbuf_chain = pbuf_chain_create();
+    bench_run("pbuf_new_cat_free", bench_pbuf_cat, 0, 0);
+    bench_run("pbuf_memfind", bench_pbuf_memfind, (uint64_t)PBUF_LOOPS * sizeof(pbuf_linear), 0);
+    bench_run("pbuf_copy", bench_pbuf_copy, (uint64_t)PBUF_LOOPS * sizeof(pbuf_linear), 0);
+    lwcell_pbuf_free(pbuf_chain);
+
+    lwcell_buff_init(&bench_buff, 1000); /* Not aligned to data size, forces wrap-around */
+    bench_run("buff_write_read", bench_buff_write_read, (uint64_t)BUFF_LOOPS * 64, 0);
+    lwcell_buff_free(&bench_buff);
+
+    bench_run("timeout_add_remove", bench_timeout_add_remove, 0, 0);
+
+    bench_mqtt();
+
+#if LWCELL_CFG_TRACE
+    bench_run("trace_write", bench_trace_write, 0, 0);
+#endif /* LWCELL_CFG_TRACE */
+#if LWCELL_CFG_CMD_STATS
+    bench_run("cmd_stats_record", bench_cmd_stats_record, 0, 0);
+    lwcell_cmd_stats_reset();
+#endif /* LWCELL_CFG_CMD_STATS */
+#if LWCELL_CFG_METRICS
+    bench_run("metrics_rx", bench_metrics_rx, 0, 0);
+    lwcell_metrics_reset();
+#endif /* LWCELL_CFG_METRICS */
+
+    if (argc > 1 && (f = fopen(argv[1], "w")) == NULL) {
+        fprintf(stderr, "Could not open output file %s\r\n", argv[1]);
+        return -1;
+    }
+    bench_write_json(f);
+    if (f != stdout) {
+        fclose(f);
+    }
+#if LWCELL_CFG_TRACE
+    if (argc > 2) {
+        if ((f = fopen(argv[2], "wb")) == NULL) {
+            fprintf(stderr, "Could not open trace file %s\r\n", argv[2]);
+            return -1;
+        }
+        lwcell_trace_dump(bench_trace_file_write, f);
+        fclose(f);
+    }
+#endif /* LWCELL_CFG_TRACE */
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Command throughput benchmark with full threaded stack.
+ *
+ * Usage: lwcell_bench_cmd [commands] [clients]
+ *
+ * Stack is started with lwcell_init, device is emulated by separate thread,
+ * which answers every AT command as soon as its line is fully sent.
+ * Blocking commands are executed back-to-back and number of commands per second is reported,
+ * which measures overhead of producer/process handoff and API synchronization.
+ * Context switches per command are reported too, as they are less sensitive to host load.
+ * With more than one client, commands are split between concurrent application threads
+ * and number of AT commands sent to device per API call is reported.
+ * Result is printed in JSON format.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_private.h"
+#include "bench_core.h"
+#include "system/lwcell_sys.h"
+
+#define CMD_COUNT_DEFAULT 20000
+
+static const char resp_ok[] = "\r\nOK\r\n";
+static const char resp_csq[] = "\r\n+CSQ: 20,0\r\n\r\nOK\r\n";
+
+static lwcell_sys_mbox_t modem_mbox; /* Responses waiting to be sent by emulated device */
+static char line[128];               /* Line sent to device */
+static size_t line_len;
+static uint32_t at_cmds;             /* Number of AT commands sent to device */
+static lwcell_sys_mbox_t done_mbox;  /* Written by client thread when finished */
+static uint32_t client_cmds, client_failed;
+
+/**
+ * \brief           Low-level send function, receives command from stack
+ */
+static size_t
+bench_send_fn(const void* data, size_t len) {
+    const char* d = data;
+
+    for (size_t i = 0; i < len; ++i) {
+        if (line_len < sizeof(line) - 1) {
+            line[line_len++] = d[i];
+        }
+        if (d[i] == '\n') {
+            line[line_len] = '\0';
+            ++at_cmds;
+            lwcell_sys_mbox_put(&modem_mbox, (void*)(strstr(line, "+CSQ") != NULL ? resp_csq : resp_ok));
+            line_len = 0;
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Emulated device thread, answers commands
+ */
+static void
+bench_modem_thread(void* const arg) {
+    const char* resp;
+
+    LWCELL_UNUSED(arg);
+    while (1) {
+        lwcell_sys_mbox_get(&modem_mbox, (void**)&resp, 0);
+        lwcell_input_process(resp, strlen(resp));
+    }
+}
+
+/**
+ * \brief           Application client thread, executes blocking commands
+ */
+static void
+bench_client_thread(void* const arg) {
+    int16_t rssi;
+
+    LWCELL_UNUSED(arg);
+    for (uint32_t i = 0; i < client_cmds; ++i) {
+        if (lwcell_network_rssi(&rssi, NULL, NULL, 1) != lwcellOK) {
+            __atomic_fetch_add(&client_failed, 1, __ATOMIC_RELAXED);
+        }
+    }
+    lwcell_sys_mbox_put(&done_mbox, (void*)&client_cmds);
+    lwcell_sys_thread_terminate(NULL);
+}
+
+/**
+ * \brief           Stack event callback
+ */
+static lwcellr_t
+bench_evt_fn(lwcell_evt_t* evt) {
+    LWCELL_UNUSED(evt);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Program entry point
+ */
+int
+main(int argc, char** argv) {
+    lwcell_sys_thread_t thread;
+    uint32_t cmds = CMD_COUNT_DEFAULT, clients = 1, failed = 0, at_start;
+    uint64_t start, ns, ctx;
+    struct rusage ru_start, ru_end;
+    int16_t rssi;
+
+    if (argc > 1) {
+        cmds = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2 && (clients = (uint32_t)strtoul(argv[2], NULL, 10)) == 0) {
+        clients = 1;
+    }
+    if (bench_core_mem_init() != 0) {
+        return -1;
+    }
+    bench_core_set_send_fn(bench_send_fn);
+    if (lwcell_init(bench_evt_fn, 1) != lwcellOK || !lwcell_sys_mbox_create(&modem_mbox, 4)
+        || !lwcell_sys_thread_create(&thread, "bench_modem", bench_modem_thread, NULL, LWCELL_SYS_THREAD_SS,
+                                     LWCELL_SYS_THREAD_PRIO)) {
+        fprintf(stderr, "Could not start stack\r\n");
+        return -1;
+    }
+
+    /* Warm-up */
+    for (uint32_t i = 0; i < 100; ++i) {
+        lwcell_network_rssi(&rssi, NULL, NULL, 1);
+    }
+
+    getrusage(RUSAGE_SELF, &ru_start);
+    at_start = at_cmds;
+    start = bench_now_ns();
+    if (clients == 1) {
+        for (uint32_t i = 0; i < cmds; ++i) {
+            if (lwcell_network_rssi(&rssi, NULL, NULL, 1) != lwcellOK) {
+                ++failed;
+            }
+        }
+    } else {
+        client_cmds = cmds / clients;
+        cmds = client_cmds * clients;
+        if (!lwcell_sys_mbox_create(&done_mbox, clients)) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < clients; ++i) {
+            lwcell_sys_thread_create(NULL, "bench_client", bench_client_thread, NULL, LWCELL_SYS_THREAD_SS,
+                                     LWCELL_SYS_THREAD_PRIO);
+        }
+        for (uint32_t i = 0; i < clients; ++i) {
+            void* done;
+            lwcell_sys_mbox_get(&done_mbox, &done, 0);
+        }
+        failed = client_failed;
+    }
+    ns = bench_now_ns() - start;
+    getrusage(RUSAGE_SELF, &ru_end);
+    ctx = (uint64_t)((ru_end.ru_nvcsw + ru_end.ru_nivcsw) - (ru_start.ru_nvcsw + ru_start.ru_nivcsw));
+
+    printf("{\n  \"benchmarks\": [\n");
+    printf("    {\"name\": \"cmd_csq_blocking\", \"iterations\": %lu, \"total_ns\": %llu, \"ns_per_op\": %.2f, "
+           "\"cmds_per_sec\": %.0f, \"ctx_switches_per_cmd\": %.2f, \"clients\": %lu, \"at_per_cmd\": %.3f, "
+           "\"failed\": %lu}\n",
+           (unsigned long)cmds, (unsigned long long)ns, (double)ns / (double)cmds, (double)cmds * 1e9 / (double)ns,
+           (double)ctx / (double)cmds, (unsigned long)clients, (double)(at_cmds - at_start) / (double)cmds,
+           (unsigned long)failed);
+    printf("  ]\n}\n");
+    return failed > 0;
+}
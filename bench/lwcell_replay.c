@@ -0,0 +1,113 @@
+/*
+ * Replay AT traffic capture through the parser.
+ *
+ * Usage: lwcell_replay <capture.bin> [speed]
+ *
+ * Speed `0` (default) replays as fast as possible, `1` keeps original timing
+ * and any other value accelerates original timing by given factor.
+ * Capture is produced by the library when LWCELL_CFG_CAPTURE is enabled.
+ *
+ * Received (RX) records are fed to the parser, sent (TX) records are only accounted for,
+ * as commands are not executed during replay. Summary is printed in JSON format.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_private.h"
+#include "bench_core.h"
+
+/**
+ * \brief           Read entire file to memory
+ * \param[in]       path: File path
+ * \param[out]      len: Length of file
+ * \return          Allocated memory with file content or `NULL` on failure
+ */
+static uint8_t*
+read_file(const char* path, size_t* len) {
+    FILE* f;
+    uint8_t* data = NULL;
+    long size;
+
+    if ((f = fopen(path, "rb")) == NULL) {
+        return NULL;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        if ((data = malloc((size_t)size)) != NULL) {
+            *len = fread(data, 1, (size_t)size, f);
+        }
+    }
+    fclose(f);
+    return data;
+}
+
+/**
+ * \brief           Program entry point
+ */
+int
+main(int argc, char** argv) {
+    lwcell_capture_record_t rec;
+    uint8_t* data;
+    size_t len = 0, off, l;
+    double speed = 0;
+    uint64_t start, proc_ns = 0, t;
+    uint64_t rx_recs = 0, tx_recs = 0, rx_bytes = 0, tx_bytes = 0;
+    uint32_t first_time = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <capture.bin> [speed]\r\n", argv[0]);
+        return -1;
+    }
+    if (argc > 2) {
+        speed = atof(argv[2]);
+    }
+    if ((data = read_file(argv[1], &len)) == NULL || !lwcell_capture_check_header(data, len)) {
+        fprintf(stderr, "Could not read valid capture from %s\r\n", argv[1]);
+        return -1;
+    }
+    if (bench_core_init() != 0) {
+        return -1;
+    }
+
+    start = bench_now_ns();
+    for (off = LWCELL_CAPTURE_HDR_LEN; (l = lwcell_capture_parse_record(&data[off], len - off, &rec)) > 0; off += l) {
+        if (rx_recs + tx_recs == 0) {
+            first_time = rec.time;
+        }
+
+        /* Wait for original time of record, scaled with speed factor */
+        if (speed > 0) {
+            uint64_t target = start + (uint64_t)((double)(rec.time - first_time) * 1000000.0 / speed);
+            if ((t = bench_now_ns()) < target) {
+                bench_sleep_ns(target - t);
+            }
+        }
+
+        if (rec.dir == LWCELL_CAPTURE_DIR_RX) {
+            ++rx_recs;
+            rx_bytes += rec.len;
+
+            t = bench_now_ns();
+            lwcell_core_lock();
+            lwcelli_process(rec.data, rec.len);
+            lwcell_core_unlock();
+            proc_ns += bench_now_ns() - t;
+        } else {
+            ++tx_recs;
+            tx_bytes += rec.len;
+        }
+        bench_core_drain();
+    }
+
+    printf("{\n  \"capture\": \"%s\",\n  \"speed\": %.2f,\n", argv[1], speed);
+    printf("  \"rx_records\": %llu,\n  \"rx_bytes\": %llu,\n", (unsigned long long)rx_recs,
+           (unsigned long long)rx_bytes);
+    printf("  \"tx_records\": %llu,\n  \"tx_bytes\": %llu,\n", (unsigned long long)tx_recs,
+           (unsigned long long)tx_bytes);
+    printf("  \"capture_ms\": %lu,\n  \"wall_ns\": %llu,\n  \"process_ns\": %llu,\n",
+           (unsigned long)(rx_recs + tx_recs > 0 ? rec.time - first_time : 0),
+           (unsigned long long)(bench_now_ns() - start), (unsigned long long)proc_ns);
+    printf("  \"process_bytes_per_sec\": %.0f,\n  \"trailing_bytes\": %lu\n}\n",
+           proc_ns > 0 ? (double)rx_bytes * 1e9 / (double)proc_ns : 0.0, (unsigned long)(len - off));
+    free(data);
+    return 0;
+}
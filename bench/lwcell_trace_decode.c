@@ -0,0 +1,62 @@
+/*
+ * Decode binary trace dump to readable lines.
+ *
+ * Usage: lwcell_trace_decode <trace.bin>
+ *
+ * Dump is produced by the library with lwcell_trace_dump when LWCELL_CFG_TRACE is enabled.
+ * Each record is printed on its own line as time, time delta to previous record,
+ * event name and event arguments.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwcell/lwcell.h"
+
+/**
+ * \brief           Program entry point
+ */
+int
+main(int argc, char** argv) {
+    lwcell_trace_rec_t rec;
+    uint8_t* data = NULL;
+    size_t len = 0, off, l, cnt = 0;
+    uint32_t prev_time = 0;
+    const char* name;
+    const char* fmt;
+    FILE* f;
+    long size;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <trace.bin>\r\n", argv[0]);
+        return -1;
+    }
+    if ((f = fopen(argv[1], "rb")) != NULL) {
+        if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0
+            && (data = malloc((size_t)size)) != NULL) {
+            len = fread(data, 1, (size_t)size, f);
+        }
+        fclose(f);
+    }
+    if (data == NULL || !lwcell_trace_check_header(data, len)) {
+        fprintf(stderr, "Could not read valid trace from %s\r\n", argv[1]);
+        free(data);
+        return -1;
+    }
+
+    for (off = LWCELL_TRACE_HDR_LEN; (l = lwcell_trace_parse_record(&data[off], len - off, &rec)) > 0; off += l) {
+        printf("%10lu ms (+%5lu) ", (unsigned long)rec.time,
+               (unsigned long)(cnt > 0 ? rec.time - prev_time : 0));
+        if ((name = lwcell_trace_evt_name(rec.id)) != NULL && (fmt = lwcell_trace_evt_fmt(rec.id)) != NULL) {
+            printf("%-18s ", name);
+            printf(fmt, (unsigned)rec.args[0], (unsigned)rec.args[1], (unsigned)rec.args[2], (unsigned)rec.args[3]);
+        } else {
+            printf("UNKNOWN(%u)         %08X %08X %08X %08X", (unsigned)rec.id, (unsigned)rec.args[0],
+                   (unsigned)rec.args[1], (unsigned)rec.args[2], (unsigned)rec.args[3]);
+        }
+        printf("\n");
+        prev_time = rec.time;
+        ++cnt;
+    }
+    fprintf(stderr, "%lu record(s), %lu trailing byte(s)\r\n", (unsigned long)cnt, (unsigned long)(len - off));
+    free(data);
+    return 0;
+}
@@ -18,26 +18,43 @@ set(LWCELL_CUSTOM_INC_DIR ${CMAKE_CURRENT_BINARY_DIR}/lib_inc)
 # Library core sources
 set(lwcell_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_baudrate.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_buff.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cache.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_call.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_capture.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmd_adapt.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmd_cancel.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmd_coalesce.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmd_prio.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmd_stats.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmux.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_conn.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_debug.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_device_info.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_evt.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_evt_defer.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_flow.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_http.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_input.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_int.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_lock.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_loop.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_mem.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_metrics.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_mqtt.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_network.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_operator.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_parser.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_pbuf.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_phonebook.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ppp.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_sim.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_sms.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_state.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_threads.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_timeout.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_trace.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_unicode.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ussd.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_utils.c
@@ -79,6 +96,10 @@ target_sources(lwcell PRIVATE ${lwcell_core_SRCS})
 target_include_directories(lwcell PUBLIC ${lwcell_include_DIRS})
 target_compile_options(lwcell PRIVATE ${LWCELL_COMPILE_OPTIONS})
 target_compile_definitions(lwcell PRIVATE ${LWCELL_COMPILE_DEFINITIONS})
+if(LWCELL_SYS_PORT STREQUAL "posix")
+    find_package(Threads REQUIRED)
+    target_link_libraries(lwcell PUBLIC Threads::Threads)
+endif()
 
 # Register API to the system
 add_library(lwcell_api)
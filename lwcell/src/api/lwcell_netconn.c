@@ -216,6 +216,9 @@ lwcell_netconn_new(lwcell_netconn_type_t type) {
     if (first) {
         first = 0;
         lwcell_evt_register(lwcell_evt); /* Register global event function */
+#if LWCELL_CFG_EVT_DEFER
+        lwcell_evt_defer_exclude(netconn_evt); /* Netconn state is protected by core lock */
+#endif                                         /* LWCELL_CFG_EVT_DEFER */
     }
     lwcell_core_unlock();
     a = lwcell_mem_calloc(1, sizeof(*a)); /* Allocate memory for core object */
@@ -1149,6 +1149,9 @@ lwcell_mqtt_client_connect(lwcell_mqtt_client_p client, const char* host, lwcell
     if (lwcell_network_is_attached() && client->conn_state == LWCELL_MQTT_CONN_DISCONNECTED) {
         client->info = info; /* Save client info parameters */
         client->evt_fn = evt_fn != NULL ? evt_fn : prv_mqtt_evt_fn_default;
+#if LWCELL_CFG_EVT_DEFER
+        lwcell_evt_defer_exclude(prv_mqtt_conn_cb); /* Client state is protected by core lock */
+#endif                                              /* LWCELL_CFG_EVT_DEFER */
 
         /* Start a new connection in non-blocking mode */
         if ((res = lwcell_conn_start(&client->conn, LWCELL_CONN_TYPE_TCP, host, port, client, prv_mqtt_conn_cb, 0))
@@ -35,6 +35,8 @@
 #include "lwcell/lwcell.h"
 #include "lwcell/lwcell_private.h"
 
+#if LWCELL_CFG_OS || __DOXYGEN__
+
 /* Tracing debug message */
 #define LWCELL_CFG_DBG_MQTT_API_TRACE         (LWCELL_CFG_DBG_MQTT_API | LWCELL_DBG_TYPE_TRACE)
 #define LWCELL_CFG_DBG_MQTT_API_STATE         (LWCELL_CFG_DBG_MQTT_API | LWCELL_DBG_TYPE_STATE)
@@ -484,3 +486,5 @@ void
 lwcell_mqtt_client_api_buf_free(lwcell_mqtt_client_api_buf_p p) {
     lwcell_mem_free_s((void**)&p);
 }
+
+#endif /* LWCELL_CFG_OS || __DOXYGEN__ */
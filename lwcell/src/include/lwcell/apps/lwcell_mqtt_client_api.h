@@ -45,6 +45,7 @@ extern "C" {
  * \ingroup         LWCELL_APPS
  * \defgroup        LWCELL_APP_MQTT_CLIENT_API MQTT client API
  * \brief           Sequential, single thread MQTT client API
+ * \note            API is only available when \ref LWCELL_CFG_OS is enabled
  * \{
  */
 
@@ -0,0 +1,87 @@
+/**
+ * \file            lwcell_baudrate.h
+ * \brief           AT port baudrate negotiation
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_BAUDRATE_HDR_H
+#define LWCELL_BAUDRATE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_BAUDRATE AT port baudrate negotiation
+ * \brief           Automatic AT port baudrate negotiation with `AT+IPR`
+ * \{
+ *
+ * After device is identified in reset sequence, baudrate is stepped up
+ * through \ref LWCELL_CFG_AT_BAUDRATE_LIST. Every step is verified
+ * with \ref LWCELL_CFG_AT_BAUDRATE_VERIFY `AT` commands. On failure,
+ * device and AT port fall back to last working baudrate.
+ *
+ * Best working baudrate is remembered for each device model,
+ * later reset sequences switch to it directly.
+ * Every reset sequence starts at \ref LWCELL_CFG_AT_PORT_BAUDRATE.
+ *
+ * Remembered baudrates are kept in RAM only. When device does not respond at default baudrate
+ * at start of reset sequence, for example after host restart, candidates are scanned
+ * and device found at one of them is returned to default baudrate before sequence continues.
+ */
+
+/**
+ * \brief           Baudrate negotiation statistics
+ */
+typedef struct {
+    uint32_t baudrate;     /*!< Current AT port baudrate */
+    uint32_t negotiations; /*!< Number of started negotiations */
+    uint32_t steps;        /*!< Number of verified baudrate changes */
+    uint32_t errors;       /*!< Number of failed verifications */
+    uint32_t fallbacks;    /*!< Number of fallbacks to last working baudrate */
+    uint32_t scans;        /*!< Number of scans, device did not respond at default baudrate */
+    uint32_t recoveries;   /*!< Number of times device was found at other baudrate during scan */
+} lwcell_baudrate_stats_t;
+
+lwcellr_t lwcell_baudrate_get_stats(lwcell_baudrate_stats_t* stats);
+void lwcell_baudrate_forget(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_BAUDRATE_HDR_H */
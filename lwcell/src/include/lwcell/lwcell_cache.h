@@ -0,0 +1,74 @@
+/**
+ * \file            lwcell_cache.h
+ * \brief           Response cache of slow-changing device state
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CACHE_HDR_H
+#define LWCELL_CACHE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CACHE Response cache
+ * \brief           Answer queries of slow-changing device state without accessing device
+ * \{
+ *
+ * Device information (manufacturer, model, serial number, revision), current operator and RSSI
+ * are saved when received from device. Query API function called while saved value is younger
+ * than its time-to-live is answered immediately, with callback called from the caller context.
+ *
+ * Operator and RSSI values are invalidated by `+CREG`, `+CPIN` and `+PDP: DEACT` notifications,
+ * all values are invalidated by device reset.
+ *
+ * \sa              LWCELL_CFG_CACHE_TTL_DEVICE_INFO, LWCELL_CFG_CACHE_TTL_OPERATOR, LWCELL_CFG_CACHE_TTL_RSSI
+ */
+
+/**
+ * \brief           Time-to-live value to keep cached value until device reset
+ */
+#define LWCELL_CACHE_TTL_FOREVER 0xFFFFFFFFUL
+
+void lwcell_cache_invalidate(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CACHE_HDR_H */
@@ -0,0 +1,102 @@
+/**
+ * \file            lwcell_capture.h
+ * \brief           AT traffic capture
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CAPTURE_HDR_H
+#define LWCELL_CAPTURE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CAPTURE AT traffic capture
+ * \brief           Binary capture of raw AT traffic for offline replay
+ * \{
+ *
+ * Capture stream starts with \ref LWCELL_CAPTURE_HDR_LEN bytes long header (`LWCC` magic, version and `3` reserved bytes),
+ * followed by records. Each record consists of `32-bit` little-endian timestamp in units of milliseconds,
+ * `16-bit` little-endian length/direction field (bit `15` set for TX direction, lower `15` bits for length)
+ * and raw data bytes.
+ */
+
+#define LWCELL_CAPTURE_VERSION     0x01   /*!< Capture stream format version */
+#define LWCELL_CAPTURE_HDR_LEN     8      /*!< Length of stream header in units of bytes */
+#define LWCELL_CAPTURE_REC_HDR_LEN 6      /*!< Length of record header in units of bytes */
+#define LWCELL_CAPTURE_REC_MAX_LEN 0x7FFF /*!< Maximal data length of single record */
+
+/**
+ * \brief           Capture record direction
+ */
+typedef enum {
+    LWCELL_CAPTURE_DIR_RX = 0x00, /*!< Data received from device */
+    LWCELL_CAPTURE_DIR_TX = 0x01, /*!< Data sent to device */
+} lwcell_capture_dir_t;
+
+/**
+ * \brief           Single capture record, as parsed from capture stream
+ */
+typedef struct {
+    uint32_t time;            /*!< Time of record in units of milliseconds, as returned by \ref lwcell_sys_now */
+    lwcell_capture_dir_t dir; /*!< Record direction */
+    const uint8_t* data;      /*!< Pointer to record data */
+    size_t len;               /*!< Length of record data in units of bytes */
+} lwcell_capture_record_t;
+
+/**
+ * \brief           Capture output function prototype
+ *
+ * Function is called with core locked, it must not block for long time
+ *
+ * \param[in]       data: Pointer to data to write to capture output
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       arg: User argument as passed to \ref lwcell_capture_start
+ */
+typedef void (*lwcell_capture_write_fn)(const void* data, size_t len, void* arg);
+
+lwcellr_t lwcell_capture_start(lwcell_capture_write_fn write_fn, void* arg);
+lwcellr_t lwcell_capture_stop(void);
+uint8_t lwcell_capture_check_header(const void* data, size_t len);
+size_t lwcell_capture_parse_record(const void* data, size_t len, lwcell_capture_record_t* rec);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CAPTURE_HDR_H */
@@ -0,0 +1,84 @@
+/**
+ * \file            lwcell_cmd_adapt.h
+ * \brief           Adaptive command timeouts
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMD_ADAPT_HDR_H
+#define LWCELL_CMD_ADAPT_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMD_ADAPT Adaptive command timeouts
+ * \brief           Command timeouts derived from observed latency
+ * \{
+ *
+ * Stack keeps last \ref LWCELL_CFG_CMD_ADAPT_SAMPLES execution times for each adapted command.
+ * Only queries answered by device from its own state are adapted, all other commands
+ * keep timeout given by API call.
+ * Once at least \ref LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES were recorded,
+ * command timeout is set to `p99 * LWCELL_CFG_CMD_ADAPT_FACTOR`,
+ * clamped between \ref LWCELL_CFG_CMD_ADAPT_MIN and maximal time given by API call.
+ *
+ * Command that times out on adapted timeout records its execution time as new sample,
+ * hence timeout grows with every consecutive timeout until it reaches maximal time again.
+ */
+
+/**
+ * \brief           Adaptive timeout state for single command
+ */
+typedef struct {
+    uint16_t cmd;      /*!< Command ID */
+    const char* name;  /*!< Command name */
+    uint32_t samples;  /*!< Number of valid latency samples */
+    uint32_t p50;      /*!< Median execution time in units of milliseconds */
+    uint32_t p99;      /*!< 99th percentile of execution time in units of milliseconds */
+    uint32_t timeout;  /*!< Adapted timeout in units of milliseconds or `0` if not enough samples */
+    uint32_t timeouts; /*!< Number of executions finished on adapted timeout */
+} lwcell_cmd_adapt_stats_t;
+
+size_t lwcell_cmd_adapt_get(lwcell_cmd_adapt_stats_t* stats, size_t max_entries);
+void lwcell_cmd_adapt_reset(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMD_ADAPT_HDR_H */
@@ -0,0 +1,71 @@
+/**
+ * \file            lwcell_cmd_cancel.h
+ * \brief           Command deadlines and cancellation
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMD_CANCEL_HDR_H
+#define LWCELL_CMD_CANCEL_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMD_CANCEL Command cancellation
+ * \brief           Drop stale or unwanted commands before they occupy AT port
+ * \{
+ *
+ * Query commands, which do not change device or stack state, carry an absolute deadline,
+ * set to the time they were queued plus \ref LWCELL_CFG_CMD_DEADLINE. Query taken from producer queue
+ * after its deadline is not executed and finishes with \ref lwcellTIMEOUT result.
+ * Reset, connection close, configuration and internal commands are always executed.
+ *
+ * Callback function and its argument, passed to API function, act as cancellation token.
+ * All queued commands with the same token are finished with \ref lwcellERRCANCELED result
+ * when taken from producer queue. Active connection send command is stopped between data segments,
+ * other active commands run to completion.
+ * Commands started without callback function, such as most blocking calls, cannot be cancelled.
+ */
+
+size_t lwcell_cmd_cancel(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMD_CANCEL_HDR_H */
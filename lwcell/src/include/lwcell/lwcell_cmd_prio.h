@@ -0,0 +1,89 @@
+/**
+ * \file            lwcell_cmd_prio.h
+ * \brief           Command queue priority classes
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMD_PRIO_HDR_H
+#define LWCELL_CMD_PRIO_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMD_PRIO Command priorities
+ * \brief           Priority classes of commands in producer queue
+ * \{
+ *
+ * Every command is assigned priority class when it is put to producer queue.
+ * Next executed command is the oldest one from the highest priority non-empty class,
+ * except when the oldest command of any class waits longer than \ref LWCELL_CFG_CMD_PRIO_MAX_WAIT,
+ * in which case the longest waiting one is executed first to prevent starvation.
+ *
+ * \note            Order of commands is preserved only within the same class
+ */
+
+/**
+ * \brief           Command priority class
+ */
+typedef enum {
+    LWCELL_CMD_PRIO_DATA = 0,   /*!< Data path commands: connection send and close */
+    LWCELL_CMD_PRIO_CONTROL,    /*!< Default class for all other commands */
+    LWCELL_CMD_PRIO_BACKGROUND, /*!< Long-running or periodic queries: operator scan, SMS list, phonebook, RSSI */
+    LWCELL_CMD_PRIO_END,        /*!< Number of classes, not a valid class */
+} lwcell_cmd_prio_t;
+
+/**
+ * \brief           Queue statistics of priority class
+ */
+typedef struct {
+    uint32_t count;      /*!< Number of commands taken from queue */
+    uint32_t aged;       /*!< Number of commands taken before higher class commands due to starvation protection */
+    uint32_t queued;     /*!< Number of commands currently waiting in queue */
+    uint32_t wait_total; /*!< Sum of queue delays in units of milliseconds */
+    uint32_t wait_max;   /*!< Maximal queue delay in units of milliseconds */
+} lwcell_cmd_prio_stats_t;
+
+lwcellr_t lwcell_cmd_prio_get_stats(lwcell_cmd_prio_stats_t* stats);
+void lwcell_cmd_prio_reset_stats(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMD_PRIO_HDR_H */
@@ -0,0 +1,88 @@
+/**
+ * \file            lwcell_cmd_stats.h
+ * \brief           Per-command statistics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMD_STATS_HDR_H
+#define LWCELL_CMD_STATS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMD_STATS Command statistics
+ * \brief           Per-command latency and outcome statistics
+ * \{
+ *
+ * Statistics are recorded by producer thread for every message taken from producer queue.
+ * Queue-wait time is measured from the moment message is put to queue until producer thread takes it,
+ * execution time is measured from the moment command starts until it finishes or times out.
+ *
+ * Latency histograms use logarithmic bins: bin `0` counts latencies below `1 ms`,
+ * bin `n` counts latencies in range `[4^(n-1), 4^n) ms` and last bin counts everything above.
+ */
+
+#define LWCELL_CMD_STATS_HIST_LEN 8 /*!< Number of bins in latency histogram */
+
+/**
+ * \brief           Statistics for single command
+ */
+typedef struct {
+    uint16_t cmd;                                  /*!< Command ID */
+    const char* name;                              /*!< Command name */
+    uint32_t count;                                /*!< Number of executions */
+    uint32_t errors;                               /*!< Number of executions finished with error */
+    uint32_t timeouts;                             /*!< Number of executions finished with timeout */
+    uint32_t wait_total;                           /*!< Sum of queue-wait times in units of milliseconds */
+    uint32_t wait_max;                             /*!< Maximal queue-wait time in units of milliseconds */
+    uint32_t exec_total;                           /*!< Sum of execution times in units of milliseconds */
+    uint32_t exec_max;                             /*!< Maximal execution time in units of milliseconds */
+    uint32_t wait_hist[LWCELL_CMD_STATS_HIST_LEN]; /*!< Queue-wait time histogram */
+    uint32_t exec_hist[LWCELL_CMD_STATS_HIST_LEN]; /*!< Execution time histogram */
+} lwcell_cmd_stats_t;
+
+size_t lwcell_cmd_stats_get(lwcell_cmd_stats_t* stats, size_t max_entries);
+uint32_t lwcell_cmd_stats_get_dropped(void);
+void lwcell_cmd_stats_reset(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMD_STATS_HDR_H */
@@ -0,0 +1,96 @@
+/**
+ * \file            lwcell_cmux.h
+ * \brief           GSM 07.10 multiplexer
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMUX_HDR_H
+#define LWCELL_CMUX_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMUX GSM 07.10 multiplexer
+ * \brief           Virtual channels over single AT port
+ * \{
+ *
+ * After device is identified in reset sequence, multiplexer is started with `AT+CMUX`
+ * and virtual channels are opened in basic option mode.
+ *
+ * Every channel has its own parser state. Control channel executes commands
+ * from producer queue, data channel executes connection send commands from its own queue
+ * and thread, so bulk data transfer does not block other commands.
+ * Unsolicited codes are processed on any channel they arrive on.
+ *
+ * Every reset sequence closes multiplexer and starts in plain AT mode.
+ * If device does not support multiplexer, stack continues on plain AT port.
+ */
+
+/**
+ * \brief           Multiplexer virtual channels
+ */
+typedef enum {
+    LWCELL_CMUX_CH_CTRL = 0x00, /*!< Control channel for AT commands, DLCI `1` */
+    LWCELL_CMUX_CH_DATA,        /*!< Data channel for connection data transfer, DLCI `2` */
+    LWCELL_CMUX_CH_URC,         /*!< Channel for unsolicited result codes, DLCI `3` */
+    LWCELL_CMUX_CH_END,         /*!< Number of channels */
+} lwcell_cmux_ch_t;
+
+/**
+ * \brief           Multiplexer statistics
+ */
+typedef struct {
+    uint8_t is_active;                     /*!< Set to `1` when multiplexer is running */
+    uint32_t opened;                       /*!< Number of successful multiplexer starts */
+    uint32_t open_errors;                  /*!< Number of failed multiplexer starts */
+    uint32_t frames_tx;                    /*!< Number of sent frames */
+    uint32_t frames_rx;                    /*!< Number of received frames */
+    uint32_t fcs_errors;                   /*!< Number of received frames with invalid checksum */
+    uint32_t bytes_tx[LWCELL_CMUX_CH_END]; /*!< Payload bytes sent on each channel */
+    uint32_t bytes_rx[LWCELL_CMUX_CH_END]; /*!< Payload bytes received on each channel */
+} lwcell_cmux_stats_t;
+
+uint8_t lwcell_cmux_is_active(void);
+lwcellr_t lwcell_cmux_get_stats(lwcell_cmux_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMUX_HDR_H */
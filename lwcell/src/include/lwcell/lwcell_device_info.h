@@ -55,6 +55,7 @@ lwcellr_t lwcell_device_get_revision(char* rev, size_t len, const lwcell_api_cmd
                                    const uint32_t blocking);
 lwcellr_t lwcell_device_get_serial_number(char* serial, size_t len, const lwcell_api_cmd_evt_fn evt_fn,
                                         void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_device_get_limits(lwcell_device_limits_t* limits);
 
 /**
  * \}
@@ -47,7 +47,22 @@ extern "C" {
  * \{
  */
 
+/**
+ * \brief           Get subscription mask bit for single event type
+ * \param[in]       type: Event type, member of \ref lwcell_evt_type_t enumeration
+ * \hideinitializer
+ */
+#define LWCELL_EVT_MASK(type) ((lwcell_evt_mask_t)1 << (type))
+
+/**
+ * \brief           Subscription mask for all event types
+ */
+#define LWCELL_EVT_MASK_ALL   (~(lwcell_evt_mask_t)0)
+
 lwcellr_t lwcell_evt_register(lwcell_evt_fn fn);
+#if LWCELL_CFG_EVT_MASK || __DOXYGEN__
+lwcellr_t lwcell_evt_register_mask(lwcell_evt_fn fn, lwcell_evt_mask_t mask);
+#endif /* LWCELL_CFG_EVT_MASK || __DOXYGEN__ */
 lwcellr_t lwcell_evt_unregister(lwcell_evt_fn fn);
 lwcell_evt_type_t lwcell_evt_get_type(lwcell_evt_t* cc);
 
@@ -0,0 +1,97 @@
+/**
+ * \file            lwcell_evt_defer.h
+ * \brief           Deferred event dispatch
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_EVT_DEFER_HDR_H
+#define LWCELL_EVT_DEFER_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_EVT
+ * \defgroup        LWCELL_EVT_DEFER Deferred event dispatch
+ * \brief           Event callbacks called from worker threads
+ * \{
+ *
+ * Processing thread copies event to a queue and continues with AT parsing.
+ * Worker thread later calls callback function with the copy, without core lock held.
+ *
+ * - Return value of deferred callback is ignored.
+ *      Callback returning \ref lwcellOKIGNOREMORE for \ref LWCELL_EVT_CONN_RECV event
+ *      must be excluded with \ref lwcell_evt_defer_exclude
+ * - Received packet buffer is referenced until callback returns.
+ *      Callback must call \ref lwcell_pbuf_ref to keep it, same as in synchronous mode
+ * - Current operator and call information are copies, taken when event was queued
+ * - Operator scan, SMS read and list, phonebook list and search and connection error events
+ *      point to application or API call memory and are always delivered synchronously
+ * - Connection slot is not reused for new connection until its events are delivered,
+ *      connection handle in event always refers to the connection event was queued for
+ * - Events of the same connection are delivered in order, order between connections
+ *      and global events is only kept with single worker thread
+ * - When worker queue is full, event is delivered synchronously
+ *      and may overtake events still waiting in the queue
+ *
+ * Callback functions which must run with core locked, such as library applications,
+ * are excluded with \ref lwcell_evt_defer_exclude.
+ */
+
+/**
+ * \brief           Deferred dispatch statistics
+ */
+typedef struct {
+    uint32_t queued;      /*!< Number of events copied to worker queues */
+    uint32_t delivered;   /*!< Number of events delivered by worker threads */
+    uint32_t full;        /*!< Number of events delivered synchronously, as worker queue was full
+                                or memory was not available */
+    size_t pending;       /*!< Number of events currently waiting in queues */
+    size_t pending_max;   /*!< Highest number of events waiting in queues */
+    uint32_t latency_max; /*!< Highest time from queueing to delivery, in units of milliseconds */
+    uint32_t latency_sum; /*!< Sum of times from queueing to delivery, in units of milliseconds.
+                                Divide by `delivered` for average latency */
+} lwcell_evt_defer_stats_t;
+
+lwcellr_t lwcell_evt_defer_exclude(lwcell_evt_fn fn);
+lwcellr_t lwcell_evt_defer_get_stats(lwcell_evt_defer_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_EVT_DEFER_HDR_H */
@@ -0,0 +1,92 @@
+/**
+ * \file            lwcell_flow.h
+ * \brief           Hardware flow control and receive error accounting
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_FLOW_HDR_H
+#define LWCELL_FLOW_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_FLOW Flow control
+ * \brief           RTS/CTS flow control and receive error accounting
+ * \{
+ *
+ * Low-level sets `uart.flow_control` in \ref lwcell_ll_t when RTS/CTS lines are connected
+ * and UART transmit is paused by CTS line. Reset sequence then enables flow control on device.
+ *
+ * When `rts_fn` is set, device is paused once input buffer passes high-water mark
+ * and resumed when processing thread drained it below low-water mark.
+ * Low-levels processing data directly with \ref lwcell_input_process
+ * control RTS line with their own receive memory.
+ */
+
+/**
+ * \brief           Receive error types reported by low-level
+ */
+typedef enum {
+    LWCELL_FLOW_ERR_OVERRUN = 0x00, /*!< Received byte lost, as previous was not read in time */
+    LWCELL_FLOW_ERR_FRAMING,        /*!< Stop bit not detected */
+    LWCELL_FLOW_ERR_NOISE,          /*!< Noise detected on received bit */
+    LWCELL_FLOW_ERR_PARITY,         /*!< Parity mismatch */
+    LWCELL_FLOW_ERR_END,            /*!< Number of error types */
+} lwcell_flow_err_t;
+
+/**
+ * \brief           Flow control statistics
+ */
+typedef struct {
+    uint8_t is_enabled;                   /*!< Set to `1` when device accepted flow control settings */
+    uint8_t is_paused;                    /*!< Set to `1` when device is currently paused with RTS line */
+    uint32_t pauses;                      /*!< Number of times device was paused at high-water mark */
+    uint32_t dropped;                     /*!< Number of received bytes dropped, as input buffer was full */
+    size_t buff_max;                      /*!< Highest input buffer level in units of bytes */
+    uint32_t errors[LWCELL_FLOW_ERR_END]; /*!< Number of receive errors per type */
+} lwcell_flow_stats_t;
+
+void lwcell_flow_rx_error(lwcell_flow_err_t err);
+lwcellr_t lwcell_flow_get_stats(lwcell_flow_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_FLOW_HDR_H */
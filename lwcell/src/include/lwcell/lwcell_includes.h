@@ -67,6 +67,54 @@
 #if LWCELL_CFG_USSD || __DOXYGEN__
 #include "lwcell/lwcell_ussd.h"
 #endif /* LWCELL_CFG_USSD || __DOXYGEN__ */
+#if LWCELL_CFG_CAPTURE || __DOXYGEN__
+#include "lwcell/lwcell_capture.h"
+#endif /* LWCELL_CFG_CAPTURE || __DOXYGEN__ */
+#if LWCELL_CFG_TRACE || __DOXYGEN__
+#include "lwcell/lwcell_trace.h"
+#endif /* LWCELL_CFG_TRACE || __DOXYGEN__ */
+#if LWCELL_CFG_CMD_STATS || __DOXYGEN__
+#include "lwcell/lwcell_cmd_stats.h"
+#endif /* LWCELL_CFG_CMD_STATS || __DOXYGEN__ */
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE || __DOXYGEN__
+#include "lwcell/lwcell_baudrate.h"
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE || __DOXYGEN__ */
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+#include "lwcell/lwcell_cmux.h"
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+#include "lwcell/lwcell_ppp.h"
+#endif /* LWCELL_CFG_PPP || __DOXYGEN__ */
+#if LWCELL_CFG_FLOW_CONTROL || __DOXYGEN__
+#include "lwcell/lwcell_flow.h"
+#endif /* LWCELL_CFG_FLOW_CONTROL || __DOXYGEN__ */
+#if LWCELL_CFG_EVT_DEFER || __DOXYGEN__
+#include "lwcell/lwcell_evt_defer.h"
+#endif /* LWCELL_CFG_EVT_DEFER || __DOXYGEN__ */
+#if LWCELL_CFG_LOCK_DOMAINS || LWCELL_CFG_LOCK_STATS || __DOXYGEN__
+#include "lwcell/lwcell_lock.h"
+#endif /* LWCELL_CFG_LOCK_DOMAINS || LWCELL_CFG_LOCK_STATS || __DOXYGEN__ */
+#if LWCELL_CFG_STATE_SNAPSHOT || __DOXYGEN__
+#include "lwcell/lwcell_state.h"
+#endif /* LWCELL_CFG_STATE_SNAPSHOT || __DOXYGEN__ */
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT || __DOXYGEN__
+#include "lwcell/lwcell_cmd_adapt.h"
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT || __DOXYGEN__ */
+#if LWCELL_CFG_CMD_PRIO || __DOXYGEN__
+#include "lwcell/lwcell_cmd_prio.h"
+#endif /* LWCELL_CFG_CMD_PRIO || __DOXYGEN__ */
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+#include "lwcell/lwcell_metrics.h"
+#endif /* LWCELL_CFG_METRICS || __DOXYGEN__ */
+#if LWCELL_CFG_CACHE || __DOXYGEN__
+#include "lwcell/lwcell_cache.h"
+#endif /* LWCELL_CFG_CACHE || __DOXYGEN__ */
+#if LWCELL_CFG_CMD_CANCEL || __DOXYGEN__
+#include "lwcell/lwcell_cmd_cancel.h"
+#endif /* LWCELL_CFG_CMD_CANCEL || __DOXYGEN__ */
+#if LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__
+#include "lwcell/lwcell_loop.h"
+#endif /* LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__ */
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,98 @@
+/**
+ * \file            lwcell_lock.h
+ * \brief           Lock domains and statistics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_LOCK_HDR_H
+#define LWCELL_LOCK_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_LOCK Lock domains
+ * \brief           Lock domains, lock order and lock statistics
+ * \{
+ *
+ * Library state is protected by two lock domains:
+ *
+ * - Core lock, \ref lwcell_core_lock: input processing and parser, command queue
+ *      and current message, connection table, timeouts and event callbacks list.
+ *      Parser updates all of them within the same received line, hence they share one lock.
+ * - Memory lock, with \ref LWCELL_CFG_LOCK_DOMAINS enabled: memory allocator
+ *      and packet buffer reference counters. Otherwise it is part of core lock.
+ *
+ * Lock order is core lock first, memory lock second.
+ * Memory lock is a leaf, no other lock is taken while it is held.
+ *
+ * Application threads avoid core lock with \ref lwcell_state_get for status
+ * and \ref LWCELL_CFG_EVT_DEFER for event callbacks.
+ */
+
+/**
+ * \brief           Lock domain
+ */
+typedef enum {
+    LWCELL_LOCK_CORE = 0x00, /*!< Core lock */
+    LWCELL_LOCK_MEM,         /*!< Memory lock, used with \ref LWCELL_CFG_LOCK_DOMAINS enabled */
+    LWCELL_LOCK_END,         /*!< Number of lock domains */
+} lwcell_lock_t;
+
+/**
+ * \brief           Lock statistics of single domain
+ *
+ * Times are in units of \ref LWCELL_LOCK_STATS_TIME.
+ * Nested locking by the same thread is counted once.
+ */
+typedef struct {
+    uint32_t acquired;  /*!< Number of times lock has been acquired */
+    uint32_t contended; /*!< Number of times lock was held by other thread and caller had to wait */
+    uint32_t wait_max;  /*!< Longest wait for contended lock */
+    uint32_t wait_sum;  /*!< Total time spent waiting for contended lock */
+    uint32_t hold_max;  /*!< Longest time lock has been held */
+    uint32_t hold_sum;  /*!< Total time lock has been held */
+} lwcell_lock_stats_t;
+
+lwcellr_t lwcell_lock_get_stats(lwcell_lock_t lock, lwcell_lock_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_LOCK_HDR_H */
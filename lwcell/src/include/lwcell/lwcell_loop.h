@@ -0,0 +1,85 @@
+/**
+ * \file            lwcell_loop.h
+ * \brief           Single-thread event loop
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_LOOP_HDR_H
+#define LWCELL_LOOP_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_LOOP Event loop
+ * \brief           Single-thread event loop, merging producer and process threads
+ * \{
+ *
+ * Each run of \ref lwcell_loop_process processes received data, expired timeouts,
+ * checks active command for completion or timeout and starts next queued command. It never blocks.
+ *
+ * To embed the loop to application event loop (\ref LWCELL_CFG_LOOP_THREAD disabled),
+ * application sets wake-up function, which signals its own pollable handle (`eventfd`, RTOS event flag, ...),
+ * and waits on that handle up to \ref lwcell_loop_get_next_timeout milliseconds between loop runs.
+ *
+ * In bare-metal mode (\ref LWCELL_CFG_OS disabled), application calls \ref lwcell_poll from its main loop.
+ * Wake-up function may then be used to leave low-power mode, when called from \ref lwcell_input in interrupt context.
+ */
+
+#define LWCELL_LOOP_NO_TIMEOUT 0xFFFFFFFFUL /*!< No timeout is pending, loop runs only after wake-up */
+
+/**
+ * \brief           Loop wake-up function prototype
+ *
+ * Called from any thread when loop has new work: input data, new command or new timeout.
+ * Function must not call any stack API function.
+ *
+ * \param[in]       arg: Custom user argument
+ */
+typedef void (*lwcell_loop_wakeup_fn)(void* arg);
+
+lwcellr_t lwcell_loop_process(void);
+lwcellr_t lwcell_poll(void);
+uint32_t lwcell_loop_get_next_timeout(void);
+lwcellr_t lwcell_loop_set_wakeup_fn(lwcell_loop_wakeup_fn fn, void* arg);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_LOOP_HDR_H */
@@ -0,0 +1,98 @@
+/**
+ * \file            lwcell_metrics.h
+ * \brief           I/O and queue metrics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_METRICS_HDR_H
+#define LWCELL_METRICS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_METRICS I/O and queue metrics
+ * \brief           Consolidated counters for I/O, message queues, drops and memory
+ * \{
+ *
+ * Counters are updated with relaxed atomic operations and may be read at any time with \ref lwcell_metrics_get.
+ * Snapshot is not atomic as a whole, each counter is consistent on its own.
+ *
+ * Input call size histogram uses logarithmic bins: bin `n` counts calls with length
+ * in range `[4^n, 4^(n+1))` bytes, first bin also counts empty calls and last bin counts everything above.
+ */
+
+#define LWCELL_METRICS_RX_HIST_LEN 6 /*!< Number of bins in input call size histogram */
+
+/**
+ * \brief           Metrics snapshot
+ */
+typedef struct {
+    uint32_t rx_bytes;                                 /*!< Number of bytes received from device */
+    uint32_t rx_calls;                                 /*!< Number of input function calls */
+    uint32_t rx_call_max;                              /*!< Largest number of bytes in single input call */
+    uint32_t rx_call_hist[LWCELL_METRICS_RX_HIST_LEN]; /*!< Input call size histogram */
+    uint32_t tx_bytes;                                 /*!< Number of bytes sent to device */
+    uint32_t tx_calls;                                 /*!< Number of non-empty low-level send calls */
+    uint32_t producer_mbox_depth;                      /*!< Current number of messages in producer queue */
+    uint32_t producer_mbox_max;                        /*!< High-water mark of producer queue */
+    uint32_t producer_mbox_full;                       /*!< Number of messages rejected due to full producer queue */
+    uint32_t process_mbox_depth;                       /*!< Current number of entries in process queue */
+    uint32_t process_mbox_max;                         /*!< High-water mark of process queue */
+    uint32_t process_mbox_full;                        /*!< Number of wake-ups lost due to full process queue */
+    uint32_t ipd_ignored;                              /*!< Number of \ref lwcellOKIGNOREMORE receive events */
+    uint32_t ipd_skipped;                              /*!< Number of received bytes dropped without packet buffer */
+    uint32_t pbuf_failed;                              /*!< Number of failed packet buffer allocations */
+    uint32_t mem_failed;                               /*!< Number of failed memory allocations */
+    uint32_t cmd_coalesced;                            /*!< Number of queries completed by identical pending query */
+    uint32_t cache_hits;                               /*!< Number of queries answered from response cache */
+    uint32_t cmd_canceled;                             /*!< Number of commands dropped due to cancellation */
+    uint32_t cmd_expired;                              /*!< Number of commands dropped due to passed deadline */
+    size_t mem_total;                                  /*!< Total size of allocator memory in units of bytes */
+    size_t mem_available;                              /*!< Currently available memory in units of bytes */
+    size_t mem_min_available;                          /*!< Minimal available memory in units of bytes */
+} lwcell_metrics_t;
+
+lwcellr_t lwcell_metrics_get(lwcell_metrics_t* metrics);
+void lwcell_metrics_reset(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_METRICS_HDR_H */
@@ -32,11 +32,16 @@
  * Version:         v0.1.1
  */
 
-/* Order: Device name; Device model identification, Is_2G, Is_LTE */
-LWCELL_DEVICE_MODEL_ENTRY(SIM800x, "SIM800", 1, 0, 0)
-LWCELL_DEVICE_MODEL_ENTRY(SIM900x, "SIM900", 1, 0, 0)
-LWCELL_DEVICE_MODEL_ENTRY(SIM7070G, "7070G", 0, 1, 0)
+/*
+ * Order: Device name; Device model identification, Is_2G, Is_LTE, Has_MQTT_native,
+ *        Max connections, Max bytes in single send command, Max AT port baudrate
+ *
+ * Connections and send length are further limited by LWCELL_CFG_MAX_CONNS and LWCELL_CFG_CONN_MAX_DATA_LEN
+ */
+LWCELL_DEVICE_MODEL_ENTRY(SIM800x, "SIM800", 1, 0, 0, 6, 1460, 460800)
+LWCELL_DEVICE_MODEL_ENTRY(SIM900x, "SIM900", 1, 0, 0, 8, 1460, 115200)
+LWCELL_DEVICE_MODEL_ENTRY(SIM7070G, "7070G", 0, 1, 0, 13, 1460, 921600)
 //LWCELL_DEVICE_MODEL_ENTRY(SIM7000x, "SIM7000", 1, 0)
 //LWCELL_DEVICE_MODEL_ENTRY(SIM7020x, "SIM7020", 1, 0)
 
-#undef LWCELL_DEVICE_MODEL_ENTRY
\ No newline at end of file
+#undef LWCELL_DEVICE_MODEL_ENTRY
@@ -53,7 +53,10 @@
 /**
  * \brief           Enables `1` or disables `0` operating system support for GSM library
  *
- * \note            Value must be set to 1 in the current revision
+ * When disabled, stack runs in bare-metal polled mode.
+ * No threads, semaphores or message queues are used and application must call \ref lwcell_poll
+ * from its main loop. Commands may only be non-blocking and complete through API callback functions.
+ * System port must only implement \ref LWCELL_SYS_CORE functions.
  *
  * \note            Check \ref LWCELL_OPT_OS group for more configuration related to operating system
  *
@@ -115,6 +118,11 @@
 /**
  * \brief           Maximal number of connections AT software can support on GSM device
  *
+ * Connection table is allocated for this number of connections, value is upper bound for all devices.
+ * At runtime, library uses lower number when device model supports less connections.
+ * Increase it to use all connections of device supporting more, such as `13` for SIM7070G.
+ *
+ * \sa              lwcell_device_get_limits
  */
 #ifndef LWCELL_CFG_MAX_CONNS
 #define LWCELL_CFG_MAX_CONNS 6
@@ -122,11 +130,15 @@
 
 /**
  * \brief           Maximal number of bytes we can send at single command to GSM
- * \note            Value can not exceed `1460` bytes or no data will be ever send
+ * \note            Value is upper bound for buffers. At runtime, send command length is
+ *                  further limited to maximal length of identified device model.
+ *                  For unknown devices, value can not exceed `1460` bytes or no data will be ever send
  *
  * \note            This is limitation of GSM AT commands and on systems where RAM
- *                  is not an issue, it should be set to maximal value (`1460`)
+ *                  is not an issue, it should be set to maximal value of used device
  *                  to optimize data transfer speed performance
+ *
+ * \sa              lwcell_device_get_limits
  */
 #ifndef LWCELL_CFG_CONN_MAX_DATA_LEN
 #define LWCELL_CFG_CONN_MAX_DATA_LEN 1460
@@ -165,6 +177,144 @@
 #define LWCELL_CFG_AT_PORT_BAUDRATE 115200
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` AT port baudrate negotiation with `AT+IPR`
+ *
+ * When enabled, reset sequence switches device and AT port to highest working baudrate
+ * from \ref LWCELL_CFG_AT_BAUDRATE_LIST, after device has been identified.
+ * Low-level \ref lwcell_ll_init is called again with new baudrate on every change.
+ *
+ * Every reset sequence first returns device to \ref LWCELL_CFG_AT_PORT_BAUDRATE.
+ *
+ * When device does not respond at default baudrate at start of reset sequence,
+ * candidates are scanned, as device may have kept negotiated baudrate over host restart.
+ * Device found at one of them is returned to default baudrate first.
+ *
+ * \note            Scan delays reset sequence of unresponsive device by
+ *                  \ref LWCELL_CFG_AT_BAUDRATE_TIMEOUT for each candidate
+ * \sa              LWCELL_BAUDRATE
+ */
+#ifndef LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+#define LWCELL_CFG_AT_BAUDRATE_NEGOTIATE 0
+#endif
+
+/**
+ * \brief           Comma separated list of candidate baudrates in ascending order
+ *
+ * All baudrates must be supported by host AT port
+ */
+#ifndef LWCELL_CFG_AT_BAUDRATE_LIST
+#define LWCELL_CFG_AT_BAUDRATE_LIST 230400, 460800, 921600
+#endif
+
+/**
+ * \brief           Number of `AT` commands that must succeed to accept new baudrate
+ */
+#ifndef LWCELL_CFG_AT_BAUDRATE_VERIFY
+#define LWCELL_CFG_AT_BAUDRATE_VERIFY 3
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds to wait for response during negotiation
+ */
+#ifndef LWCELL_CFG_AT_BAUDRATE_TIMEOUT
+#define LWCELL_CFG_AT_BAUDRATE_TIMEOUT 300
+#endif
+
+/**
+ * \brief           Number of device models with remembered best working baudrate
+ */
+#ifndef LWCELL_CFG_AT_BAUDRATE_MODELS
+#define LWCELL_CFG_AT_BAUDRATE_MODELS 2
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` GSM 07.10 multiplexer on AT port
+ *
+ * When enabled, reset sequence starts multiplexer with `AT+CMUX` and opens control,
+ * data and unsolicited result code channels. Connection send commands are executed
+ * on data channel in separate thread, in parallel to other commands.
+ *
+ * \note            It requires operating system with separate producer and processing threads
+ */
+#ifndef LWCELL_CFG_CMUX
+#define LWCELL_CFG_CMUX 0
+#endif
+
+/**
+ * \brief           Maximum number of information bytes in single multiplexer frame
+ *
+ * Value is requested from device as `N1` parameter of `AT+CMUX` command.
+ * Same number of bytes is reserved for received frame and for transmit buffer of each channel
+ */
+#ifndef LWCELL_CFG_CMUX_FRAME_SIZE
+#define LWCELL_CFG_CMUX_FRAME_SIZE 127
+#endif
+
+/**
+ * \brief           Time in units of milliseconds to wait for device to confirm opening of each channel
+ */
+#ifndef LWCELL_CFG_CMUX_TIMEOUT
+#define LWCELL_CFG_CMUX_TIMEOUT 1000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` PPP data mode
+ *
+ * When enabled, device can be switched to data mode with `ATD*99#`
+ * and IP packets are exchanged with host IP stack, such as lwIP PPPoS or `pppd` on PTY.
+ * With \ref LWCELL_CFG_CMUX session runs on data channel and control channel stays available,
+ * otherwise device is temporarily switched to command mode with `+++` escape sequence for every command.
+ */
+#ifndef LWCELL_CFG_PPP
+#define LWCELL_CFG_PPP 0
+#endif
+
+/**
+ * \brief           PDP context identifier used for PPP session
+ */
+#ifndef LWCELL_CFG_PPP_CID
+#define LWCELL_CFG_PPP_CID 1
+#endif
+
+/**
+ * \brief           Guard time in units of milliseconds around `+++` escape sequence
+ *
+ * Device accepts escape sequence only when there is no data before and after it for this time
+ */
+#ifndef LWCELL_CFG_PPP_ESCAPE_GUARD
+#define LWCELL_CFG_PPP_ESCAPE_GUARD 1000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` hardware flow control and receive error accounting
+ *
+ * When low-level reports connected RTS/CTS lines with `uart.flow_control`,
+ * reset sequence enables flow control on device with `AT+IFC=2,2`.
+ * RTS line is released with `rts_fn` of low-level when input buffer
+ * passes \ref LWCELL_CFG_FLOW_CONTROL_HIGH_WATER and set again once
+ * it drains below \ref LWCELL_CFG_FLOW_CONTROL_LOW_WATER.
+ *
+ * Low-level reports overrun, framing, noise and parity errors with \ref lwcell_flow_rx_error
+ */
+#ifndef LWCELL_CFG_FLOW_CONTROL
+#define LWCELL_CFG_FLOW_CONTROL 0
+#endif
+
+/**
+ * \brief           Input buffer level in percent at which device is paused with RTS line
+ */
+#ifndef LWCELL_CFG_FLOW_CONTROL_HIGH_WATER
+#define LWCELL_CFG_FLOW_CONTROL_HIGH_WATER 75
+#endif
+
+/**
+ * \brief           Input buffer level in percent at which paused device may send again
+ */
+#ifndef LWCELL_CFG_FLOW_CONTROL_LOW_WATER
+#define LWCELL_CFG_FLOW_CONTROL_LOW_WATER 25
+#endif
+
 /**
  * \brief           Buffer size for received data waiting to be processed
  * \note            When server mode is active and a lot of connections are in queue
@@ -190,6 +340,21 @@
 #define LWCELL_CFG_RESET_ON_INIT 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` warm start of reset sequence
+ *
+ * When enabled, reset sequence started by \ref lwcell_init or \ref lwcell_device_set_present
+ * first queries device settings with single command line.
+ * If device answers, it is not reset and only settings that differ from expected configuration are sent,
+ * followed by device information, SIM and connection status queries.
+ * Full reset is done if device does not answer the query.
+ *
+ * \note            \ref lwcell_reset always performs full reset
+ */
+#ifndef LWCELL_CFG_RESET_WARM_START
+#define LWCELL_CFG_RESET_WARM_START 0
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` reset sequence after \ref lwcell_device_set_present call
  *
@@ -200,15 +365,56 @@
 #define LWCELL_CFG_RESET_ON_DEVICE_PRESENT 1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` device readiness probing on reset sequence
+ *
+ * When enabled, fixed delays before and after reset command are replaced by `AT` probes,
+ * sent every \ref LWCELL_CFG_RESET_PROBE_INTERVAL until device responds.
+ * After reset command, device is considered ready when it responds and boot indication,
+ * such as `RDY` or `SMS Ready`, has been received or \ref LWCELL_CFG_RESET_PROBE_MIN elapsed.
+ * Sequence continues after \ref LWCELL_CFG_RESET_PROBE_MAX regardless of device response
+ */
+#ifndef LWCELL_CFG_RESET_PROBE
+#define LWCELL_CFG_RESET_PROBE 0
+#endif
+
+/**
+ * \brief           Time in units of milliseconds between readiness probes
+ *
+ * It is also maximal time to wait for response to single probe
+ */
+#ifndef LWCELL_CFG_RESET_PROBE_INTERVAL
+#define LWCELL_CFG_RESET_PROBE_INTERVAL 200
+#endif
+
+/**
+ * \brief           Minimal time in units of milliseconds after reset command,
+ *                  before device is considered ready without boot indication
+ */
+#ifndef LWCELL_CFG_RESET_PROBE_MIN
+#define LWCELL_CFG_RESET_PROBE_MIN 1000
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds to probe device readiness
+ */
+#ifndef LWCELL_CFG_RESET_PROBE_MAX
+#define LWCELL_CFG_RESET_PROBE_MAX 10000
+#endif
+
 /**
  * \brief           Default delay (milliseconds unit) before sending first AT command on reset sequence
+ *
+ * \note            Delay is not used by default when \ref LWCELL_CFG_RESET_PROBE is enabled
  */
 #ifndef LWCELL_CFG_RESET_DELAY_DEFAULT
-#define LWCELL_CFG_RESET_DELAY_DEFAULT 1000
+#define LWCELL_CFG_RESET_DELAY_DEFAULT (LWCELL_CFG_RESET_PROBE ? 0 : 1000)
 #endif
 
 /**
  * \brief           Default delay (milliseconds unit) after reset sequence
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_RESET_PROBE is enabled
  */
 #ifndef LWCELL_CFG_RESET_DELAY_AFTER
 #define LWCELL_CFG_RESET_DELAY_AFTER 5000
@@ -231,6 +437,94 @@
 #define LWCELL_CFG_KEEP_ALIVE_TIMEOUT 1000
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` event subscription masks
+ *
+ * When enabled, \ref lwcell_evt_register_mask registers a callback for selected event types only.
+ * Library keeps per-type dispatch table, so each event only calls subscribed callbacks.
+ */
+#ifndef LWCELL_CFG_EVT_MASK
+#define LWCELL_CFG_EVT_MASK 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` deferred event dispatch
+ *
+ * When enabled, global and connection events are copied to a queue
+ * and callbacks are called from separate worker threads, without core lock held.
+ * Slow callback does not stall AT parsing anymore.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ * \sa              lwcell_evt_defer_exclude
+ */
+#ifndef LWCELL_CFG_EVT_DEFER
+#define LWCELL_CFG_EVT_DEFER 0
+#endif
+
+/**
+ * \brief           Number of events each worker thread can have waiting in its queue
+ *
+ * When queue is full, event is delivered synchronously on processing thread
+ */
+#ifndef LWCELL_CFG_EVT_DEFER_QUEUE_LEN
+#define LWCELL_CFG_EVT_DEFER_QUEUE_LEN 16
+#endif
+
+/**
+ * \brief           Number of worker threads for deferred events
+ *
+ * Events of connection are always delivered by the same thread, selected with connection number.
+ * Global events are delivered by first thread.
+ */
+#ifndef LWCELL_CFG_EVT_DEFER_THREADS
+#define LWCELL_CFG_EVT_DEFER_THREADS 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` modem state snapshot
+ *
+ * When enabled, registration, signal, operator, IP, SIM and connection states
+ * are published when core is unlocked after they changed. \ref lwcell_state_get reads them
+ * as one consistent copy, without core lock when C11 atomics are available.
+ */
+#ifndef LWCELL_CFG_STATE_SNAPSHOT
+#define LWCELL_CFG_STATE_SNAPSHOT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` separate lock domain for memory allocator
+ *
+ * When enabled, memory allocation and packet buffer reference counting
+ * use own leaf mutex instead of core lock. Application threads
+ * allocating or releasing buffers do not wait for AT parsing anymore.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ * \sa              LWCELL_LOCK
+ */
+#ifndef LWCELL_CFG_LOCK_DOMAINS
+#define LWCELL_CFG_LOCK_DOMAINS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` lock hold time and contention statistics
+ *
+ * \sa              lwcell_lock_get_stats, LWCELL_LOCK_STATS_TIME
+ */
+#ifndef LWCELL_CFG_LOCK_STATS
+#define LWCELL_CFG_LOCK_STATS 0
+#endif
+
+/**
+ * \brief           Time source for lock statistics
+ *
+ * Defaults to system time in units of milliseconds, which rounds short wait and hold times to zero.
+ * Contention is counted independently of time source.
+ * Set it to a finer counter, such as CPU cycle counter, for meaningful times.
+ */
+#ifndef LWCELL_LOCK_STATS_TIME
+#define LWCELL_LOCK_STATS_TIME() lwcell_sys_now()
+#endif
+
 /**
  * \defgroup        LWCELL_OPT_DBG Debugging
  * \brief           Debugging configurations
@@ -382,6 +676,143 @@
 #define LWCELL_CFG_AT_ECHO 0
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` batching of consecutive sub-commands to single command line
+ *
+ * When enabled, device information queries and registration setup of reset sequence
+ * are sent as single line, such as `AT+CGMI;+CGMM;+CGSN;+CGMR`, with single final response.
+ * If device rejects combined line, commands are repeated one by one and batching is disabled.
+ */
+#ifndef LWCELL_CFG_AT_BATCH
+#define LWCELL_CFG_AT_BATCH 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` binary capture of raw AT traffic
+ *
+ * When enabled, all data sent to and received from device can be recorded
+ * with timestamps to user output, set with \ref lwcell_capture_start.
+ * Capture can later be replayed on the host for debugging and profiling.
+ *
+ * \sa              LWCELL_CAPTURE
+ */
+#ifndef LWCELL_CFG_CAPTURE
+#define LWCELL_CFG_CAPTURE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` binary trace ring
+ *
+ * When enabled, hot paths (IPD, CIPSEND, timeouts, mbox and allocator)
+ * write fixed-size binary records to trace ring instead of formatting text.
+ * Ring is dumped with \ref lwcell_trace_dump and decoded on the host.
+ *
+ * \sa              LWCELL_TRACE, LWCELL_CFG_TRACE_RING_SIZE
+ */
+#ifndef LWCELL_CFG_TRACE
+#define LWCELL_CFG_TRACE 0
+#endif
+
+/**
+ * \brief           Number of records in trace ring
+ *
+ * \note            Value must be power of `2`.
+ *                  When ring is full, oldest records are overwritten
+ */
+#ifndef LWCELL_CFG_TRACE_RING_SIZE
+#define LWCELL_CFG_TRACE_RING_SIZE 128
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-command statistics
+ *
+ * When enabled, producer thread records number of executions, errors, timeouts
+ * and queue-wait and execution latency histograms for each command.
+ * Statistics are read with \ref lwcell_cmd_stats_get
+ *
+ * \sa              LWCELL_CMD_STATS, LWCELL_CFG_CMD_STATS_ENTRIES
+ */
+#ifndef LWCELL_CFG_CMD_STATS
+#define LWCELL_CFG_CMD_STATS 0
+#endif
+
+/**
+ * \brief           Maximal number of different commands tracked by statistics
+ *
+ * Entry is assigned to command on its first execution.
+ * When all entries are used, new commands are counted only in dropped counter
+ */
+#ifndef LWCELL_CFG_CMD_STATS_ENTRIES
+#define LWCELL_CFG_CMD_STATS_ENTRIES 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` adaptive command timeouts
+ *
+ * When enabled, stack keeps rolling execution times for each command
+ * and shortens command timeout to multiple of observed 99th percentile.
+ * Timeout given by API call remains upper limit.
+ * Only queries answered by device from its own state, such as signal quality,
+ * current operator, device information and connection status, are adapted.
+ * Other commands keep timeout given by API call, as their duration depends on network or stored data.
+ * State is read with \ref lwcell_cmd_adapt_get
+ *
+ * \sa              LWCELL_CMD_ADAPT
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_TIMEOUT
+#define LWCELL_CFG_CMD_ADAPT_TIMEOUT 0
+#endif
+
+/**
+ * \brief           Maximal number of different commands tracked for adaptive timeouts
+ *
+ * When all entries are used, new commands keep timeout given by API call
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_ENTRIES
+#define LWCELL_CFG_CMD_ADAPT_ENTRIES 16
+#endif
+
+/**
+ * \brief           Number of last execution times kept for each command
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_SAMPLES
+#define LWCELL_CFG_CMD_ADAPT_SAMPLES 16
+#endif
+
+/**
+ * \brief           Minimal number of execution times before command timeout is adapted
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES
+#define LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES 8
+#endif
+
+/**
+ * \brief           Multiplier applied to 99th percentile of execution time to get command timeout
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_FACTOR
+#define LWCELL_CFG_CMD_ADAPT_FACTOR 4
+#endif
+
+/**
+ * \brief           Minimal adapted command timeout in units of milliseconds
+ */
+#ifndef LWCELL_CFG_CMD_ADAPT_MIN
+#define LWCELL_CFG_CMD_ADAPT_MIN 1000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` I/O and queue metrics
+ *
+ * When enabled, stack counts received and sent bytes, input call sizes,
+ * message queue depths, dropped data and failed allocations.
+ * Counters use relaxed atomic increments and are cheap enough for production builds.
+ *
+ * \sa              LWCELL_METRICS
+ */
+#ifndef LWCELL_CFG_METRICS
+#define LWCELL_CFG_METRICS 0
+#endif
+
 /**
  * \}
  */
@@ -445,6 +876,144 @@
 #define LWCELL_THREAD_PROCESS_HOOK()
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` single-thread event-loop mode
+ *
+ * When enabled, producer and process threads are merged into single event loop,
+ * which processes received data, expired timeouts and next queued command.
+ * Commands are started and completed without blocking the loop,
+ * which saves one thread stack, synchronization semaphore and context switches per command.
+ *
+ * Loop runs in built-in thread, or in application event loop when \ref LWCELL_CFG_LOOP_THREAD is disabled.
+ *
+ * \note            Blocking API calls are allowed only from threads other than the one running the loop
+ * \note            Mode is always used when \ref LWCELL_CFG_OS is disabled
+ * \sa              lwcell_loop_process
+ */
+#ifndef LWCELL_CFG_SINGLE_THREAD
+#define LWCELL_CFG_SINGLE_THREAD (!LWCELL_CFG_OS)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` built-in thread running event loop
+ *
+ * When disabled, stack does not create any thread and application must call \ref lwcell_loop_process
+ * when wake-up function set by \ref lwcell_loop_set_wakeup_fn is called
+ * or when time returned by \ref lwcell_loop_get_next_timeout expires.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_SINGLE_THREAD is disabled
+ *                  and must be disabled when \ref LWCELL_CFG_OS is disabled
+ */
+#ifndef LWCELL_CFG_LOOP_THREAD
+#define LWCELL_CFG_LOOP_THREAD LWCELL_CFG_OS
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` priority classes of commands in producer queue
+ *
+ * When enabled, data-path commands are executed before control commands
+ * and control commands before background queries, regardless of order they were queued.
+ * Up to \ref LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE commands are sorted at a time,
+ * others stay in producer queue and keep its size limit in effect for API calls.
+ *
+ * \sa              LWCELL_CMD_PRIO, LWCELL_CFG_CMD_PRIO_MAX_WAIT
+ */
+#ifndef LWCELL_CFG_CMD_PRIO
+#define LWCELL_CFG_CMD_PRIO 0
+#endif
+
+/**
+ * \brief           Maximal queue delay in units of milliseconds before command is executed regardless of its class
+ *
+ * It protects lower priority commands from starvation.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_CMD_PRIO is disabled
+ */
+#ifndef LWCELL_CFG_CMD_PRIO_MAX_WAIT
+#define LWCELL_CFG_CMD_PRIO_MAX_WAIT 5000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` coalescing of identical queries
+ *
+ * When enabled, signal strength, current operator and connection status query
+ * is not queued again if identical query is already waiting in producer queue or is being executed.
+ * New request is completed together with pending query, with its result and status.
+ */
+#ifndef LWCELL_CFG_CMD_COALESCE
+#define LWCELL_CFG_CMD_COALESCE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` command deadlines and cancellation
+ *
+ * When enabled, queries waiting in producer queue past their deadline
+ * and commands cancelled with \ref lwcell_cmd_cancel are dropped without accessing device.
+ *
+ * \note            \ref LWCELL_CFG_USE_API_FUNC_EVT must be enabled
+ * \sa              LWCELL_CMD_CANCEL, LWCELL_CFG_CMD_DEADLINE
+ */
+#ifndef LWCELL_CFG_CMD_CANCEL
+#define LWCELL_CFG_CMD_CANCEL 0
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds query may wait in producer queue before execution starts
+ *
+ * Applies only to queries which do not change device or stack state, other commands are always executed.
+ * Set to `0` to disable deadlines and only use cancellation.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_CMD_CANCEL is disabled
+ */
+#ifndef LWCELL_CFG_CMD_DEADLINE
+#define LWCELL_CFG_CMD_DEADLINE 30000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` response cache of slow-changing device state
+ *
+ * When enabled, device info, current operator and RSSI queries are answered
+ * without accessing device, while value received before is still fresh.
+ *
+ * \sa              LWCELL_CACHE
+ */
+#ifndef LWCELL_CFG_CACHE
+#define LWCELL_CFG_CACHE 0
+#endif
+
+/**
+ * \brief           Time-to-live of cached device manufacturer, model, serial number and revision in units of milliseconds
+ *
+ * Default value keeps information until device reset. Set to `0` to disable caching of these values.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_CACHE is disabled
+ */
+#ifndef LWCELL_CFG_CACHE_TTL_DEVICE_INFO
+#define LWCELL_CFG_CACHE_TTL_DEVICE_INFO 0xFFFFFFFFUL
+#endif
+
+/**
+ * \brief           Time-to-live of cached current operator in units of milliseconds
+ *
+ * Set to `0` to disable caching of this value.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_CACHE is disabled
+ */
+#ifndef LWCELL_CFG_CACHE_TTL_OPERATOR
+#define LWCELL_CFG_CACHE_TTL_OPERATOR 30000
+#endif
+
+/**
+ * \brief           Time-to-live of cached RSSI value in units of milliseconds
+ *
+ * Set to `0` to disable caching of this value.
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_CACHE is disabled
+ */
+#ifndef LWCELL_CFG_CACHE_TTL_RSSI
+#define LWCELL_CFG_CACHE_TTL_RSSI 2000
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` custom memory byte pool extension for ThreadX port
  *
@@ -751,8 +1320,55 @@ void *  my_memset(void* dst, int b, size_t len);
 #if LWCELL_CFG_INPUT_USE_PROCESS
 #error "LWCELL_CFG_INPUT_USE_PROCESS may only be enabled when OS is used!"
 #endif /* LWCELL_CFG_INPUT_USE_PROCESS */
+#if !LWCELL_CFG_SINGLE_THREAD || LWCELL_CFG_LOOP_THREAD
+#error "LWCELL_CFG_SINGLE_THREAD must be enabled and LWCELL_CFG_LOOP_THREAD disabled when OS is not used!"
+#endif /* !LWCELL_CFG_SINGLE_THREAD || LWCELL_CFG_LOOP_THREAD */
+#if LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_NETCONN */
+#if LWCELL_CFG_EVT_DEFER
+#error "LWCELL_CFG_EVT_DEFER may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_EVT_DEFER */
+#if LWCELL_CFG_LOCK_DOMAINS
+#error "LWCELL_CFG_LOCK_DOMAINS may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_LOCK_DOMAINS */
 #endif /* !LWCELL_CFG_OS */
 
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT
+#if LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES < 1 || LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES > LWCELL_CFG_CMD_ADAPT_SAMPLES
+#error "LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES must be between 1 and LWCELL_CFG_CMD_ADAPT_SAMPLES!"
+#endif
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT */
+
+#if LWCELL_CFG_CMUX && (!LWCELL_CFG_OS || LWCELL_CFG_SINGLE_THREAD)
+#error "LWCELL_CFG_CMUX requires LWCELL_CFG_OS enabled and LWCELL_CFG_SINGLE_THREAD disabled!"
+#endif /* LWCELL_CFG_CMUX && (!LWCELL_CFG_OS || LWCELL_CFG_SINGLE_THREAD) */
+#if LWCELL_CFG_CMUX && (LWCELL_CFG_CMUX_FRAME_SIZE < 31 || LWCELL_CFG_CMUX_FRAME_SIZE > 1500)
+#error "LWCELL_CFG_CMUX_FRAME_SIZE must be between 31 and 1500!"
+#endif /* LWCELL_CFG_CMUX && (LWCELL_CFG_CMUX_FRAME_SIZE < 31 || LWCELL_CFG_CMUX_FRAME_SIZE > 1500) */
+#if LWCELL_CFG_PPP && LWCELL_CFG_PPP_CID < 1
+#error "LWCELL_CFG_PPP_CID must be at least 1!"
+#endif /* LWCELL_CFG_PPP && LWCELL_CFG_PPP_CID < 1 */
+#if LWCELL_CFG_FLOW_CONTROL && LWCELL_CFG_FLOW_CONTROL_HIGH_WATER > 100
+#error "LWCELL_CFG_FLOW_CONTROL_HIGH_WATER must not exceed 100 percent!"
+#endif /* LWCELL_CFG_FLOW_CONTROL && LWCELL_CFG_FLOW_CONTROL_HIGH_WATER > 100 */
+#if LWCELL_CFG_EVT_DEFER && LWCELL_CFG_EVT_DEFER_THREADS < 1
+#error "LWCELL_CFG_EVT_DEFER_THREADS must be at least 1!"
+#endif /* LWCELL_CFG_EVT_DEFER && LWCELL_CFG_EVT_DEFER_THREADS < 1 */
+#if LWCELL_CFG_FLOW_CONTROL && LWCELL_CFG_FLOW_CONTROL_LOW_WATER >= LWCELL_CFG_FLOW_CONTROL_HIGH_WATER
+#error "LWCELL_CFG_FLOW_CONTROL_LOW_WATER must be below LWCELL_CFG_FLOW_CONTROL_HIGH_WATER!"
+#endif /* LWCELL_CFG_FLOW_CONTROL && LWCELL_CFG_FLOW_CONTROL_LOW_WATER >= LWCELL_CFG_FLOW_CONTROL_HIGH_WATER */
+
+#if LWCELL_CFG_CMD_CANCEL && !LWCELL_CFG_USE_API_FUNC_EVT
+#error "LWCELL_CFG_CMD_CANCEL requires LWCELL_CFG_USE_API_FUNC_EVT to be enabled!"
+#endif /* LWCELL_CFG_CMD_CANCEL && !LWCELL_CFG_USE_API_FUNC_EVT */
+
+#if LWCELL_CFG_TRACE
+#if (LWCELL_CFG_TRACE_RING_SIZE & (LWCELL_CFG_TRACE_RING_SIZE - 1)) != 0
+#error "LWCELL_CFG_TRACE_RING_SIZE must be power of 2!"
+#endif /* (LWCELL_CFG_TRACE_RING_SIZE & (LWCELL_CFG_TRACE_RING_SIZE - 1)) != 0 */
+#endif /* LWCELL_CFG_TRACE */
+
 #endif /* !__DOXYGEN__ */
 
 #include "lwcell/lwcell_debug.h"
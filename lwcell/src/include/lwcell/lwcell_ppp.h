@@ -0,0 +1,98 @@
+/**
+ * \file            lwcell_ppp.h
+ * \brief           PPP data mode
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_PPP_HDR_H
+#define LWCELL_PPP_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_PPP PPP data mode
+ * \brief           Exchange IP packets with host IP stack over PPP
+ * \{
+ *
+ * Session is started with `AT+CGDCONT` and `ATD*99#` once device is attached to network.
+ * After `CONNECT`, received bytes bypass AT parser and are passed to input function,
+ * which feeds them to host PPP implementation, for instance `pppos_input` of lwIP
+ * or master side of PTY used by `pppd`.
+ * Host PPP implementation sends its frames with \ref lwcell_ppp_output.
+ *
+ * When \ref LWCELL_CFG_CMUX is running, session uses data channel and
+ * commands are executed on control channel in parallel.
+ * Without multiplexer, device is switched to command mode with `+++`
+ * for every command and returned to data mode with `ATO` afterwards.
+ */
+
+/**
+ * \brief           Function receiving data from device while in data mode
+ * \note            Function is called from processing thread with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       arg: User argument
+ */
+typedef void (*lwcell_ppp_input_fn)(const void* data, size_t len, void* arg);
+
+/**
+ * \brief           PPP statistics
+ */
+typedef struct {
+    uint8_t is_online;     /*!< Set to `1` when device is in data mode */
+    uint32_t sessions;     /*!< Number of started sessions */
+    uint32_t carrier_lost; /*!< Number of sessions ended by device with `NO CARRIER` */
+    uint32_t escapes;      /*!< Number of switches to command mode during session */
+    uint32_t bytes_tx;     /*!< Number of bytes sent in data mode */
+    uint32_t bytes_rx;     /*!< Number of bytes received in data mode */
+    uint32_t dropped_tx;   /*!< Number of bytes not sent, because device was in command mode */
+} lwcell_ppp_stats_t;
+
+lwcellr_t lwcell_ppp_start(const char* apn, lwcell_ppp_input_fn input_fn, void* input_arg,
+                           const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ppp_stop(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+size_t lwcell_ppp_output(const void* data, size_t len);
+uint8_t lwcell_ppp_is_online(void);
+lwcellr_t lwcell_ppp_get_stats(lwcell_ppp_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_PPP_HDR_H */
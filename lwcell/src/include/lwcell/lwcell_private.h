@@ -59,15 +59,23 @@ extern "C" {
  */
 typedef enum {
     LWCELL_CMD_IDLE = 0, /*!< IDLE mode */
+    LWCELL_CMD_DELAY,    /*!< Wait before next command of sequence, nothing is sent to device */
 
     /* Basic AT commands */
     LWCELL_CMD_RESET,                  /*!< Reset device */
     LWCELL_CMD_RESET_DEVICE_FIRST_CMD, /*!< Reset device first driver specific command */
+    LWCELL_CMD_RESET_PROBE,            /*!< Check if device is ready to accept commands */
+    LWCELL_CMD_RESET_WARM_CHECK,       /*!< Query device settings to skip full reset on warm start */
     LWCELL_CMD_ATE0,                   /*!< Disable ECHO mode on AT commands */
     LWCELL_CMD_ATE1,                   /*!< Enable ECHO mode on AT commands */
     LWCELL_CMD_GSLP,                   /*!< Set GSM to sleep mode */
     LWCELL_CMD_RESTORE,                /*!< Restore GSM internal settings to default values */
-    LWCELL_CMD_UART,
+    LWCELL_CMD_UART,                   /*!< Set AT port baudrate */
+    LWCELL_CMD_UART_VERIFY,            /*!< Verify communication after AT port baudrate change */
+    LWCELL_CMD_UART_SCAN,              /*!< Look for baudrate device kept from before host restart */
+    LWCELL_CMD_CMUX_SET,               /*!< Start GSM 07.10 multiplexer */
+    LWCELL_CMD_CMUX_OPEN,              /*!< Open multiplexer channels */
+    LWCELL_CMD_IFC_SET,                /*!< Enable hardware flow control */
 
     LWCELL_CMD_CGACT_SET_0,
     LWCELL_CMD_CGACT_SET_1,
@@ -80,6 +88,14 @@ typedef enum {
     LWCELL_CMD_CIPRXGET_SET,
     LWCELL_CMD_CSTT_SET,
 
+    LWCELL_CMD_PPP_START,  /*!< Start PPP session */
+    LWCELL_CMD_PPP_STOP,   /*!< Stop PPP session */
+    LWCELL_CMD_CGDCONT,    /*!< Define PDP context for PPP session */
+    LWCELL_CMD_PPP_DIAL,   /*!< Enter data mode with `ATD*99#` */
+    LWCELL_CMD_PPP_ESCAPE, /*!< Switch from data mode to command mode with `+++` */
+    LWCELL_CMD_PPP_RESUME, /*!< Return to data mode with `ATO` */
+    LWCELL_CMD_PPP_HANGUP, /*!< End PPP session with `ATH` */
+
     /* AT commands according to the V.25TER */
     LWCELL_CMD_CALL_ENABLE,
     LWCELL_CMD_A,       /*!< Re-issues the Last Command Given */
@@ -336,8 +352,11 @@ typedef struct lwcell_msg {
     lwcell_cmd_t cmd_def; /*!< Default message type received from queue */
     lwcell_cmd_t cmd;     /*!< Since some commands can have different subcommands, sub command is used here */
     uint8_t i;            /*!< Variable to indicate order number of subcommands */
+#if LWCELL_CFG_OS || __DOXYGEN__
     lwcell_sys_sem_t sem; /*!< Semaphore for the message */
+#endif                    /* LWCELL_CFG_OS || __DOXYGEN__ */
     uint8_t is_blocking;  /*!< Status if command is blocking */
+    uint8_t is_done;      /*!< Set once command finished or timed-out, only single completion is signalled */
     uint32_t block_time;  /*!< Maximal blocking time in units of milliseconds. Use 0 to for non-blocking call */
     lwcellr_t res;        /*!< Result of message operation */
     lwcellr_t (*fn)(struct lwcell_msg*); /*!< Processing callback function to process packet */
@@ -346,11 +365,32 @@ typedef struct lwcell_msg {
     lwcell_api_cmd_evt_fn evt_fn; /*!< Command callback API function */
     void* evt_arg;                /*!< Command callback API callback parameter */
 #endif                            /* LWCELL_CFG_USE_API_FUNC_EVT */
+#if LWCELL_CFG_CMD_STATS || LWCELL_CFG_CMD_PRIO || LWCELL_CFG_CMD_CANCEL
+    uint32_t time_queued; /*!< Time when message was put to producer queue, used for statistics, priorities and deadline */
+#endif                    /* LWCELL_CFG_CMD_STATS || LWCELL_CFG_CMD_PRIO || LWCELL_CFG_CMD_CANCEL */
+#if LWCELL_CFG_CMD_PRIO
+    uint8_t prio;            /*!< Priority class, member of \ref lwcell_cmd_prio_t */
+    struct lwcell_msg* next; /*!< Next message in priority class queue */
+#endif                       /* LWCELL_CFG_CMD_PRIO */
+#if LWCELL_CFG_CMD_COALESCE
+    struct lwcell_msg* waiter; /*!< Next identical query completed together with this one */
+#endif                         /* LWCELL_CFG_CMD_COALESCE */
+#if LWCELL_CFG_CMD_CANCEL
+    uint32_t deadline;              /*!< Absolute time after which message is not executed anymore */
+    uint8_t is_cancelled;           /*!< Set to `1` when cancelled by application */
+    struct lwcell_msg* queued_next; /*!< Next message in list of messages waiting in producer queue */
+#endif                              /* LWCELL_CFG_CMD_CANCEL */
+#if LWCELL_CFG_CMUX
+    uint8_t cmux_ch; /*!< Multiplexer channel to execute command on, member of \ref lwcell_cmux_ch_t */
+#endif               /* LWCELL_CFG_CMUX */
 
     union {
         struct {
             uint32_t delay; /*!< Delay to use before sending first reset AT command */
-        } reset;            /*!< Reset device */
+#if LWCELL_CFG_RESET_WARM_START
+            uint8_t warm; /*!< Set to `1` to keep device settings if they match expected configuration */
+#endif                    /* LWCELL_CFG_RESET_WARM_START */
+        } reset;          /*!< Reset device */
 
         struct {
             uint32_t baudrate; /*!< Baudrate for AT port */
@@ -538,6 +578,13 @@ typedef struct lwcell_msg {
             const char* pass; /*!< APN password */
         } network_attach;     /*!< Settings for network attach */
 #endif                        /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+        struct {
+            const char* apn;              /*!< APN address or `NULL` to use context defined in device */
+            lwcell_ppp_input_fn input_fn; /*!< Function receiving data in data mode */
+            void* input_arg;              /*!< Custom argument for input function */
+        } ppp_start;                      /*!< Settings for PPP session start */
+#endif                                    /* LWCELL_CFG_PPP || __DOXYGEN__ */
     } msg;                    /*!< Group of different possible message contents */
 } lwcell_msg_t;
 
@@ -570,6 +617,9 @@ typedef struct {
 typedef struct lwcell_evt_func {
     struct lwcell_evt_func* next; /*!< Next function in the list */
     lwcell_evt_fn fn;             /*!< Function pointer itself */
+#if LWCELL_CFG_EVT_MASK || __DOXYGEN__
+    lwcell_evt_mask_t mask; /*!< Subscribed event types */
+#endif                      /* LWCELL_CFG_EVT_MASK || __DOXYGEN__ */
 } lwcell_evt_func_t;
 
 /**
@@ -634,21 +684,48 @@ typedef struct {
     lwcell_ip_t ip_addr; /*!< Device IP address when network PDP context is enabled */
 } lwcell_network_t;
 
+#if LWCELL_CFG_CACHE || __DOXYGEN__
+/**
+ * \brief           Cached query values
+ */
+typedef enum {
+    LWCELL_CACHE_MANUFACTURER,  /*!< Device manufacturer */
+    LWCELL_CACHE_MODEL,         /*!< Device model number */
+    LWCELL_CACHE_SERIAL_NUMBER, /*!< Device serial number */
+    LWCELL_CACHE_REVISION,      /*!< Device revision */
+    LWCELL_CACHE_OPERATOR,      /*!< Current operator */
+    LWCELL_CACHE_RSSI,          /*!< Signal strength */
+    LWCELL_CACHE_END,
+} lwcell_cache_entry_t;
+
+/**
+ * \brief           Cache state of single value
+ */
+typedef struct {
+    uint32_t time; /*!< Time when value has been received from device */
+    uint8_t valid; /*!< Set to `1` when value has been received and not invalidated since */
+} lwcell_cache_t;
+#endif /* LWCELL_CFG_CACHE || __DOXYGEN__ */
+
 /**
  * \brief           GSM modules structure
  */
 typedef struct {
     /* Device identification */
-    char model_manufacturer[20];  /*!< Device manufacturer */
-    char model_number[20];        /*!< Device model number */
-    char model_serial_number[20]; /*!< Device serial number */
-    char model_revision[20];      /*!< Device revision */
-    lwcell_device_model_t model;  /*!< Device model */
+    char model_manufacturer[20];   /*!< Device manufacturer */
+    char model_number[20];         /*!< Device model number */
+    char model_serial_number[20];  /*!< Device serial number */
+    char model_revision[20];       /*!< Device revision */
+    lwcell_device_model_t model;   /*!< Device model */
+    lwcell_device_limits_t limits; /*!< Device limits, set after device has been identified */
 
     /* Network&operator specific */
     lwcell_sim_t sim;         /*!< SIM data */
     lwcell_network_t network; /*!< Network status */
     int16_t rssi;             /*!< RSSI signal strength. `0` = invalid, `-53 % -113` = valid */
+#if LWCELL_CFG_CACHE || __DOXYGEN__
+    lwcell_cache_t cache[LWCELL_CACHE_END]; /*!< State of cached values, cleared with device reset */
+#endif                                      /* LWCELL_CFG_CACHE || __DOXYGEN__ */
 
     /* Device specific */
 #if LWCELL_CFG_CONN || __DOXYGEN__
@@ -675,11 +752,18 @@ typedef struct {
 typedef struct {
     size_t locked_cnt; /*!< Counter how many times (recursive) stack is currently locked */
 
+#if LWCELL_CFG_OS || __DOXYGEN__
     lwcell_sys_sem_t sem_sync;          /*!< Synchronization semaphore between threads */
     lwcell_sys_mbox_t mbox_producer;    /*!< Producer message queue handle */
     lwcell_sys_mbox_t mbox_process;     /*!< Consumer message queue handle */
     lwcell_sys_thread_t thread_produce; /*!< Producer thread handle */
     lwcell_sys_thread_t thread_process; /*!< Processing thread handle */
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+    lwcell_sys_sem_t sem_sync_data;  /*!< Synchronization semaphore for multiplexer data channel */
+    lwcell_sys_mbox_t mbox_data;     /*!< Message queue handle for multiplexer data channel */
+    lwcell_sys_thread_t thread_data; /*!< Producer thread handle for multiplexer data channel */
+#endif                               /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+#endif                                  /* LWCELL_CFG_OS || __DOXYGEN__ */
 #if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
     lwcell_buff_t buff; /*!< Input processing buffer */
 #endif                  /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
@@ -689,6 +773,16 @@ typedef struct {
 
     lwcell_evt_t evt;            /*!< Callback processing structure */
     lwcell_evt_func_t* evt_func; /*!< Callback function linked list */
+#if LWCELL_CFG_EVT_MASK || __DOXYGEN__
+    lwcell_evt_fn* evt_disp;                   /*!< Per-type dispatch table built from `evt_func` list.
+                                                    List is walked when `NULL` */
+    uint16_t evt_disp_idx[LWCELL_EVT_END + 1]; /*!< Callbacks for type `t` are in `evt_disp`
+                                                    from `evt_disp_idx[t]` to `evt_disp_idx[t + 1]` */
+#endif                                         /* LWCELL_CFG_EVT_MASK || __DOXYGEN__ */
+#if LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__
+    lwcell_loop_wakeup_fn loop_wakeup_fn; /*!< Event loop wake-up function */
+    void* loop_wakeup_arg;                /*!< Event loop wake-up function argument */
+#endif                                    /* LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__ */
 
     lwcell_modules_t m; /*!< All modules. When resetting, reset structure */
 
@@ -717,6 +811,9 @@ typedef struct {
     uint8_t is_2g;               /*!< Status if modem is 2G */
     uint8_t is_lte;              /*!< Status if modem is LTE */
     uint8_t has_mqtt_native;     /*!< Status if modem supports native MQTT commands */
+    uint8_t conns_max;           /*!< Number of connections supported by device */
+    uint16_t send_max;           /*!< Maximal number of bytes in single send command */
+    uint32_t baudrate_max;       /*!< Maximal AT port baudrate */
 } lwcell_dev_model_map_t;
 
 /**
@@ -763,13 +860,21 @@ extern const size_t lwcell_dev_model_map_size;
         (name)->is_blocking = LWCELL_U8((blocking) > 0);                                                               \
     } while (0)
 #define LWCELL_MSG_VAR_REF(name) (*(name))
-#define LWCELL_MSG_VAR_FREE(name)                                                                                      \
+#if LWCELL_CFG_OS
+#define LWCELL_MSG_VAR_SEM_DELETE(name)                                                                                \
     do {                                                                                                               \
-        LWCELL_DEBUGF(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, "[MSG VAR] Free memory: %p\r\n", (void*)(name));     \
         if (lwcell_sys_sem_isvalid(&((name)->sem))) {                                                                  \
             lwcell_sys_sem_delete(&((name)->sem));                                                                     \
             lwcell_sys_sem_invalid(&((name)->sem));                                                                    \
         }                                                                                                              \
+    } while (0)
+#else /* LWCELL_CFG_OS */
+#define LWCELL_MSG_VAR_SEM_DELETE(name)
+#endif /* !LWCELL_CFG_OS */
+#define LWCELL_MSG_VAR_FREE(name)                                                                                      \
+    do {                                                                                                               \
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, "[MSG VAR] Free memory: %p\r\n", (void*)(name));     \
+        LWCELL_MSG_VAR_SEM_DELETE(name);                                                                               \
         lwcell_mem_free_s((void**)&(name));                                                                            \
     } while (0)
 #if LWCELL_CFG_USE_API_FUNC_EVT
@@ -807,7 +912,18 @@ lwcellr_t lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn cb);
 void lwcelli_conn_init(void);
 lwcellr_t lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwcell_msg_t*),
                                             uint32_t max_block_time);
+lwcellr_t lwcelli_msg_start(lwcell_msg_t* msg);
+void lwcelli_msg_finish(lwcell_msg_t* msg, lwcellr_t res, uint32_t time_start);
+void lwcelli_process_wakeup(void);
+#if LWCELL_CFG_OS
 uint32_t lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32_t timeout);
+#else  /* LWCELL_CFG_OS */
+uint8_t lwcelli_msg_queue_put(lwcell_msg_t* msg);
+#endif /* !LWCELL_CFG_OS */
+#if LWCELL_CFG_SINGLE_THREAD
+uint32_t lwcelli_timeout_get_next(void);
+void lwcelli_timeout_process_expired(void);
+#endif /* LWCELL_CFG_SINGLE_THREAD */
 uint8_t lwcelli_conn_closed_process(uint8_t conn_num, uint8_t forced);
 void lwcelli_conn_start_timeout(lwcell_conn_p conn);
 
@@ -816,6 +932,177 @@ lwcellr_t lwcelli_get_sim_info(const uint32_t blocking);
 void lwcelli_reset_everything(uint8_t forced);
 void lwcelli_process_events_for_timeout_or_error(lwcell_msg_t* msg, lwcellr_t err);
 
+#if LWCELL_CFG_CAPTURE
+void lwcelli_capture(lwcell_capture_dir_t dir, const void* data, size_t len);
+#endif /* LWCELL_CFG_CAPTURE */
+
+#if LWCELL_CFG_CMD_PRIO
+void lwcelli_cmd_prio_put(lwcell_msg_t* msg);
+lwcell_msg_t* lwcelli_cmd_prio_get(void);
+uint8_t lwcelli_cmd_prio_is_empty(void);
+uint8_t lwcelli_cmd_prio_is_full(void);
+#endif /* LWCELL_CFG_CMD_PRIO */
+
+#if LWCELL_CFG_CACHE
+void lwcelli_cache_set(lwcell_cache_entry_t entry);
+void lwcelli_cache_invalidate(lwcell_cache_entry_t entry);
+uint8_t lwcelli_cache_answer(lwcell_msg_t* msg);
+#define LWCELL_CACHE_SET(entry)        lwcelli_cache_set(LWCELL_CACHE_##entry)
+#define LWCELL_CACHE_INVALIDATE(entry) lwcelli_cache_invalidate(LWCELL_CACHE_##entry)
+#else /* LWCELL_CFG_CACHE */
+#define LWCELL_CACHE_SET(entry)
+#define LWCELL_CACHE_INVALIDATE(entry)
+#endif /* !LWCELL_CFG_CACHE */
+
+#if LWCELL_CFG_CMD_CANCEL
+void lwcelli_cmd_cancel_queued(lwcell_msg_t* msg);
+void lwcelli_cmd_cancel_dequeued(lwcell_msg_t* msg);
+lwcellr_t lwcelli_cmd_cancel_check(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CMD_CANCEL */
+
+#if LWCELL_CFG_CMD_COALESCE
+uint8_t lwcelli_cmd_coalesce_attach(lwcell_msg_t* msg);
+void lwcelli_cmd_coalesce_finish(lwcell_msg_t* msg);
+void lwcelli_cmd_coalesce_abort(lwcell_msg_t* msg, lwcellr_t res);
+#endif /* LWCELL_CFG_CMD_COALESCE */
+
+#if LWCELL_CFG_CMD_STATS
+void lwcelli_cmd_stats_record(lwcell_cmd_t cmd, lwcellr_t res, uint32_t wait_time, uint32_t exec_time);
+#endif /* LWCELL_CFG_CMD_STATS */
+
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+void lwcelli_baudrate_set(uint32_t rate);
+uint32_t lwcelli_baudrate_start(void);
+uint32_t lwcelli_baudrate_verified(uint32_t rate, uint8_t is_fallback);
+uint32_t lwcelli_baudrate_failed(uint32_t rate);
+uint32_t lwcelli_baudrate_candidate(size_t idx);
+void lwcelli_baudrate_found(uint32_t rate);
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+
+#if LWCELL_CFG_CMUX
+uint8_t lwcelli_cmux_is_active(void);
+uint8_t lwcelli_cmux_channel(const lwcell_msg_t* msg);
+void lwcelli_cmux_open(void);
+void lwcelli_cmux_close(void);
+void lwcelli_cmux_input(const void* data, size_t len);
+size_t lwcelli_cmux_send(uint8_t ch, const void* data, size_t len);
+void lwcelli_cmux_opened(uint8_t is_ok);
+uint8_t lwcelli_channel_select(uint8_t ch);
+void lwcelli_channel_reset(void);
+void lwcelli_channel_process(uint8_t ch, const void* data, size_t len);
+lwcell_msg_t* lwcelli_channel_msg(uint8_t ch);
+size_t lwcelli_at_port_write(const void* data, size_t len);
+#endif /* LWCELL_CFG_CMUX */
+
+#if LWCELL_CFG_PPP
+uint8_t lwcelli_ppp_is_online(uint8_t ch);
+uint8_t lwcelli_ppp_is_session(void);
+uint8_t lwcelli_ppp_channel(void);
+void lwcelli_ppp_connected(uint8_t ch, lwcell_ppp_input_fn input_fn, void* input_arg);
+void lwcelli_ppp_suspend(void);
+void lwcelli_ppp_resume(void);
+void lwcelli_ppp_closed(uint8_t is_carrier_lost);
+void lwcelli_ppp_input(const void* data, size_t len);
+size_t lwcelli_ppp_send(uint8_t ch, const void* data, size_t len);
+#endif /* LWCELL_CFG_PPP */
+
+#if LWCELL_CFG_FLOW_CONTROL
+void lwcelli_flow_enabled(uint8_t is_enabled);
+void lwcelli_flow_input(size_t written, size_t len);
+void lwcelli_flow_processed(void);
+#endif /* LWCELL_CFG_FLOW_CONTROL */
+
+#if LWCELL_CFG_LOCK_DOMAINS
+uint8_t lwcelli_lock_init(void);
+void lwcelli_mem_lock(void);
+void lwcelli_mem_unlock(void);
+#else /* LWCELL_CFG_LOCK_DOMAINS */
+#define lwcelli_mem_lock()   lwcell_core_lock()
+#define lwcelli_mem_unlock() lwcell_core_unlock()
+#endif /* !LWCELL_CFG_LOCK_DOMAINS */
+
+#if LWCELL_CFG_LOCK_STATS
+void lwcelli_lock_acquired(lwcell_lock_t lock, uint8_t is_contended, uint32_t req_time);
+void lwcelli_lock_released(lwcell_lock_t lock);
+#endif /* LWCELL_CFG_LOCK_STATS */
+
+#if LWCELL_CFG_STATE_SNAPSHOT
+void lwcelli_state_changed(void);
+void lwcelli_state_publish(void);
+#else /* LWCELL_CFG_STATE_SNAPSHOT */
+#define lwcelli_state_changed()
+#endif /* !LWCELL_CFG_STATE_SNAPSHOT */
+
+#if LWCELL_CFG_EVT_DEFER
+uint8_t lwcelli_evt_defer_init(void);
+uint8_t lwcelli_evt_defer(lwcell_evt_fn fn, lwcell_conn_t* conn);
+#if LWCELL_CFG_CONN
+uint8_t lwcelli_evt_defer_conn_pending(size_t num);
+#endif /* LWCELL_CFG_CONN */
+#endif /* LWCELL_CFG_EVT_DEFER */
+
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT
+void lwcelli_cmd_adapt_timeout(lwcell_msg_t* msg);
+void lwcelli_cmd_adapt_record(lwcell_cmd_t cmd, lwcellr_t res, uint32_t exec_time);
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT */
+
+#if LWCELL_CFG_METRICS
+/**
+ * \brief           Internal metric counters
+ * \note            Depth, maximum and full counters of each message queue must be kept in this order
+ */
+typedef enum {
+    LWCELL_METRIC_RX_BYTES,
+    LWCELL_METRIC_RX_CALLS,
+    LWCELL_METRIC_RX_CALL_MAX,
+    LWCELL_METRIC_RX_CALL_HIST,
+    LWCELL_METRIC_TX_BYTES = LWCELL_METRIC_RX_CALL_HIST + LWCELL_METRICS_RX_HIST_LEN,
+    LWCELL_METRIC_TX_CALLS,
+    LWCELL_METRIC_PRODUCER_MBOX_DEPTH,
+    LWCELL_METRIC_PRODUCER_MBOX_MAX,
+    LWCELL_METRIC_PRODUCER_MBOX_FULL,
+    LWCELL_METRIC_PROCESS_MBOX_DEPTH,
+    LWCELL_METRIC_PROCESS_MBOX_MAX,
+    LWCELL_METRIC_PROCESS_MBOX_FULL,
+    LWCELL_METRIC_IPD_IGNORED,
+    LWCELL_METRIC_IPD_SKIPPED,
+    LWCELL_METRIC_PBUF_FAILED,
+    LWCELL_METRIC_MEM_FAILED,
+    LWCELL_METRIC_CMD_COALESCED,
+    LWCELL_METRIC_CACHE_HITS,
+    LWCELL_METRIC_CMD_CANCELED,
+    LWCELL_METRIC_CMD_EXPIRED,
+    LWCELL_METRIC_END,
+} lwcell_metric_t;
+
+void lwcelli_metrics_add(lwcell_metric_t metric, uint32_t val);
+void lwcelli_metrics_rx(size_t len);
+void lwcelli_metrics_mbox_put(lwcell_metric_t depth_metric);
+#define LWCELL_METRICS_ADD(metric, val) lwcelli_metrics_add(LWCELL_METRIC_##metric, LWCELL_U32(val))
+#define LWCELL_METRICS_RX(len)          lwcelli_metrics_rx(len)
+#define LWCELL_METRICS_MBOX_PUT(mbox)   lwcelli_metrics_mbox_put(LWCELL_METRIC_##mbox##_MBOX_DEPTH)
+#define LWCELL_METRICS_MBOX_GET(mbox)   lwcelli_metrics_add(LWCELL_METRIC_##mbox##_MBOX_DEPTH, LWCELL_U32(-1))
+#else /* LWCELL_CFG_METRICS */
+#define LWCELL_METRICS_ADD(metric, val)
+#define LWCELL_METRICS_RX(len)
+#define LWCELL_METRICS_MBOX_PUT(mbox)
+#define LWCELL_METRICS_MBOX_GET(mbox)
+#endif /* !LWCELL_CFG_METRICS */
+
+#if !LWCELL_CFG_MEM_CUSTOM
+void lwcelli_mem_get_stats(size_t* total, size_t* available, size_t* min_available);
+#endif /* !LWCELL_CFG_MEM_CUSTOM */
+
+#if LWCELL_CFG_TRACE
+void lwcelli_trace(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+#define LWCELL_TRACE(id, a0, a1, a2, a3)                                                                               \
+    lwcelli_trace(LWCELL_TRACE_EVT_##id, LWCELL_U32(a0), LWCELL_U32(a1), LWCELL_U32(a2), LWCELL_U32(a3))
+#define LWCELL_TRACE_PTR(p) LWCELL_U32((uintptr_t)(p))
+#else /* LWCELL_CFG_TRACE */
+#define LWCELL_TRACE(id, a0, a1, a2, a3)
+#define LWCELL_TRACE_PTR(p)
+#endif /* !LWCELL_CFG_TRACE */
+
 /**
  * \}
  */
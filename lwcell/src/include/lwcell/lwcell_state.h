@@ -0,0 +1,86 @@
+/**
+ * \file            lwcell_state.h
+ * \brief           Modem state snapshot
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_STATE_HDR_H
+#define LWCELL_STATE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_STATE State snapshot
+ * \brief           Consistent copy of modem state for monitoring
+ * \{
+ *
+ * Library publishes new snapshot when state changed, each time core lock is released.
+ * Readers get all values from the same moment, without competing
+ * with processing thread for core lock.
+ */
+
+/**
+ * \brief           Modem state snapshot
+ */
+typedef struct {
+    uint32_t changes;                        /*!< Number of published changes, to detect updates between reads */
+    uint8_t dev_present;                     /*!< Set to `1` when device is present */
+    lwcell_device_model_t model;             /*!< Device model */
+    lwcell_sim_state_t sim_state;            /*!< SIM state */
+    lwcell_network_reg_status_t reg_status;  /*!< Network registration status */
+    int16_t rssi;                            /*!< Last known RSSI in units of dBm, `0` when not valid */
+    lwcell_operator_curr_t operator_current; /*!< Current operator */
+    uint8_t is_attached;                     /*!< Set to `1` when PDP context is active */
+    lwcell_ip_t ip;                          /*!< Device IP address when attached */
+#if LWCELL_CFG_CONN || __DOXYGEN__
+    struct {
+        uint8_t active     : 1; /*!< Connection is active */
+        uint8_t client     : 1; /*!< Connection is in client mode */
+        uint8_t in_closing : 1; /*!< Connection close is in progress */
+    } conns[LWCELL_CFG_MAX_CONNS]; /*!< Connection flags, indexed by connection number */
+#endif                             /* LWCELL_CFG_CONN || __DOXYGEN__ */
+} lwcell_state_t;
+
+lwcellr_t lwcell_state_get(lwcell_state_t* state);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_STATE_HDR_H */
@@ -42,6 +42,10 @@ extern "C" {
 
 void lwcell_thread_produce(void* const arg);
 void lwcell_thread_process(void* const arg);
+#if LWCELL_CFG_CMUX
+void lwcell_thread_produce_data(void* const arg);
+#endif /* LWCELL_CFG_CMUX */
+void lwcell_thread_loop(void* const arg);
 
 #ifdef __cplusplus
 }
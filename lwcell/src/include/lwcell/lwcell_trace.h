@@ -0,0 +1,107 @@
+/**
+ * \file            lwcell_trace.h
+ * \brief           Binary trace ring
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_TRACE_HDR_H
+#define LWCELL_TRACE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_TRACE Binary trace
+ * \brief           Low-overhead binary tracing of hot paths
+ * \{
+ *
+ * Records are written to fixed-size ring with atomic slot reservation,
+ * which makes it safe to write from producer, process and input (also interrupt) contexts.
+ * Oldest records are overwritten when ring is full.
+ *
+ * Dump stream starts with \ref LWCELL_TRACE_HDR_LEN bytes long header (`LWCT` magic, version and `3` reserved bytes),
+ * followed by records of \ref LWCELL_TRACE_REC_LEN bytes each: `32-bit` timestamp in units of milliseconds,
+ * `16-bit` event ID, `16-bit` reserved field and `4` arguments, each `32-bit` long.
+ * All fields are little-endian.
+ */
+
+#define LWCELL_TRACE_VERSION  0x01 /*!< Trace dump format version */
+#define LWCELL_TRACE_HDR_LEN  8    /*!< Length of dump header in units of bytes */
+#define LWCELL_TRACE_REC_LEN  24   /*!< Length of single record in dump stream in units of bytes */
+#define LWCELL_TRACE_ARGS_NUM 4    /*!< Number of arguments per record */
+
+/**
+ * \brief           List of trace events
+ */
+typedef enum {
+#define LWCELL_TRACE_EVT_ENTRY(name, fmt) LWCELL_TRACE_EVT_##name,
+#include "lwcell/lwcell_trace_evts.h"
+#undef LWCELL_TRACE_EVT_ENTRY
+    LWCELL_TRACE_EVT_END, /*!< Last entry, used for count */
+} lwcell_trace_evt_t;
+
+/**
+ * \brief           Single trace record
+ */
+typedef struct {
+    uint32_t time;                        /*!< Time of record in units of milliseconds */
+    uint16_t id;                          /*!< Event ID, member of \ref lwcell_trace_evt_t enumeration */
+    uint32_t args[LWCELL_TRACE_ARGS_NUM]; /*!< Event arguments */
+} lwcell_trace_rec_t;
+
+/**
+ * \brief           Trace dump output function prototype
+ * \param[in]       data: Pointer to data to write
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       arg: User argument as passed to \ref lwcell_trace_dump
+ */
+typedef void (*lwcell_trace_write_fn)(const void* data, size_t len, void* arg);
+
+size_t lwcell_trace_read(lwcell_trace_rec_t* recs, size_t max_recs);
+size_t lwcell_trace_dump(lwcell_trace_write_fn write_fn, void* arg);
+void lwcell_trace_reset(void);
+const char* lwcell_trace_evt_name(uint16_t id);
+const char* lwcell_trace_evt_fmt(uint16_t id);
+uint8_t lwcell_trace_check_header(const void* data, size_t len);
+size_t lwcell_trace_parse_record(const void* data, size_t len, lwcell_trace_rec_t* rec);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_TRACE_HDR_H */
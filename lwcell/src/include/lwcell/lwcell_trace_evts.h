@@ -0,0 +1,50 @@
+/**
+ * \file            lwcell_trace_evts.h
+ * \brief           Trace event list
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+
+/* Order: Event name; Decoder format for up to 4 arguments, all printed as 32-bit unsigned values */
+LWCELL_TRACE_EVT_ENTRY(IPD_START, "conn=%u len=%u")
+LWCELL_TRACE_EVT_ENTRY(IPD_DATA, "conn=%u copied=%u rem=%u")
+LWCELL_TRACE_EVT_ENTRY(IPD_ALLOC_FAIL, "conn=%u len=%u")
+LWCELL_TRACE_EVT_ENTRY(IPD_RECV, "conn=%u len=%u res=%u")
+LWCELL_TRACE_EVT_ENTRY(CIPSEND_START, "conn=%u len=%u rem=%u")
+LWCELL_TRACE_EVT_ENTRY(CIPSEND_SENT, "conn=%u len=%u sent_all=%u ok=%u")
+LWCELL_TRACE_EVT_ENTRY(TIMEOUT_ADD, "fn=0x%08X time=%u")
+LWCELL_TRACE_EVT_ENTRY(TIMEOUT_REMOVE, "fn=0x%08X found=%u")
+LWCELL_TRACE_EVT_ENTRY(TIMEOUT_EXPIRE, "fn=0x%08X")
+LWCELL_TRACE_EVT_ENTRY(MBOX_PRODUCER_PUT, "cmd=%u blocking=%u res=%u")
+LWCELL_TRACE_EVT_ENTRY(MBOX_PRODUCER_GET, "cmd=%u wait=%u")
+LWCELL_TRACE_EVT_ENTRY(MBOX_PROCESS_PUT, "len=%u")
+LWCELL_TRACE_EVT_ENTRY(MEM_ALLOC, "ptr=0x%08X size=%u")
+LWCELL_TRACE_EVT_ENTRY(MEM_REALLOC, "ptr=0x%08X old=0x%08X size=%u")
+LWCELL_TRACE_EVT_ENTRY(MEM_FREE, "ptr=0x%08X")
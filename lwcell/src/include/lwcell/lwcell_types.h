@@ -83,6 +83,7 @@ typedef enum {
     lwcellERRWIFINOTCONNECTED, /*!< Wifi not connected to access point */
     lwcellERRNODEVICE,         /*!< Device is not present */
     lwcellERRBLOCKING,         /*!< Blocking mode command is not allowed */
+    lwcellERRCANCELED,         /*!< Command has been cancelled before execution */
 } lwcellr_t;
 
 /**
@@ -91,12 +92,24 @@ typedef enum {
  */
 typedef enum {
 
-#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native) LWCELL_DEVICE_MODEL_##name,
+#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native, conns_max, send_max, baudrate_max)     \
+    LWCELL_DEVICE_MODEL_##name,
 #include "lwcell/lwcell_models.h"
     LWCELL_DEVICE_MODEL_END,     /*!< End of device model */
     LWCELL_DEVICE_MODEL_UNKNOWN, /*!< Unknown device model */
 } lwcell_device_model_t;
 
+/**
+ * \ingroup         LWCELL_DEVICE_INFO
+ * \brief           Device limits used at runtime, selected after device has been identified
+ */
+typedef struct {
+    size_t conns_max;      /*!< Number of connections used, up to \ref LWCELL_CFG_MAX_CONNS */
+    size_t send_max;       /*!< Maximal number of bytes in single send command,
+                                up to \ref LWCELL_CFG_CONN_MAX_DATA_LEN */
+    uint32_t baudrate_max; /*!< Maximal AT port baudrate. `0` when unknown */
+} lwcell_device_limits_t;
+
 /**
  * \ingroup         LWCELL_SIM
  * \brief           SIM state
@@ -391,6 +404,9 @@ typedef enum lwcell_cb_type_t {
     LWCELL_EVT_NETWORK_ATTACHED, /*!< Attached to network, PDP context active and ready for TCP/IP application */
     LWCELL_EVT_NETWORK_DETACHED, /*!< Detached from network, PDP context not active anymore */
 #endif                           /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+    LWCELL_EVT_PPP_DISCONNECTED, /*!< PPP session ended by device, data mode has been left */
+#endif                           /* LWCELL_CFG_PPP || __DOXYGEN__ */
 
 #if LWCELL_CFG_CONN || __DOXYGEN__
     LWCELL_EVT_CONN_RECV,   /*!< Connection data received */
@@ -423,8 +439,17 @@ typedef enum lwcell_cb_type_t {
     LWCELL_EVT_PB_LIST,   /*!< Phonebook list event */
     LWCELL_EVT_PB_SEARCH, /*!< Phonebook search event */
 #endif                    /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
+
+    LWCELL_EVT_END, /*!< Last element, number of event types. Not an event itself */
 } lwcell_evt_type_t;
 
+/**
+ * \ingroup         LWCELL_EVT
+ * \brief           Event subscription mask, one bit per \ref lwcell_evt_type_t
+ * \sa              LWCELL_EVT_MASK
+ */
+typedef uint64_t lwcell_evt_mask_t;
+
 /**
  * \ingroup         LWCELL_EVT
  * \brief           Global callback structure to pass as parameter to callback function
@@ -580,6 +605,14 @@ typedef size_t (*lwcell_ll_send_fn)(const void* data, size_t len);
  */
 typedef uint8_t (*lwcell_ll_reset_fn)(uint8_t state);
 
+/**
+ * \ingroup         LWCELL_LL
+ * \brief           Function prototype to control RTS line towards GSM device
+ * \note            Function may be called from interrupt context, when \ref lwcell_input is called from it
+ * \param[in]       ready: Set to `1` when device may send data, or `0` to pause it
+ */
+typedef void (*lwcell_ll_rts_fn)(uint8_t ready);
+
 /**
  * \ingroup         LWCELL_LL
  * \brief           Low level user specific functions
@@ -587,10 +620,13 @@ typedef uint8_t (*lwcell_ll_reset_fn)(uint8_t state);
 typedef struct {
     lwcell_ll_send_fn send_fn;   /*!< Callback function to transmit data */
     lwcell_ll_reset_fn reset_fn; /*!< Reset callback function */
+    lwcell_ll_rts_fn rts_fn;     /*!< RTS control callback function, `NULL` when not used */
 
     struct {
-        uint32_t baudrate; /*!< UART baudrate value */
-    } uart;                /*!< UART communication parameters */
+        uint32_t baudrate;    /*!< UART baudrate value */
+        uint8_t flow_control; /*!< Set to `1` by low-level when RTS/CTS lines are connected
+                                    and transmit is paused by CTS line */
+    } uart;                   /*!< UART communication parameters */
 } lwcell_ll_t;
 
 /**
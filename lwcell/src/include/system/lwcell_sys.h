@@ -168,6 +168,16 @@ uint32_t lwcell_sys_now(void);
  */
 uint8_t lwcell_sys_protect(void);
 
+/**
+ * \brief           Try to protect middleware core without waiting
+ *
+ * Same as \ref lwcell_sys_protect, but returns immediately when other thread holds protection.
+ *
+ * \note            Used only with \ref LWCELL_CFG_LOCK_STATS enabled, to detect lock contention
+ * \return          `1` if protection has been granted, `0` otherwise
+ */
+uint8_t lwcell_sys_protect_try(void);
+
 /**
  * \brief           Unprotect middleware core
  *
@@ -183,6 +193,8 @@ uint8_t lwcell_sys_unprotect(void);
  * \}
  */
 
+#if LWCELL_CFG_OS || __DOXYGEN__
+
 /**
  * \anchor          LWCELL_SYS_MUTEX
  * \name            Mutex
@@ -210,6 +222,13 @@ uint8_t lwcell_sys_mutex_delete(lwcell_sys_mutex_t* p);
  */
 uint8_t lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p);
 
+/**
+ * \brief           Lock recursive mutex, return immediately when it is held by other thread
+ * \param[in]       p: Pointer to mutex structure
+ * \return          `1` if mutex has been locked, `0` otherwise
+ */
+uint8_t lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p);
+
 /**
  * \brief           Unlock recursive mutex
  * \param[in]       p: Pointer to mutex structure
@@ -401,6 +420,8 @@ uint8_t lwcell_sys_thread_yield(void);
  * \}
  */
 
+#endif /* LWCELL_CFG_OS || __DOXYGEN__ */
+
 /**
  * \}
  */
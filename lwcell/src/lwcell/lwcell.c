@@ -37,10 +37,6 @@
 #include "lwcell/lwcell_timeout.h"
 #include "system/lwcell_ll.h"
 
-#if LWCELL_CFG_OS != 1
-#error LWCELL_CFG_OS must be set to 1!
-#endif
-
 static lwcellr_t prv_def_callback(lwcell_evt_t* cb);
 static lwcell_evt_func_t def_evt_link;
 
@@ -57,6 +53,42 @@ prv_def_callback(lwcell_evt_t* evt) {
     return lwcellOK;
 }
 
+/**
+ * \brief           Send reset sequence message
+ * \param[in]       delay: Number of milliseconds to wait before initiating first command to device.
+ *                      Ignored for warm start
+ * \param[in]       warm: Set to `1` to skip device reset if it kept expected settings.
+ *                      Used only when \ref LWCELL_CFG_RESET_WARM_START is enabled
+ * \param[in]       evt_fn: Callback function called when command is finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_reset(uint32_t delay, uint8_t warm, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+          const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_RESET;
+    LWCELL_MSG_VAR_REF(msg).msg.reset.delay = delay;
+#if LWCELL_CFG_RESET_WARM_START
+    LWCELL_MSG_VAR_REF(msg).msg.reset.warm = warm;
+    if (warm) {
+        LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_RESET_WARM_CHECK; /* Check settings before resetting device */
+        LWCELL_MSG_VAR_REF(msg).msg.reset.delay = 0; /* Device is already running, no start-up delay */
+    }
+#else  /* LWCELL_CFG_RESET_WARM_START */
+    LWCELL_UNUSED(warm);
+#endif /* !LWCELL_CFG_RESET_WARM_START */
+#if LWCELL_CFG_RESET_PROBE
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_RESET_PROBE; /* Wait until device accepts commands */
+#endif                                                    /* LWCELL_CFG_RESET_PROBE */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
 #if LWCELL_CFG_KEEP_ALIVE
 
 /**
@@ -80,6 +112,7 @@ prv_keep_alive_timeout_fn(void* arg) {
  *                  It creates necessary threads and waits them to start, thus running operating system is important.
  *                  - When \ref LWCELL_CFG_RESET_ON_INIT is enabled, reset sequence will be sent to device
  *                      otherwise manual call to \ref lwcell_reset is required to setup device
+ *                  - When \ref LWCELL_CFG_OS is disabled, no threads are created and `blocking` must be `0`
  *
  * \param[in]       evt_func: Global event callback function for all major events
  * \param[in]       blocking: Status whether command should be blocking or not.
@@ -94,12 +127,27 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
 
     def_evt_link.fn = evt_func != NULL ? evt_func : prv_def_callback;
     lwcell.evt_func = &def_evt_link; /* Set callback function */
+#if LWCELL_CFG_EVT_MASK
+    def_evt_link.mask = LWCELL_EVT_MASK_ALL;
+    lwcell.evt_disp = NULL; /* Walk the list until first registration builds the table */
+#endif                      /* LWCELL_CFG_EVT_MASK */
 
     if (!lwcell_sys_init()) { /* Init low-level system */
         goto cleanup;
     }
+#if LWCELL_CFG_LOCK_DOMAINS
+    if (!lwcelli_lock_init()) {
+        goto cleanup;
+    }
+#endif /* LWCELL_CFG_LOCK_DOMAINS */
 
+#if LWCELL_CFG_OS
+#if LWCELL_CFG_SINGLE_THREAD
+    /* Semaphore is only used to wait for loop thread to start */
+    if (LWCELL_CFG_LOOP_THREAD && !lwcell_sys_sem_create(&lwcell.sem_sync, 0)) {
+#else  /* LWCELL_CFG_SINGLE_THREAD */
     if (!lwcell_sys_sem_create(&lwcell.sem_sync, 1)) { /* Create sync semaphore between threads */
+#endif /* !LWCELL_CFG_SINGLE_THREAD */
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot allocate sync semaphore!\r\n");
         goto cleanup;
@@ -111,13 +159,27 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
                      "[LWCELL CORE] Cannot allocate producer mbox queue!\r\n");
         goto cleanup;
     }
-    if (!lwcell_sys_mbox_create(&lwcell.mbox_process, LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE)) {
+    if ((!LWCELL_CFG_SINGLE_THREAD || LWCELL_CFG_LOOP_THREAD)
+        && !lwcell_sys_mbox_create(&lwcell.mbox_process, LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE)) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot allocate process mbox queue!\r\n");
         goto cleanup;
     }
 
     /* Create threads */
+#if LWCELL_CFG_SINGLE_THREAD
+#if LWCELL_CFG_LOOP_THREAD
+    if (!lwcell_sys_thread_create(&lwcell.thread_process, "lwcell_loop", lwcell_thread_loop, &lwcell.sem_sync,
+                                  LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL CORE] Cannot create loop thread!\r\n");
+        goto cleanup;
+    }
+    lwcell_sys_sem_wait(&lwcell.sem_sync, 0); /* Wait semaphore, should be unlocked in loop thread */
+    lwcell_sys_sem_delete(&lwcell.sem_sync);
+    lwcell_sys_sem_invalid(&lwcell.sem_sync);
+#endif /* LWCELL_CFG_LOOP_THREAD */
+#else  /* LWCELL_CFG_SINGLE_THREAD */
     lwcell_sys_sem_wait(&lwcell.sem_sync, 0);
     if (!lwcell_sys_thread_create(&lwcell.thread_produce, "lwcell_produce", lwcell_thread_produce, &lwcell.sem_sync,
                                  LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
@@ -135,8 +197,32 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
         lwcell_sys_sem_release(&lwcell.sem_sync);            /* Release semaphore and return */
         goto cleanup;
     }
-    lwcell_sys_sem_wait(&lwcell.sem_sync, 0); /* Wait semaphore, should be unlocked in produce thread */
-    lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore manually */
+    lwcell_sys_sem_wait(&lwcell.sem_sync, 0); /* Wait semaphore, should be unlocked in process thread */
+    /* Semaphore stays locked, it is released by process thread only when command finishes */
+#if LWCELL_CFG_CMUX
+    if (!lwcell_sys_sem_create(&lwcell.sem_sync_data, 1)
+        || !lwcell_sys_mbox_create(&lwcell.mbox_data, LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL CORE] Cannot allocate multiplexer data channel resources!\r\n");
+        goto cleanup;
+    }
+    lwcell_sys_sem_wait(&lwcell.sem_sync_data, 0);
+    if (!lwcell_sys_thread_create(&lwcell.thread_data, "lwcell_produce_data", lwcell_thread_produce_data,
+                                  &lwcell.sem_sync_data, LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL CORE] Cannot create data channel producing thread!\r\n");
+        lwcell_sys_sem_release(&lwcell.sem_sync_data);
+        goto cleanup;
+    }
+    lwcell_sys_sem_wait(&lwcell.sem_sync_data, 0); /* Wait semaphore, should be unlocked in data thread */
+#endif /* LWCELL_CFG_CMUX */
+#endif /* !LWCELL_CFG_SINGLE_THREAD */
+#if LWCELL_CFG_EVT_DEFER
+    if (!lwcelli_evt_defer_init()) {
+        goto cleanup;
+    }
+#endif /* LWCELL_CFG_EVT_DEFER */
+#endif /* LWCELL_CFG_OS */
 
     lwcell_core_lock();
     lwcell.ll.uart.baudrate = LWCELL_CFG_AT_PORT_BAUDRATE;
@@ -148,6 +234,7 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
 
     lwcell.status.f.initialized = 1; /* We are initialized now */
     lwcell.status.f.dev_present = 1; /* We assume device is present at this point */
+    lwcelli_state_changed();
 
     lwcelli_send_cb(LWCELL_EVT_INIT_FINISH); /* Call user callback function */
 
@@ -163,8 +250,8 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
 #if LWCELL_CFG_RESET_ON_INIT
     if (lwcell.status.f.dev_present) {
         lwcell_core_unlock();
-        res = lwcell_reset_with_delay(LWCELL_CFG_RESET_DELAY_DEFAULT, NULL, NULL,
-                                     blocking); /* Send reset sequence with delay */
+        res = prv_reset(LWCELL_CFG_RESET_DELAY_DEFAULT, LWCELL_CFG_RESET_WARM_START, NULL, NULL,
+                        blocking); /* Send reset sequence with delay */
         lwcell_core_lock();
     }
 #else  /* LWCELL_CFG_RESET_ON_INIT */
@@ -175,6 +262,7 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
     return res;
 
 cleanup:
+#if LWCELL_CFG_OS
     if (lwcell_sys_mbox_isvalid(&lwcell.mbox_producer)) {
         lwcell_sys_mbox_delete(&lwcell.mbox_producer);
         lwcell_sys_mbox_invalid(&lwcell.mbox_producer);
@@ -187,6 +275,17 @@ cleanup:
         lwcell_sys_sem_delete(&lwcell.sem_sync);
         lwcell_sys_sem_invalid(&lwcell.sem_sync);
     }
+#if LWCELL_CFG_CMUX
+    if (lwcell_sys_mbox_isvalid(&lwcell.mbox_data)) {
+        lwcell_sys_mbox_delete(&lwcell.mbox_data);
+        lwcell_sys_mbox_invalid(&lwcell.mbox_data);
+    }
+    if (lwcell_sys_sem_isvalid(&lwcell.sem_sync_data)) {
+        lwcell_sys_sem_delete(&lwcell.sem_sync_data);
+        lwcell_sys_sem_invalid(&lwcell.sem_sync_data);
+    }
+#endif /* LWCELL_CFG_CMUX */
+#endif /* LWCELL_CFG_OS */
     return lwcellERRMEM;
 }
 
@@ -213,14 +312,7 @@ lwcell_reset(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint
 lwcellr_t
 lwcell_reset_with_delay(uint32_t delay, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
                        const uint32_t blocking) {
-    LWCELL_MSG_VAR_DEFINE(msg);
-
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
-    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
-    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_RESET;
-    LWCELL_MSG_VAR_REF(msg).msg.reset.delay = delay;
-
-    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+    return prv_reset(delay, 0, evt_fn, evt_arg, blocking);
 }
 
 /**
@@ -235,8 +327,23 @@ lwcell_reset_with_delay(uint32_t delay, const lwcell_api_cmd_evt_fn evt_fn, void
  */
 lwcellr_t
 lwcell_core_lock(void) {
+#if LWCELL_CFG_LOCK_STATS
+    uint32_t req_time = LWCELL_LOCK_STATS_TIME();
+    uint8_t is_contended = 0;
+
+    if (!lwcell_sys_protect_try()) {
+        is_contended = 1; /* Held by other thread, wait for it */
+        lwcell_sys_protect();
+    }
+#else  /* LWCELL_CFG_LOCK_STATS */
     lwcell_sys_protect();
+#endif /* !LWCELL_CFG_LOCK_STATS */
     ++lwcell.locked_cnt;
+#if LWCELL_CFG_LOCK_STATS
+    if (lwcell.locked_cnt == 1) {
+        lwcelli_lock_acquired(LWCELL_LOCK_CORE, is_contended, req_time);
+    }
+#endif /* LWCELL_CFG_LOCK_STATS */
     return lwcellOK;
 }
 
@@ -252,6 +359,16 @@ lwcell_core_lock(void) {
  */
 lwcellr_t
 lwcell_core_unlock(void) {
+#if LWCELL_CFG_STATE_SNAPSHOT
+    if (lwcell.locked_cnt == 1) {
+        lwcelli_state_publish(); /* Publish changes before other threads get access */
+    }
+#endif /* LWCELL_CFG_STATE_SNAPSHOT */
+#if LWCELL_CFG_LOCK_STATS
+    if (lwcell.locked_cnt == 1) {
+        lwcelli_lock_released(LWCELL_LOCK_CORE);
+    }
+#endif /* LWCELL_CFG_LOCK_STATS */
     --lwcell.locked_cnt;
     lwcell_sys_unprotect();
     return lwcellOK;
@@ -264,11 +381,15 @@ lwcell_core_unlock(void) {
  * It locks semaphore and waits for timeout in `ms` time.
  * Based on operating system, thread may be put to \e blocked list during delay and may improve execution speed
  *
+ * \note            When \ref LWCELL_CFG_OS is disabled, function busy-waits using \ref lwcell_sys_now.
+ *                  Stack does not use it in this mode, delays of command sequences are timeouts
+ *
  * \param[in]       ms: Milliseconds to delay
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
 lwcell_delay(uint32_t ms) {
+#if LWCELL_CFG_OS
     lwcell_sys_sem_t sem;
     if (ms == 0) {
         return 1;
@@ -280,6 +401,11 @@ lwcell_delay(uint32_t ms) {
         return 1;
     }
     return 0;
+#else  /* LWCELL_CFG_OS */
+    uint32_t start = lwcell_sys_now();
+    while ((lwcell_sys_now() - start) < ms) {}
+    return 1;
+#endif /* !LWCELL_CFG_OS */
 }
 
 /**
@@ -323,6 +449,7 @@ lwcell_device_set_present(uint8_t present, const lwcell_api_cmd_evt_fn evt_fn, v
     present = present ? 1 : 0;
     if (present != lwcell.status.f.dev_present) {
         lwcell.status.f.dev_present = present;
+        lwcelli_state_changed();
 
         if (!lwcell.status.f.dev_present) {
             /* Manually reset stack to default device state */
@@ -330,8 +457,8 @@ lwcell_device_set_present(uint8_t present, const lwcell_api_cmd_evt_fn evt_fn, v
         } else {
 #if LWCELL_CFG_RESET_ON_DEVICE_PRESENT
             lwcell_core_unlock();
-            res =
-                lwcell_reset_with_delay(LWCELL_CFG_RESET_DELAY_DEFAULT, evt_fn, evt_arg, blocking); /* Reset with delay */
+            res = prv_reset(LWCELL_CFG_RESET_DELAY_DEFAULT, LWCELL_CFG_RESET_WARM_START, evt_fn, evt_arg,
+                            blocking); /* Reset with delay */
             lwcell_core_lock();
 #endif /* LWCELL_CFG_RESET_ON_DEVICE_PRESENT */
         }
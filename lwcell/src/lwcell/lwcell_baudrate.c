@@ -0,0 +1,238 @@
+/**
+ * \file            lwcell_baudrate.c
+ * \brief           AT port baudrate negotiation
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_baudrate.h"
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_ll.h"
+
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE || __DOXYGEN__
+
+/**
+ * \brief           Best working baudrate of device model
+ */
+typedef struct {
+    char model[sizeof(lwcell.m.model_number)]; /*!< Device model, empty when entry is not used */
+    uint32_t baudrate;                         /*!< Best working baudrate */
+} lwcell_baudrate_model_t;
+
+static const uint32_t baudrates[] = {LWCELL_CFG_AT_BAUDRATE_LIST}; /*!< Candidates in ascending order */
+static lwcell_baudrate_model_t models[LWCELL_CFG_AT_BAUDRATE_MODELS]; /*!< Remembered device models */
+static size_t models_next;                 /*!< Entry to replace when table is full */
+static lwcell_baudrate_stats_t baud_stats; /*!< Negotiation statistics */
+static uint32_t last_good;                 /*!< Last verified baudrate of active negotiation */
+static uint8_t is_direct;                  /*!< Set to `1` when switching directly to remembered baudrate */
+
+/**
+ * \brief           Get remembered entry for current device model
+ * \param[in]       create: Set to `1` to assign new entry if model has none yet
+ * \return          Entry handle or `NULL` if not found
+ */
+static lwcell_baudrate_model_t*
+prv_model(uint8_t create) {
+    lwcell_baudrate_model_t* m;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(models); ++i) {
+        if (models[i].model[0] != '\0' && !strcmp(models[i].model, lwcell.m.model_number)) {
+            return &models[i];
+        }
+    }
+    if (!create || lwcell.m.model_number[0] == '\0') {
+        return NULL;
+    }
+    m = &models[models_next];
+    models_next = (models_next + 1) % LWCELL_ARRAYSIZE(models);
+    LWCELL_MEMSET(m, 0x00, sizeof(*m));
+    strcpy(m->model, lwcell.m.model_number);
+    return m;
+}
+
+/**
+ * \brief           Get next candidate baudrate above rate
+ * \note            Candidates above maximal baudrate of device model are skipped
+ * \param[in]       rate: Current baudrate
+ * \return          Next candidate or `0` if there is none
+ */
+static uint32_t
+prv_next(uint32_t rate) {
+    uint32_t max = lwcell.m.limits.baudrate_max;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(baudrates); ++i) {
+        if (baudrates[i] > rate) {
+            return (max == 0 || baudrates[i] <= max) ? baudrates[i] : 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Finish negotiation and remember best working baudrate
+ * \return          `0` to indicate there is no further baudrate to try
+ */
+static uint32_t
+prv_finish(void) {
+    lwcell_baudrate_model_t* m = prv_model(1);
+
+    if (m != NULL) {
+        m->baudrate = last_good;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Set AT port baudrate and reconfigure low-level part
+ * \note            Function must be called with core locked
+ * \param[in]       rate: New baudrate
+ */
+void
+lwcelli_baudrate_set(uint32_t rate) {
+    if (lwcell.ll.uart.baudrate != rate) {
+        lwcell.ll.uart.baudrate = rate;
+        lwcell_ll_init(&lwcell.ll);
+    }
+}
+
+/**
+ * \brief           Start negotiation after device has been identified
+ * \note            Function must be called with core locked
+ * \return          First baudrate to try or `0` if current baudrate shall be kept
+ */
+uint32_t
+lwcelli_baudrate_start(void) {
+    const lwcell_baudrate_model_t* m = prv_model(0);
+
+    last_good = lwcell.ll.uart.baudrate;
+    is_direct = m != NULL;
+    if (is_direct && m->baudrate <= last_good) {
+        return 0; /* Nothing better is known to work */
+    }
+    ++baud_stats.negotiations;
+    return is_direct ? m->baudrate : prv_next(last_good);
+}
+
+/**
+ * \brief           Baudrate has been verified
+ * \note            Function must be called with core locked
+ * \param[in]       rate: Verified baudrate
+ * \param[in]       is_fallback: Set to `1` when rate is result of fallback
+ * \return          Next baudrate to try or `0` when negotiation is finished
+ */
+uint32_t
+lwcelli_baudrate_verified(uint32_t rate, uint8_t is_fallback) {
+    last_good = rate;
+    if (!is_fallback) {
+        ++baud_stats.steps;
+    }
+    if (is_fallback || is_direct || prv_next(rate) == 0) {
+        return prv_finish();
+    }
+    return prv_next(rate);
+}
+
+/**
+ * \brief           Baudrate verification failed
+ * \note            Function must be called with core locked
+ * \param[in]       rate: Failed baudrate
+ * \return          Last working baudrate to fall back to
+ */
+uint32_t
+lwcelli_baudrate_failed(uint32_t rate) {
+    LWCELL_UNUSED(rate);
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                  "[LWCELL BAUDRATE] Baudrate %lu failed, falling back to %lu\r\n", (unsigned long)rate,
+                  (unsigned long)last_good);
+    ++baud_stats.errors;
+    ++baud_stats.fallbacks;
+    is_direct = 0;
+    return last_good;
+}
+
+/**
+ * \brief           Get candidate baudrate to scan for device which kept baudrate from before host restart
+ * \note            Function must be called with core locked
+ * \param[in]       idx: Candidate index, starting with `0`
+ * \return          Candidate baudrate or `0` when all candidates were tried
+ */
+uint32_t
+lwcelli_baudrate_candidate(size_t idx) {
+    if (idx >= LWCELL_ARRAYSIZE(baudrates)) {
+        return 0;
+    }
+    if (idx == 0) {
+        ++baud_stats.scans;
+    }
+    return baudrates[idx];
+}
+
+/**
+ * \brief           Device responded at candidate baudrate during scan
+ * \note            Function must be called with core locked
+ * \param[in]       rate: Baudrate device responded at
+ */
+void
+lwcelli_baudrate_found(uint32_t rate) {
+    LWCELL_UNUSED(rate);
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                  "[LWCELL BAUDRATE] Device found at %lu, returning it to default baudrate\r\n", (unsigned long)rate);
+    ++baud_stats.recoveries;
+}
+
+/**
+ * \brief           Get baudrate negotiation statistics
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_baudrate_get_stats(lwcell_baudrate_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    *stats = baud_stats;
+    stats->baudrate = lwcell.ll.uart.baudrate;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Forget best working baudrates of all device models
+ *
+ * Next reset sequence steps through all candidates again
+ */
+void
+lwcell_baudrate_forget(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(models, 0x00, sizeof(models));
+    models_next = 0;
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE || __DOXYGEN__ */
@@ -0,0 +1,159 @@
+/**
+ * \file            lwcell_cache.c
+ * \brief           Response cache of slow-changing device state
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cache.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Copy cached string to device info output
+ * \param[in]       msg: Query message
+ * \param[in]       str: Cached string
+ * \param[in]       size: Size of cached string array
+ */
+static void
+prv_copy_device_info(lwcell_msg_t* msg, const char* str, size_t size) {
+    size_t tocopy = LWCELL_MIN(size, msg->msg.device_info.len);
+
+    LWCELL_MEMCPY(msg->msg.device_info.str, str, tocopy);
+    msg->msg.device_info.str[tocopy - 1] = 0;
+}
+
+/**
+ * \brief           Mark cached value as fresh
+ * \note            Function must be called with core locked, after value has been saved to global state
+ * \param[in]       entry: Cache entry
+ */
+void
+lwcelli_cache_set(lwcell_cache_entry_t entry) {
+    lwcell.m.cache[entry].time = lwcell_sys_now();
+    lwcell.m.cache[entry].valid = 1;
+}
+
+/**
+ * \brief           Invalidate cached value
+ * \note            Function must be called with core locked
+ * \param[in]       entry: Cache entry
+ */
+void
+lwcelli_cache_invalidate(lwcell_cache_entry_t entry) {
+    lwcell.m.cache[entry].valid = 0;
+}
+
+/**
+ * \brief           Answer query message with cached value
+ *
+ * When value is fresh, it is copied to message output and command callback is called
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Query message, not yet put to producer queue
+ * \return          `1` if message has been answered and must be released, `0` otherwise
+ */
+uint8_t
+lwcelli_cache_answer(lwcell_msg_t* msg) {
+    lwcell_cache_entry_t entry;
+    uint32_t ttl;
+
+    switch (msg->cmd_def) {
+        case LWCELL_CMD_CGMI_GET: entry = LWCELL_CACHE_MANUFACTURER; break;
+        case LWCELL_CMD_CGMM_GET: entry = LWCELL_CACHE_MODEL; break;
+        case LWCELL_CMD_CGSN_GET: entry = LWCELL_CACHE_SERIAL_NUMBER; break;
+        case LWCELL_CMD_CGMR_GET: entry = LWCELL_CACHE_REVISION; break;
+        case LWCELL_CMD_COPS_GET: entry = LWCELL_CACHE_OPERATOR; break;
+        case LWCELL_CMD_CSQ_GET: entry = LWCELL_CACHE_RSSI; break;
+        default: return 0;
+    }
+    if (entry == LWCELL_CACHE_OPERATOR) {
+        ttl = LWCELL_CFG_CACHE_TTL_OPERATOR;
+    } else if (entry == LWCELL_CACHE_RSSI) {
+        ttl = LWCELL_CFG_CACHE_TTL_RSSI;
+    } else {
+        ttl = LWCELL_CFG_CACHE_TTL_DEVICE_INFO;
+    }
+    if (!lwcell.m.cache[entry].valid
+        || (ttl != LWCELL_CACHE_TTL_FOREVER && (lwcell_sys_now() - lwcell.m.cache[entry].time) >= ttl)) {
+        return 0;
+    }
+
+    /* Copy value to user the same way as parser does */
+    switch (entry) {
+        case LWCELL_CACHE_MANUFACTURER:
+            prv_copy_device_info(msg, lwcell.m.model_manufacturer, sizeof(lwcell.m.model_manufacturer));
+            break;
+        case LWCELL_CACHE_MODEL:
+            prv_copy_device_info(msg, lwcell.m.model_number, sizeof(lwcell.m.model_number));
+            break;
+        case LWCELL_CACHE_SERIAL_NUMBER:
+            prv_copy_device_info(msg, lwcell.m.model_serial_number, sizeof(lwcell.m.model_serial_number));
+            break;
+        case LWCELL_CACHE_REVISION:
+            prv_copy_device_info(msg, lwcell.m.model_revision, sizeof(lwcell.m.model_revision));
+            break;
+        case LWCELL_CACHE_OPERATOR:
+            if (msg->msg.cops_get.curr != NULL) {
+                LWCELL_MEMCPY(msg->msg.cops_get.curr, &lwcell.m.network.curr_operator,
+                              sizeof(*msg->msg.cops_get.curr));
+            }
+            break;
+        case LWCELL_CACHE_RSSI:
+            if (msg->msg.csq.rssi != NULL) {
+                *msg->msg.csq.rssi = lwcell.m.rssi;
+            }
+            break;
+        default: break;
+    }
+    LWCELL_METRICS_ADD(CACHE_HITS, 1);
+#if LWCELL_CFG_USE_API_FUNC_EVT
+    if (msg->evt_fn != NULL) {
+        msg->evt_fn(lwcellOK, msg->evt_arg);
+    }
+#endif /* LWCELL_CFG_USE_API_FUNC_EVT */
+    return 1;
+}
+
+/**
+ * \brief           Invalidate all cached values
+ *
+ * Next query of every value is sent to device
+ */
+void
+lwcell_cache_invalidate(void) {
+    lwcell_core_lock();
+    for (size_t i = 0; i < LWCELL_CACHE_END; ++i) {
+        lwcelli_cache_invalidate((lwcell_cache_entry_t)i);
+    }
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_CACHE || __DOXYGEN__ */
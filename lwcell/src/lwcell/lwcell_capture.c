@@ -0,0 +1,152 @@
+/**
+ * \file            lwcell_capture.c
+ * \brief           AT traffic capture
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_capture.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CAPTURE || __DOXYGEN__
+
+static lwcell_capture_write_fn capture_write_fn; /*!< Capture output function, `NULL` when capture is stopped */
+static void* capture_arg;                        /*!< User argument for output function */
+
+/**
+ * \brief           Start capturing AT traffic
+ *
+ * Stream header is written immediately, followed by records for each RX or TX data chunk
+ *
+ * \param[in]       write_fn: Output function to write capture stream to
+ * \param[in]       arg: User argument passed to output function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_capture_start(lwcell_capture_write_fn write_fn, void* arg) {
+    uint8_t hdr[LWCELL_CAPTURE_HDR_LEN] = {'L', 'W', 'C', 'C', LWCELL_CAPTURE_VERSION, 0, 0, 0};
+
+    LWCELL_ASSERT(write_fn != NULL);
+
+    lwcell_core_lock();
+    capture_write_fn = write_fn;
+    capture_arg = arg;
+    capture_write_fn(hdr, sizeof(hdr), capture_arg);
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Stop capturing AT traffic
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_capture_stop(void) {
+    lwcell_core_lock();
+    capture_write_fn = NULL;
+    capture_arg = NULL;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Check if data start with valid capture stream header
+ * \param[in]       data: Pointer to stream data
+ * \param[in]       len: Length of data in units of bytes
+ * \return          `1` if header is valid, `0` otherwise
+ */
+uint8_t
+lwcell_capture_check_header(const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    return len >= LWCELL_CAPTURE_HDR_LEN && d[0] == 'L' && d[1] == 'W' && d[2] == 'C' && d[3] == 'C'
+           && d[4] == LWCELL_CAPTURE_VERSION;
+}
+
+/**
+ * \brief           Parse single record from capture stream
+ * \param[in]       data: Pointer to stream data, starting at record header
+ * \param[in]       len: Length of available data in units of bytes
+ * \param[out]      rec: Output record, its data pointer points to input memory
+ * \return          Number of bytes consumed by record or `0` if data do not contain full record
+ */
+size_t
+lwcell_capture_parse_record(const void* data, size_t len, lwcell_capture_record_t* rec) {
+    const uint8_t* d = data;
+    uint16_t dl;
+
+    LWCELL_ASSERT0(data != NULL);
+    LWCELL_ASSERT0(rec != NULL);
+
+    if (len < LWCELL_CAPTURE_REC_HDR_LEN) {
+        return 0;
+    }
+    dl = LWCELL_U16(d[4] | (d[5] << 8));
+    if (len < (size_t)(LWCELL_CAPTURE_REC_HDR_LEN + (dl & LWCELL_CAPTURE_REC_MAX_LEN))) {
+        return 0;
+    }
+    rec->time = (uint32_t)d[0] | ((uint32_t)d[1] << 8) | ((uint32_t)d[2] << 16) | ((uint32_t)d[3] << 24);
+    rec->dir = (dl & 0x8000) ? LWCELL_CAPTURE_DIR_TX : LWCELL_CAPTURE_DIR_RX;
+    rec->len = dl & LWCELL_CAPTURE_REC_MAX_LEN;
+    rec->data = &d[LWCELL_CAPTURE_REC_HDR_LEN];
+    return LWCELL_CAPTURE_REC_HDR_LEN + rec->len;
+}
+
+/**
+ * \brief           Write data chunk to capture output
+ * \note            Function must be called with core locked
+ * \param[in]       dir: Data direction
+ * \param[in]       data: Pointer to data
+ * \param[in]       len: Length of data in units of bytes
+ */
+void
+lwcelli_capture(lwcell_capture_dir_t dir, const void* data, size_t len) {
+    const uint8_t* d = data;
+    uint8_t hdr[LWCELL_CAPTURE_REC_HDR_LEN];
+    uint32_t time;
+    size_t l;
+
+    if (capture_write_fn == NULL || data == NULL) {
+        return;
+    }
+    time = lwcell_sys_now();
+    for (; len > 0; len -= l, d += l) {
+        l = LWCELL_MIN(len, LWCELL_CAPTURE_REC_MAX_LEN);
+        hdr[0] = LWCELL_U8(time);
+        hdr[1] = LWCELL_U8(time >> 8);
+        hdr[2] = LWCELL_U8(time >> 16);
+        hdr[3] = LWCELL_U8(time >> 24);
+        hdr[4] = LWCELL_U8(l);
+        hdr[5] = LWCELL_U8((l >> 8) | (dir == LWCELL_CAPTURE_DIR_TX ? 0x80 : 0x00));
+        capture_write_fn(hdr, sizeof(hdr), capture_arg);
+        capture_write_fn(d, l, capture_arg);
+    }
+}
+
+#endif /* LWCELL_CFG_CAPTURE || __DOXYGEN__ */
@@ -0,0 +1,231 @@
+/**
+ * \file            lwcell_cmd_adapt.c
+ * \brief           Adaptive command timeouts
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmd_adapt.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT || __DOXYGEN__
+
+/**
+ * \brief           Latency history for single command
+ */
+typedef struct {
+    lwcell_cmd_t cmd;                               /*!< Command ID */
+    uint32_t samples[LWCELL_CFG_CMD_ADAPT_SAMPLES]; /*!< Ring buffer of execution times */
+    size_t pos;                                     /*!< Position for next sample */
+    size_t cnt;                                     /*!< Number of valid samples */
+    uint32_t timeouts;                              /*!< Number of executions finished on adapted timeout */
+} lwcell_cmd_adapt_t;
+
+static lwcell_cmd_adapt_t cmd_adapt[LWCELL_CFG_CMD_ADAPT_ENTRIES]; /*!< Latency history entries */
+static size_t cmd_adapt_cnt;                                       /*!< Number of used entries */
+
+/**
+ * \brief           Find history entry for command
+ * \param[in]       cmd: Command ID
+ * \param[in]       create: Set to `1` to assign new entry if command has none yet
+ * \return          Entry handle or `NULL` if not found
+ */
+static lwcell_cmd_adapt_t*
+prv_find(lwcell_cmd_t cmd, uint8_t create) {
+    for (size_t i = 0; i < cmd_adapt_cnt; ++i) {
+        if (cmd_adapt[i].cmd == cmd) {
+            return &cmd_adapt[i];
+        }
+    }
+    if (!create || cmd_adapt_cnt >= LWCELL_ARRAYSIZE(cmd_adapt)) {
+        return NULL;
+    }
+    cmd_adapt[cmd_adapt_cnt].cmd = cmd;
+    return &cmd_adapt[cmd_adapt_cnt++];
+}
+
+/**
+ * \brief           Calculate percentiles of recorded samples
+ * \param[in]       e: History entry with at least one sample
+ * \param[out]      p50: Median
+ * \param[out]      p99: 99th percentile
+ */
+static void
+prv_percentiles(const lwcell_cmd_adapt_t* e, uint32_t* p50, uint32_t* p99) {
+    uint32_t sorted[LWCELL_CFG_CMD_ADAPT_SAMPLES], v;
+    size_t i, j;
+
+    /* Insertion sort, number of samples is small */
+    for (i = 0; i < e->cnt; ++i) {
+        v = e->samples[i];
+        for (j = i; j > 0 && sorted[j - 1] > v; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    *p50 = sorted[(e->cnt - 1) / 2];
+    *p99 = sorted[(e->cnt * 99 + 99) / 100 - 1];
+}
+
+/**
+ * \brief           Get adapted timeout for history entry
+ * \param[in]       e: History entry
+ * \param[in]       max_time: Maximal time allowed by API call in units of milliseconds
+ * \return          Adapted timeout or `0` if there are not enough samples
+ */
+static uint32_t
+prv_timeout(const lwcell_cmd_adapt_t* e, uint32_t max_time) {
+    uint32_t p50, p99, time;
+
+    if (e == NULL || e->cnt < LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES) {
+        return 0;
+    }
+    prv_percentiles(e, &p50, &p99);
+    time = p99 > UINT32_MAX / LWCELL_CFG_CMD_ADAPT_FACTOR ? UINT32_MAX : p99 * LWCELL_CFG_CMD_ADAPT_FACTOR;
+    time = LWCELL_MAX(time, LWCELL_CFG_CMD_ADAPT_MIN);
+    return LWCELL_MIN(time, max_time);
+}
+
+/**
+ * \brief           Check if command timeout may be adapted
+ *
+ * Only queries answered by device from its own state are adapted.
+ * Execution time of other commands depends on network, stored data or fixed delays,
+ * and shortened timeout would leave late response to be matched to next command.
+ *
+ * \param[in]       cmd: Command ID
+ * \return          `1` if timeout is adapted, `0` if command keeps timeout given by API call
+ */
+static uint8_t
+prv_is_adaptive(lwcell_cmd_t cmd) {
+    switch (cmd) {
+        case LWCELL_CMD_CSQ_GET:
+        case LWCELL_CMD_COPS_GET:
+        case LWCELL_CMD_CGMI_GET:
+        case LWCELL_CMD_CGMM_GET:
+        case LWCELL_CMD_CGMR_GET:
+        case LWCELL_CMD_CGSN_GET:
+        case LWCELL_CMD_CIPSTATUS: return 1;
+        default: return 0;
+    }
+}
+
+/**
+ * \brief           Set timeout of message about to start, based on observed latency
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to start
+ */
+void
+lwcelli_cmd_adapt_timeout(lwcell_msg_t* msg) {
+    uint32_t time;
+
+    /* Messages without timeout wait forever by design */
+    if (msg->block_time == 0 || !prv_is_adaptive(msg->cmd_def)) {
+        return;
+    }
+    if ((time = prv_timeout(prv_find(msg->cmd_def, 0), msg->block_time)) > 0) {
+        msg->block_time = time;
+    }
+}
+
+/**
+ * \brief           Record command execution time
+ * \note            Function must be called with core locked
+ * \param[in]       cmd: Command ID
+ * \param[in]       res: Execution result
+ * \param[in]       exec_time: Command execution time in units of milliseconds
+ */
+void
+lwcelli_cmd_adapt_record(lwcell_cmd_t cmd, lwcellr_t res, uint32_t exec_time) {
+    lwcell_cmd_adapt_t* e;
+
+    if (!prv_is_adaptive(cmd) || (e = prv_find(cmd, 1)) == NULL) {
+        return;
+    }
+    if (res == lwcellTIMEOUT) {
+        /* Only timeouts on adapted time are samples, fixed timeout says nothing about latency */
+        if (e->cnt < LWCELL_CFG_CMD_ADAPT_MIN_SAMPLES) {
+            return;
+        }
+        ++e->timeouts;
+    } else if (res != lwcellOK) { /* Command did not start or finished without response */
+        return;
+    }
+    e->samples[e->pos] = exec_time;
+    e->pos = (e->pos + 1) % LWCELL_ARRAYSIZE(e->samples);
+    if (e->cnt < LWCELL_ARRAYSIZE(e->samples)) {
+        ++e->cnt;
+    }
+}
+
+/**
+ * \brief           Get adaptive timeout state for all recorded commands
+ * \param[out]      stats: Array to copy state to
+ * \param[in]       max_entries: Maximal number of entries to copy
+ * \return          Number of entries copied to array
+ */
+size_t
+lwcell_cmd_adapt_get(lwcell_cmd_adapt_stats_t* stats, size_t max_entries) {
+    size_t cnt;
+
+    LWCELL_ASSERT0(stats != NULL);
+
+    lwcell_core_lock();
+    cnt = LWCELL_MIN(cmd_adapt_cnt, max_entries);
+    for (size_t i = 0; i < cnt; ++i) {
+        const lwcell_cmd_adapt_t* e = &cmd_adapt[i];
+
+        LWCELL_MEMSET(&stats[i], 0x00, sizeof(stats[i]));
+        stats[i].cmd = (uint16_t)e->cmd;
+        stats[i].name = lwcelli_dbg_msg_to_string(e->cmd);
+        stats[i].samples = (uint32_t)e->cnt;
+        stats[i].timeouts = e->timeouts;
+        if (e->cnt > 0) {
+            prv_percentiles(e, &stats[i].p50, &stats[i].p99);
+            stats[i].timeout = prv_timeout(e, UINT32_MAX);
+        }
+    }
+    lwcell_core_unlock();
+    return cnt;
+}
+
+/**
+ * \brief           Reset latency history of all commands
+ *
+ * Commands use timeouts given by API calls until new samples are recorded
+ */
+void
+lwcell_cmd_adapt_reset(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(cmd_adapt, 0x00, sizeof(cmd_adapt));
+    cmd_adapt_cnt = 0;
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT || __DOXYGEN__ */
@@ -0,0 +1,173 @@
+/**
+ * \file            lwcell_cmd_cancel.c
+ * \brief           Command deadlines and cancellation
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmd_cancel.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMD_CANCEL || __DOXYGEN__
+
+static lwcell_msg_t* queued; /*!< List of messages waiting in producer queue */
+
+#if LWCELL_CFG_CMD_DEADLINE > 0
+/**
+ * \brief           Check if command may be dropped when its deadline passes
+ *
+ * Only queries which do not change device or stack state are dropped.
+ * Reset, connection close, configuration and internal commands must reach device,
+ * otherwise state of stack and device would drift apart.
+ *
+ * \param[in]       cmd: Default command of message
+ * \return          `1` if deadline applies, `0` otherwise
+ */
+static uint8_t
+prv_has_deadline(lwcell_cmd_t cmd) {
+    switch (cmd) {
+        case LWCELL_CMD_CSQ_GET:
+        case LWCELL_CMD_CREG_GET:
+        case LWCELL_CMD_COPS_GET:
+        case LWCELL_CMD_COPS_GET_OPT:
+        case LWCELL_CMD_CGMI_GET:
+        case LWCELL_CMD_CGMM_GET:
+        case LWCELL_CMD_CGMR_GET:
+        case LWCELL_CMD_CGSN_GET:
+        case LWCELL_CMD_CPBR:
+        case LWCELL_CMD_CPBF:
+        case LWCELL_CMD_CDNSGIP: return 1;
+        default: return 0;
+    }
+}
+#endif /* LWCELL_CFG_CMD_DEADLINE > 0 */
+
+/**
+ * \brief           Register message, that is about to be put to producer queue, and set its deadline
+ * \param[in]       msg: Message to register
+ */
+void
+lwcelli_cmd_cancel_queued(lwcell_msg_t* msg) {
+    lwcell_core_lock();
+    msg->deadline = msg->time_queued + LWCELL_CFG_CMD_DEADLINE;
+    msg->queued_next = queued;
+    queued = msg;
+    lwcell_core_unlock();
+}
+
+/**
+ * \brief           Remove message from list of queued messages
+ * \param[in]       msg: Message taken from producer queue or not queued due to an error
+ */
+void
+lwcelli_cmd_cancel_dequeued(lwcell_msg_t* msg) {
+    lwcell_core_lock();
+    for (lwcell_msg_t** m = &queued; *m != NULL; m = &(*m)->queued_next) {
+        if (*m == msg) {
+            *m = msg->queued_next;
+            break;
+        }
+    }
+    msg->queued_next = NULL;
+    lwcell_core_unlock();
+}
+
+/**
+ * \brief           Check if message taken from producer queue shall still be executed
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message taken from producer queue
+ * \return          \ref lwcellOK if message shall be executed, \ref lwcellERRCANCELED when cancelled
+ *                      or \ref lwcellTIMEOUT when its deadline passed
+ */
+lwcellr_t
+lwcelli_cmd_cancel_check(lwcell_msg_t* msg) {
+    lwcelli_cmd_cancel_dequeued(msg);
+#if LWCELL_CFG_CMD_COALESCE
+    if (msg->waiter != NULL) { /* Query is still needed by other requests attached to it */
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_CMD_COALESCE */
+    if (msg->is_cancelled) {
+        LWCELL_METRICS_ADD(CMD_CANCELED, 1);
+        return lwcellERRCANCELED;
+    }
+#if LWCELL_CFG_CMD_DEADLINE > 0
+    if (prv_has_deadline(msg->cmd_def) && (int32_t)(lwcell_sys_now() - msg->deadline) >= 0) {
+        LWCELL_METRICS_ADD(CMD_EXPIRED, 1);
+        return lwcellTIMEOUT;
+    }
+#endif /* LWCELL_CFG_CMD_DEADLINE > 0 */
+    return lwcellOK;
+}
+
+/**
+ * \brief           Cancel commands started with specific callback function and argument
+ *
+ * Queued commands are finished with \ref lwcellERRCANCELED result when taken from producer queue,
+ * without being sent to device. Active connection send command stops after current data segment
+ *
+ * \note            Commands started without callback function, such as most blocking calls,
+ *                  cannot be cancelled. Only \ref LWCELL_CFG_CMD_DEADLINE applies to them
+ *
+ * \param[in]       evt_fn: Callback function used when command was started. Must not be `NULL`
+ * \param[in]       evt_arg: Callback argument used when command was started
+ * \return          Number of cancelled commands
+ */
+size_t
+lwcell_cmd_cancel(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg) {
+    size_t cnt = 0;
+
+    if (evt_fn == NULL) { /* Internal commands have no callback */
+        return 0;
+    }
+    lwcell_core_lock();
+    for (lwcell_msg_t* m = queued; m != NULL; m = m->queued_next) {
+        if (m->evt_fn == evt_fn && m->evt_arg == evt_arg && !m->is_cancelled) {
+            m->is_cancelled = 1;
+            ++cnt;
+        }
+    }
+#if LWCELL_CFG_CMUX
+    /* Commands may be active on control and data channel at the same time */
+    for (uint8_t ch = LWCELL_CMUX_CH_CTRL; ch <= LWCELL_CMUX_CH_DATA; ++ch) {
+        lwcell_msg_t* m = lwcelli_channel_msg(ch);
+#else  /* LWCELL_CFG_CMUX */
+    {
+        lwcell_msg_t* m = lwcell.msg;
+#endif /* !LWCELL_CFG_CMUX */
+        if (m != NULL && m->evt_fn == evt_fn && m->evt_arg == evt_arg && !m->is_cancelled) {
+            m->is_cancelled = 1;
+            ++cnt;
+        }
+    }
+    lwcell_core_unlock();
+    return cnt;
+}
+
+#endif /* LWCELL_CFG_CMD_CANCEL || __DOXYGEN__ */
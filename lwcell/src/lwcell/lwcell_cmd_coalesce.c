@@ -0,0 +1,162 @@
+/**
+ * \file            lwcell_cmd_coalesce.c
+ * \brief           Coalescing of identical pending queries
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMD_COALESCE || __DOXYGEN__
+
+/**
+ * \brief           Query commands that can be coalesced
+ *
+ * Commands have no input parameters and their result is available in global state,
+ * hence single execution answers all identical requests
+ */
+typedef enum {
+    COALESCE_CSQ = 0,   /*!< Signal strength */
+    COALESCE_COPS,      /*!< Current operator */
+    COALESCE_CIPSTATUS, /*!< Network and connections status */
+    COALESCE_END,
+} coalesce_idx_t;
+
+static lwcell_msg_t* pending[COALESCE_END]; /*!< Queued or active query of each type */
+
+/**
+ * \brief           Get coalescing index for message
+ * \param[in]       msg: Message to check
+ * \return          Member of \ref coalesce_idx_t, \ref COALESCE_END if message cannot be coalesced
+ */
+static coalesce_idx_t
+prv_get_idx(const lwcell_msg_t* msg) {
+    if (msg->cmd != msg->cmd_def) { /* Commands with sub-commands are not plain queries */
+        return COALESCE_END;
+    }
+    switch (msg->cmd_def) {
+        case LWCELL_CMD_CSQ_GET: return COALESCE_CSQ;
+        case LWCELL_CMD_COPS_GET: return COALESCE_COPS;
+        case LWCELL_CMD_CIPSTATUS: return COALESCE_CIPSTATUS;
+        default: return COALESCE_END;
+    }
+}
+
+/**
+ * \brief           Attach new message to identical query, that is waiting in producer queue or is active
+ *
+ * When there is no such query, message is registered as pending query of its type
+ * and must be put to producer queue by the caller.
+ *
+ * \note            When attached, non-blocking message is released by the library
+ *                  and must not be accessed anymore
+ * \param[in]       msg: New message, not yet put to producer queue
+ * \return          `1` if message has been attached and must not be queued, `0` otherwise
+ */
+uint8_t
+lwcelli_cmd_coalesce_attach(lwcell_msg_t* msg) {
+    lwcell_msg_t* m;
+    coalesce_idx_t idx;
+    uint8_t res = 0;
+
+    if ((idx = prv_get_idx(msg)) == COALESCE_END) {
+        return 0;
+    }
+    msg->waiter = NULL;
+    lwcell_core_lock();
+    if ((m = pending[idx]) == NULL) {
+        pending[idx] = msg;
+    } else {
+        for (; m->waiter != NULL; m = m->waiter) {}
+        m->waiter = msg; /* Waiters are completed in order they were attached */
+        res = 1;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Complete all messages attached to finished query
+ *
+ * Result of query is copied to every attached message, its callback is called
+ * and blocking caller is released or message is freed.
+ *
+ * \note            Function must be called with core locked, before query message itself is released
+ * \param[in]       msg: Finished query message
+ */
+void
+lwcelli_cmd_coalesce_finish(lwcell_msg_t* msg) {
+    lwcell_msg_t *w, *next;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(pending); ++i) {
+        if (pending[i] == msg) {
+            pending[i] = NULL; /* New requests start new query from now on */
+            break;
+        }
+    }
+    for (w = msg->waiter, msg->waiter = NULL; w != NULL; w = next) {
+        next = w->waiter;
+        w->res = msg->res;
+        if (w->res == lwcellOK) {
+            if (w->cmd_def == LWCELL_CMD_CSQ_GET && w->msg.csq.rssi != NULL) {
+                *w->msg.csq.rssi = lwcell.m.rssi;
+            } else if (w->cmd_def == LWCELL_CMD_COPS_GET && w->msg.cops_get.curr != NULL) {
+                LWCELL_MEMCPY(w->msg.cops_get.curr, &lwcell.m.network.curr_operator, sizeof(*w->msg.cops_get.curr));
+            }
+        }
+#if LWCELL_CFG_USE_API_FUNC_EVT
+        if (w->evt_fn != NULL) {
+            w->evt_fn(w->res, w->evt_arg);
+        }
+#endif /* LWCELL_CFG_USE_API_FUNC_EVT */
+#if LWCELL_CFG_OS
+        if (w->is_blocking) {
+            lwcell_sys_sem_release(&w->sem);
+        } else
+#endif /* LWCELL_CFG_OS */
+        {
+            LWCELL_MSG_VAR_FREE(w);
+        }
+    }
+}
+
+/**
+ * \brief           Fail query, that could not be put to producer queue, together with its attached messages
+ * \param[in]       msg: Query message
+ * \param[in]       res: Result to report to attached messages
+ */
+void
+lwcelli_cmd_coalesce_abort(lwcell_msg_t* msg, lwcellr_t res) {
+    lwcell_core_lock();
+    msg->res = res;
+    lwcelli_cmd_coalesce_finish(msg);
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_CMD_COALESCE || __DOXYGEN__ */
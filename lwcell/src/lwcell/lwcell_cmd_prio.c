@@ -0,0 +1,200 @@
+/**
+ * \file            lwcell_cmd_prio.c
+ * \brief           Command queue priority classes
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmd_prio.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMD_PRIO || __DOXYGEN__
+
+/**
+ * \brief           Queue of single priority class
+ */
+typedef struct {
+    lwcell_msg_t* first; /*!< Oldest message in queue */
+    lwcell_msg_t* last;  /*!< Newest message in queue */
+} prio_queue_t;
+
+static prio_queue_t prio_queues[LWCELL_CMD_PRIO_END];             /*!< Queue for each class */
+static lwcell_cmd_prio_stats_t prio_stats[LWCELL_CMD_PRIO_END]; /*!< Statistics for each class */
+static size_t prio_count;                                       /*!< Number of messages in all classes */
+
+/**
+ * \brief           Get priority class for command
+ * \param[in]       cmd: Default command of message
+ * \return          Priority class
+ */
+static lwcell_cmd_prio_t
+prv_cmd_to_prio(lwcell_cmd_t cmd) {
+    switch (cmd) {
+        case LWCELL_CMD_CIPSEND:
+        case LWCELL_CMD_CIPCLOSE: return LWCELL_CMD_PRIO_DATA;
+        case LWCELL_CMD_CSQ_GET:
+        case LWCELL_CMD_COPS_GET_OPT:
+        case LWCELL_CMD_CMGL:
+        case LWCELL_CMD_CPBR:
+        case LWCELL_CMD_CPBF: return LWCELL_CMD_PRIO_BACKGROUND;
+        default: return LWCELL_CMD_PRIO_CONTROL;
+    }
+}
+
+/**
+ * \brief           Put message to queue of its priority class
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message taken from producer queue
+ */
+void
+lwcelli_cmd_prio_put(lwcell_msg_t* msg) {
+    prio_queue_t* q;
+
+    msg->prio = LWCELL_U8(prv_cmd_to_prio(msg->cmd_def));
+    msg->next = NULL;
+    q = &prio_queues[msg->prio];
+    if (q->last != NULL) {
+        q->last->next = msg;
+    } else {
+        q->first = msg;
+    }
+    q->last = msg;
+    ++prio_count;
+    ++prio_stats[msg->prio].queued;
+}
+
+/**
+ * \brief           Get next message to execute
+ * \note            Function must be called with core locked
+ * \return          Message with highest priority, or one waiting too long, `NULL` if all queues are empty
+ */
+lwcell_msg_t*
+lwcelli_cmd_prio_get(void) {
+    lwcell_msg_t* msg;
+    lwcell_cmd_prio_stats_t* st;
+    size_t prio = LWCELL_CMD_PRIO_END, aged = LWCELL_CMD_PRIO_END;
+    uint32_t now = lwcell_sys_now(), wait, aged_wait = 0;
+
+    for (size_t i = 0; i < LWCELL_CMD_PRIO_END; ++i) {
+        if ((msg = prio_queues[i].first) == NULL) {
+            continue;
+        }
+        if (prio == LWCELL_CMD_PRIO_END) {
+            prio = i; /* Highest non-empty class */
+        }
+        if ((wait = now - msg->time_queued) >= LWCELL_CFG_CMD_PRIO_MAX_WAIT && wait > aged_wait) {
+            aged = i; /* Longest waiting class over the limit */
+            aged_wait = wait;
+        }
+    }
+    if (prio == LWCELL_CMD_PRIO_END) {
+        return NULL;
+    }
+    if (aged != LWCELL_CMD_PRIO_END && aged != prio) {
+        ++prio_stats[aged].aged;
+        prio = aged;
+    }
+    st = &prio_stats[prio];
+
+    /* Remove first message from queue */
+    msg = prio_queues[prio].first;
+    prio_queues[prio].first = msg->next;
+    if (prio_queues[prio].first == NULL) {
+        prio_queues[prio].last = NULL;
+    }
+    msg->next = NULL;
+    --prio_count;
+
+    wait = now - msg->time_queued;
+    ++st->count;
+    --st->queued;
+    st->wait_total += wait;
+    st->wait_max = LWCELL_MAX(st->wait_max, wait);
+    return msg;
+}
+
+/**
+ * \brief           Check if all priority queues are empty
+ * \return          `1` if empty, `0` otherwise
+ */
+uint8_t
+lwcelli_cmd_prio_is_empty(void) {
+    for (size_t i = 0; i < LWCELL_CMD_PRIO_END; ++i) {
+        if (prio_queues[i].first != NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Check if priority queues hold as many messages as producer queue
+ *
+ * Messages are left in producer queue until then,
+ * so API functions keep blocking or failing when command queue is full
+ *
+ * \return          `1` if full, `0` otherwise
+ */
+uint8_t
+lwcelli_cmd_prio_is_full(void) {
+    return prio_count >= LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE;
+}
+
+/**
+ * \brief           Get queue statistics of all priority classes
+ * \param[out]      stats: Array of \ref LWCELL_CMD_PRIO_END entries, indexed by \ref lwcell_cmd_prio_t
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cmd_prio_get_stats(lwcell_cmd_prio_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(stats, prio_stats, sizeof(prio_stats));
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Reset queue statistics of all priority classes
+ * \note            Number of currently queued commands is kept
+ */
+void
+lwcell_cmd_prio_reset_stats(void) {
+    lwcell_core_lock();
+    for (size_t i = 0; i < LWCELL_CMD_PRIO_END; ++i) {
+        uint32_t queued = prio_stats[i].queued;
+
+        LWCELL_MEMSET(&prio_stats[i], 0x00, sizeof(prio_stats[i]));
+        prio_stats[i].queued = queued;
+    }
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_CMD_PRIO || __DOXYGEN__ */
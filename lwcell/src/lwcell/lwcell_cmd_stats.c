@@ -0,0 +1,150 @@
+/**
+ * \file            lwcell_cmd_stats.c
+ * \brief           Per-command statistics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmd_stats.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMD_STATS || __DOXYGEN__
+
+static lwcell_cmd_stats_t cmd_stats[LWCELL_CFG_CMD_STATS_ENTRIES]; /*!< Statistics entries */
+static size_t cmd_stats_cnt;                                       /*!< Number of used entries */
+static uint32_t cmd_stats_dropped; /*!< Number of executions not recorded due to no free entry */
+
+/**
+ * \brief           Get histogram bin for latency
+ * \param[in]       time: Latency in units of milliseconds
+ * \return          Histogram bin index
+ */
+static size_t
+prv_hist_bin(uint32_t time) {
+    size_t bin = 0;
+
+    for (; time > 0 && bin < LWCELL_CMD_STATS_HIST_LEN - 1; time >>= 2) {
+        ++bin;
+    }
+    return bin;
+}
+
+/**
+ * \brief           Record single command execution
+ * \note            Function must be called with core locked
+ * \param[in]       cmd: Command ID
+ * \param[in]       res: Execution result
+ * \param[in]       wait_time: Time message spent in producer queue in units of milliseconds
+ * \param[in]       exec_time: Command execution time in units of milliseconds
+ */
+void
+lwcelli_cmd_stats_record(lwcell_cmd_t cmd, lwcellr_t res, uint32_t wait_time, uint32_t exec_time) {
+    lwcell_cmd_stats_t* s = NULL;
+
+    for (size_t i = 0; i < cmd_stats_cnt; ++i) {
+        if (cmd_stats[i].cmd == (uint16_t)cmd) {
+            s = &cmd_stats[i];
+            break;
+        }
+    }
+    if (s == NULL) {
+        if (cmd_stats_cnt >= LWCELL_ARRAYSIZE(cmd_stats)) {
+            ++cmd_stats_dropped;
+            return;
+        }
+        s = &cmd_stats[cmd_stats_cnt++];
+        s->cmd = (uint16_t)cmd;
+        s->name = lwcelli_dbg_msg_to_string(cmd);
+    }
+
+    ++s->count;
+    if (res == lwcellTIMEOUT) {
+        ++s->timeouts;
+    } else if (res != lwcellOK) {
+        ++s->errors;
+    }
+    s->wait_total += wait_time;
+    s->exec_total += exec_time;
+    if (wait_time > s->wait_max) {
+        s->wait_max = wait_time;
+    }
+    if (exec_time > s->exec_max) {
+        s->exec_max = exec_time;
+    }
+    ++s->wait_hist[prv_hist_bin(wait_time)];
+    ++s->exec_hist[prv_hist_bin(exec_time)];
+}
+
+/**
+ * \brief           Get statistics for all recorded commands
+ * \param[out]      stats: Array to copy statistics to
+ * \param[in]       max_entries: Maximal number of entries to copy
+ * \return          Number of entries copied to array
+ */
+size_t
+lwcell_cmd_stats_get(lwcell_cmd_stats_t* stats, size_t max_entries) {
+    size_t cnt;
+
+    LWCELL_ASSERT0(stats != NULL);
+
+    lwcell_core_lock();
+    cnt = LWCELL_MIN(cmd_stats_cnt, max_entries);
+    LWCELL_MEMCPY(stats, cmd_stats, cnt * sizeof(*stats));
+    lwcell_core_unlock();
+    return cnt;
+}
+
+/**
+ * \brief           Get number of executions not recorded because all entries were in use
+ * \return          Number of dropped executions
+ * \sa              LWCELL_CFG_CMD_STATS_ENTRIES
+ */
+uint32_t
+lwcell_cmd_stats_get_dropped(void) {
+    uint32_t dropped;
+
+    lwcell_core_lock();
+    dropped = cmd_stats_dropped;
+    lwcell_core_unlock();
+    return dropped;
+}
+
+/**
+ * \brief           Reset all command statistics
+ */
+void
+lwcell_cmd_stats_reset(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(cmd_stats, 0x00, sizeof(cmd_stats));
+    cmd_stats_cnt = 0;
+    cmd_stats_dropped = 0;
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_CMD_STATS || __DOXYGEN__ */
@@ -0,0 +1,546 @@
+/**
+ * \file            lwcell_cmux.c
+ * \brief           GSM 07.10 multiplexer
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmux.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+
+/* Basic option frame fields */
+#define CMUX_FLAG     0xF9 /*!< Opening and closing flag of every frame */
+#define CMUX_EA       0x01 /*!< Extension bit, set in last octet of field */
+#define CMUX_CR       0x02 /*!< Command/response bit */
+#define CMUX_PF       0x10 /*!< Poll/final bit */
+#define CMUX_FCS_GOOD 0xCF /*!< Checksum remainder of valid frame */
+
+/* Frame types, without poll/final bit */
+#define CMUX_SABM 0x2F /*!< Set asynchronous balanced mode, opens channel */
+#define CMUX_UA   0x63 /*!< Unnumbered acknowledgement */
+#define CMUX_DM   0x0F /*!< Disconnected mode */
+#define CMUX_DISC 0x43 /*!< Disconnect channel */
+#define CMUX_UIH  0xEF /*!< Unnumbered information with header check only */
+#define CMUX_UI   0x03 /*!< Unnumbered information */
+
+/* Multiplexer control channel message types, without command/response bit */
+#define CMUX_MSG_CLD 0xC1 /*!< Multiplexer close down */
+#define CMUX_MSG_MSC 0xE1 /*!< Modem status command */
+
+/**
+ * \brief           Receive state of frame decoder
+ */
+typedef enum {
+    CMUX_RX_FLAG = 0x00, /*!< Waiting for opening flag */
+    CMUX_RX_ADDR,        /*!< Waiting for address field */
+    CMUX_RX_CTRL,        /*!< Waiting for control field */
+    CMUX_RX_LEN,         /*!< Waiting for length field */
+    CMUX_RX_LEN2,        /*!< Waiting for second octet of length field */
+    CMUX_RX_DATA,        /*!< Receiving information field */
+    CMUX_RX_FCS,         /*!< Waiting for checksum */
+    CMUX_RX_END,         /*!< Waiting for closing flag */
+} lwcell_cmux_rx_state_t;
+
+static struct {
+    lwcell_cmux_rx_state_t state;             /*!< Decoder state */
+    uint8_t addr;                             /*!< Address field of current frame */
+    uint8_t ctrl;                             /*!< Control field of current frame, without poll/final bit */
+    uint8_t fcs;                              /*!< Running checksum */
+    size_t len;                               /*!< Length of information field */
+    size_t pos;                               /*!< Number of received information bytes */
+    uint8_t data[LWCELL_CFG_CMUX_FRAME_SIZE]; /*!< Information field, held until checksum is verified */
+} rx;
+
+static struct {
+    uint8_t data[LWCELL_CFG_CMUX_FRAME_SIZE]; /*!< Data waiting to be sent */
+    size_t len;                               /*!< Number of bytes waiting */
+} tx[LWCELL_CMUX_CH_END];
+
+static struct {
+    uint8_t active;  /*!< Set to `1` when traffic on AT port is framed */
+    uint8_t opening; /*!< Set to `1` while channels are being opened */
+    uint8_t dlci;    /*!< Channel waiting for confirmation while opening */
+} mux;
+
+static lwcell_cmux_stats_t mux_stats; /*!< Multiplexer statistics */
+
+/**
+ * \brief           Add byte to frame checksum
+ * \param[in]       fcs: Current checksum
+ * \param[in]       b: Byte to add
+ * \return          New checksum
+ */
+static uint8_t
+prv_fcs(uint8_t fcs, uint8_t b) {
+    fcs ^= b;
+    for (uint8_t i = 0; i < 8; ++i) {
+        fcs = (fcs & 0x01) ? ((fcs >> 1) ^ 0xE0) : (fcs >> 1);
+    }
+    return fcs;
+}
+
+/**
+ * \brief           Send single frame to AT port
+ * \param[in]       dlci: Channel address
+ * \param[in]       ctrl: Frame type
+ * \param[in]       is_cmd: Set to `1` when frame is command, `0` when it is response
+ * \param[in]       data: Information field data or `NULL` when there is none
+ * \param[in]       len: Length of information field
+ */
+static void
+prv_send_frame(uint8_t dlci, uint8_t ctrl, uint8_t is_cmd, const void* data, size_t len) {
+    uint8_t hdr[5], ftr[2], fcs = 0xFF;
+    size_t hdr_len = 0;
+
+    hdr[hdr_len++] = CMUX_FLAG;
+    hdr[hdr_len++] = LWCELL_U8((dlci << 2) | (is_cmd ? CMUX_CR : 0) | CMUX_EA);
+    hdr[hdr_len++] = ctrl;
+    if (len > 0x7F) {
+        hdr[hdr_len++] = LWCELL_U8(len << 1);
+        hdr[hdr_len++] = LWCELL_U8(len >> 7);
+    } else {
+        hdr[hdr_len++] = LWCELL_U8((len << 1) | CMUX_EA);
+    }
+    for (size_t i = 1; i < hdr_len; ++i) {
+        fcs = prv_fcs(fcs, hdr[i]);
+    }
+    ftr[0] = LWCELL_U8(0xFF - fcs);
+    ftr[1] = CMUX_FLAG;
+
+    lwcelli_at_port_write(hdr, hdr_len);
+    if (len > 0) {
+        lwcelli_at_port_write(data, len);
+    }
+    lwcelli_at_port_write(ftr, sizeof(ftr));
+    ++mux_stats.frames_tx;
+}
+
+/**
+ * \brief           Send message on multiplexer control channel
+ * \param[in]       type: Message type, including command/response bit
+ * \param[in]       data: Message value or `NULL` when there is none
+ * \param[in]       len: Length of message value, up to `6` bytes
+ */
+static void
+prv_send_msg(uint8_t type, const uint8_t* data, size_t len) {
+    uint8_t m[8];
+
+    m[0] = type;
+    m[1] = LWCELL_U8((len << 1) | CMUX_EA);
+    if (len > 0) {
+        LWCELL_MEMCPY(&m[2], data, len);
+    }
+    prv_send_frame(0, CMUX_UIH, 1, m, len + 2);
+    lwcelli_at_port_write(NULL, 0);
+}
+
+/**
+ * \brief           Send data waiting in channel buffer
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t
+ */
+static void
+prv_flush(uint8_t ch) {
+    if (tx[ch].len > 0) {
+        prv_send_frame(ch + 1, CMUX_UIH, 1, tx[ch].data, tx[ch].len);
+        tx[ch].len = 0;
+    }
+}
+
+/**
+ * \brief           Device did not confirm channel in time
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_open_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+    if (mux.opening) {
+        ++mux_stats.open_errors;
+        lwcelli_cmux_close();
+        lwcelli_cmux_opened(0);
+    }
+}
+
+/**
+ * \brief           Request opening of channel and wait for device to confirm it
+ * \param[in]       dlci: Channel address, `0` for multiplexer control channel
+ */
+static void
+prv_open_dlci(uint8_t dlci) {
+    mux.dlci = dlci;
+    prv_send_frame(dlci, CMUX_SABM | CMUX_PF, 1, NULL, 0);
+    lwcelli_at_port_write(NULL, 0);
+    lwcell_timeout_add(LWCELL_CFG_CMUX_TIMEOUT, prv_open_timeout_fn, NULL);
+}
+
+/**
+ * \brief           Device confirmed channel, continue with next one
+ */
+static void
+prv_open_next(void) {
+    lwcell_timeout_remove(prv_open_timeout_fn);
+    if (mux.dlci > 0) {
+        /* Signal ready to communicate on the channel, required by some devices before they send data */
+        const uint8_t v24[] = {LWCELL_U8((mux.dlci << 2) | CMUX_CR | CMUX_EA), 0x8D};
+
+        prv_send_msg(CMUX_MSG_MSC | CMUX_CR, v24, sizeof(v24));
+    }
+    if (mux.dlci < LWCELL_CMUX_CH_END) {
+        prv_open_dlci(mux.dlci + 1);
+    } else {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE, "[LWCELL CMUX] All channels open\r\n");
+        mux.opening = 0;
+        ++mux_stats.opened;
+        lwcelli_cmux_opened(1);
+    }
+}
+
+/**
+ * \brief           Process message received on multiplexer control channel
+ */
+static void
+prv_process_msg(void) {
+    if (rx.len < 2 || !(rx.data[0] & CMUX_CR)) {
+        return; /* Responses to our commands need no action */
+    }
+    switch (rx.data[0] & ~CMUX_CR) {
+        case CMUX_MSG_MSC: {
+            /* Acknowledge modem status with same content */
+            prv_send_msg(CMUX_MSG_MSC, &rx.data[2], LWCELL_MIN(LWCELL_MIN(rx.len - 2, (size_t)(rx.data[1] >> 1)), 6));
+            break;
+        }
+        case CMUX_MSG_CLD: {
+            prv_send_msg(CMUX_MSG_CLD, NULL, 0);
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                          "[LWCELL CMUX] Device closed multiplexer\r\n");
+            mux.active = 0;
+            mux.opening = 0;
+            lwcelli_channel_reset();
+            break;
+        }
+        default: break;
+    }
+}
+
+/**
+ * \brief           Collect received information bytes of current frame
+ *
+ * Bytes are held in frame buffer and forwarded only once checksum and closing flag are verified
+ *
+ * \param[in]       data: Received bytes
+ * \param[in]       len: Number of bytes
+ */
+static void
+prv_process_data(const uint8_t* data, size_t len) {
+    if (rx.ctrl == CMUX_UI) { /* Information field is covered by checksum only in this type */
+        for (size_t i = 0; i < len; ++i) {
+            rx.fcs = prv_fcs(rx.fcs, data[i]);
+        }
+    }
+    LWCELL_MEMCPY(&rx.data[rx.pos], data, len);
+}
+
+/**
+ * \brief           Process complete received frame
+ */
+static void
+prv_process_frame(void) {
+    uint8_t dlci = LWCELL_U8(rx.addr >> 2);
+
+    ++mux_stats.frames_rx;
+    if (rx.fcs != CMUX_FCS_GOOD) {
+        ++mux_stats.fcs_errors;
+        return;
+    }
+    switch (rx.ctrl) {
+        case CMUX_UA: {
+            if (mux.opening && dlci == mux.dlci) {
+                prv_open_next();
+            }
+            break;
+        }
+        case CMUX_DM: {
+            if (mux.opening && dlci == mux.dlci) {
+                prv_open_timeout_fn(NULL); /* Device refused channel */
+            }
+            break;
+        }
+        case CMUX_DISC: {
+            prv_send_frame(dlci, CMUX_UA | CMUX_PF, 0, NULL, 0);
+            lwcelli_at_port_write(NULL, 0);
+            break;
+        }
+        case CMUX_UI:
+        case CMUX_UIH: {
+            if (dlci == 0) {
+                prv_process_msg();
+            } else if (dlci <= LWCELL_CMUX_CH_END && rx.len > 0) {
+                mux_stats.bytes_rx[dlci - 1] += LWCELL_U32(rx.len);
+                lwcelli_channel_process(dlci - 1, rx.data, rx.len);
+            }
+            break;
+        }
+        default: break;
+    }
+}
+
+/**
+ * \brief           Check if multiplexer is running
+ * \note            Function must be called with core locked
+ * \return          `1` if AT port traffic is framed, `0` otherwise
+ */
+uint8_t
+lwcelli_cmux_is_active(void) {
+    return mux.active;
+}
+
+/**
+ * \brief           Get channel to execute message on
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to execute
+ * \return          Member of \ref lwcell_cmux_ch_t enumeration
+ */
+uint8_t
+lwcelli_cmux_channel(const lwcell_msg_t* msg) {
+    if (!mux.active || mux.opening) {
+        return LWCELL_CMUX_CH_CTRL;
+    }
+#if LWCELL_CFG_CONN
+    if (msg->cmd_def == LWCELL_CMD_CIPSEND) {
+        return LWCELL_CMUX_CH_DATA;
+    }
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_PPP
+    /* PPP session occupies data channel, control channel stays available for commands */
+    if (msg->cmd_def == LWCELL_CMD_PPP_START || msg->cmd_def == LWCELL_CMD_PPP_STOP) {
+        return LWCELL_CMUX_CH_DATA;
+    }
+#endif /* LWCELL_CFG_PPP */
+#if !LWCELL_CFG_CONN && !LWCELL_CFG_PPP
+    LWCELL_UNUSED(msg);
+#endif /* !LWCELL_CFG_CONN && !LWCELL_CFG_PPP */
+    return LWCELL_CMUX_CH_CTRL;
+}
+
+/**
+ * \brief           Start framing on AT port and open all channels
+ *
+ * Called once device accepted `AT+CMUX` command.
+ * Completion is reported with \ref lwcelli_cmux_opened
+ *
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_cmux_open(void) {
+    LWCELL_MEMSET(&rx, 0x00, sizeof(rx));
+    LWCELL_MEMSET(tx, 0x00, sizeof(tx));
+    lwcelli_channel_reset();
+    mux.active = 1;
+    mux.opening = 1;
+    prv_open_dlci(0);
+}
+
+/**
+ * \brief           Close multiplexer and return device to plain AT mode
+ *
+ * Command active on data channel is finished with error
+ *
+ * \note            Function must be called with core locked and control channel selected
+ */
+void
+lwcelli_cmux_close(void) {
+    if (!mux.active) {
+        return;
+    }
+    lwcell_timeout_remove(prv_open_timeout_fn);
+    prv_send_msg(CMUX_MSG_CLD | CMUX_CR, NULL, 0);
+    mux.active = 0;
+    mux.opening = 0;
+    lwcelli_channel_reset();
+}
+
+/**
+ * \brief           Process data received on AT port while multiplexer is running
+ * \note            Function must be called with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ */
+void
+lwcelli_cmux_input(const void* data, size_t len) {
+    const uint8_t* d = data;
+    uint8_t ch;
+
+    while (len > 0 && mux.active) {
+        if (rx.state == CMUX_RX_DATA) {
+            size_t l = LWCELL_MIN(len, rx.len - rx.pos);
+
+            prv_process_data(d, l);
+            d += l;
+            len -= l;
+            rx.pos += l;
+            if (rx.pos == rx.len) {
+                rx.state = CMUX_RX_FCS;
+            }
+            continue;
+        }
+
+        ch = *d++;
+        --len;
+        switch (rx.state) {
+            case CMUX_RX_FLAG: {
+                if (ch == CMUX_FLAG) {
+                    rx.state = CMUX_RX_ADDR;
+                }
+                break;
+            }
+            case CMUX_RX_ADDR: {
+                if (ch != CMUX_FLAG) { /* Repeated flags between frames are allowed */
+                    rx.addr = ch;
+                    rx.fcs = prv_fcs(0xFF, ch);
+                    rx.state = CMUX_RX_CTRL;
+                }
+                break;
+            }
+            case CMUX_RX_CTRL: {
+                rx.ctrl = LWCELL_U8(ch & ~CMUX_PF);
+                rx.fcs = prv_fcs(rx.fcs, ch);
+                rx.state = CMUX_RX_LEN;
+                break;
+            }
+            case CMUX_RX_LEN:
+            case CMUX_RX_LEN2: {
+                rx.fcs = prv_fcs(rx.fcs, ch);
+                if (rx.state == CMUX_RX_LEN) {
+                    rx.len = ch >> 1;
+                } else {
+                    rx.len |= (size_t)ch << 7;
+                }
+                if (rx.state == CMUX_RX_LEN && !(ch & CMUX_EA)) {
+                    rx.state = CMUX_RX_LEN2;
+                } else if (rx.len > LWCELL_CFG_CMUX_FRAME_SIZE) {
+                    ++mux_stats.fcs_errors; /* Corrupted header, wait for next frame */
+                    rx.state = CMUX_RX_FLAG;
+                } else {
+                    rx.pos = 0;
+                    rx.state = rx.len > 0 ? CMUX_RX_DATA : CMUX_RX_FCS;
+                }
+                break;
+            }
+            case CMUX_RX_FCS: {
+                rx.fcs = prv_fcs(rx.fcs, ch);
+                rx.state = CMUX_RX_END;
+                break;
+            }
+            case CMUX_RX_END: {
+                if (ch == CMUX_FLAG) {
+                    rx.state = CMUX_RX_ADDR;
+                    prv_process_frame();
+                } else {
+                    ++mux_stats.fcs_errors;
+                    rx.state = CMUX_RX_FLAG;
+                }
+                break;
+            }
+            default: break;
+        }
+    }
+}
+
+/**
+ * \brief           Send data on channel
+ *
+ * Data are collected to frames of up to \ref LWCELL_CFG_CMUX_FRAME_SIZE bytes.
+ * Frame is sent when full or on flush request
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t
+ * \param[in]       data: Data to send or `NULL` to flush
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes accepted
+ */
+size_t
+lwcelli_cmux_send(uint8_t ch, const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t l;
+
+    if (data == NULL || len == 0) {
+        prv_flush(ch);
+        lwcelli_at_port_write(NULL, 0);
+        return 0;
+    }
+    mux_stats.bytes_tx[ch] += LWCELL_U32(len);
+    for (size_t rem = len; rem > 0; d += l, rem -= l) {
+        if (tx[ch].len == 0 && rem >= sizeof(tx[ch].data)) {
+            /* Full frame is sent directly from user memory */
+            l = sizeof(tx[ch].data);
+            prv_send_frame(ch + 1, CMUX_UIH, 1, d, l);
+        } else {
+            l = LWCELL_MIN(rem, sizeof(tx[ch].data) - tx[ch].len);
+            LWCELL_MEMCPY(&tx[ch].data[tx[ch].len], d, l);
+            tx[ch].len += l;
+            if (tx[ch].len == sizeof(tx[ch].data)) {
+                prv_flush(ch);
+            }
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Check if multiplexer is running
+ * \return          `1` if multiplexer is running, `0` otherwise
+ */
+uint8_t
+lwcell_cmux_is_active(void) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = mux.active && !mux.opening;
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get multiplexer statistics
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cmux_get_stats(lwcell_cmux_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    *stats = mux_stats;
+    stats->is_active = mux.active && !mux.opening;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
@@ -236,6 +236,7 @@ lwcell_conn_close(lwcell_conn_p conn, const uint32_t blocking) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE,
                       "[LWCELL CONN] Connection %d set to closing state\r\n", (int)conn->num);
         conn->status.f.in_closing = 1; /* Connection is in closing mode but not yet closed */
+        lwcelli_state_changed();
         lwcell_core_unlock();
     }
     return res;
@@ -34,16 +34,221 @@
 #include "lwcell/lwcell_debug.h"
 #include "lwcell/lwcell_private.h"
 
-#if LWCELL_CFG_DBG || __DOXYGEN__
+#if LWCELL_CFG_DBG || LWCELL_CFG_CMD_STATS || __DOXYGEN__
 
+/**
+ * \brief           Command names, indexed by \ref lwcell_cmd_t
+ */
+static const char* const cmd_names[LWCELL_CMD_END] = {
+    [LWCELL_CMD_IDLE]                   = "IDLE",
+    [LWCELL_CMD_DELAY]                  = "DELAY",
+    [LWCELL_CMD_RESET]                  = "RESET",
+    [LWCELL_CMD_RESET_DEVICE_FIRST_CMD] = "RESET_DEVICE_FIRST_CMD",
+    [LWCELL_CMD_RESET_PROBE]            = "RESET_PROBE",
+    [LWCELL_CMD_RESET_WARM_CHECK]       = "RESET_WARM_CHECK",
+    [LWCELL_CMD_ATE0]                   = "ATE0",
+    [LWCELL_CMD_ATE1]                   = "ATE1",
+    [LWCELL_CMD_GSLP]                   = "GSLP",
+    [LWCELL_CMD_RESTORE]                = "RESTORE",
+    [LWCELL_CMD_UART]                   = "UART",
+    [LWCELL_CMD_UART_VERIFY]            = "UART_VERIFY",
+    [LWCELL_CMD_UART_SCAN]              = "UART_SCAN",
+    [LWCELL_CMD_CMUX_SET]               = "CMUX_SET",
+    [LWCELL_CMD_CMUX_OPEN]              = "CMUX_OPEN",
+    [LWCELL_CMD_IFC_SET]                = "IFC_SET",
+    [LWCELL_CMD_CGACT_SET_0]            = "CGACT_SET_0",
+    [LWCELL_CMD_CGACT_SET_1]            = "CGACT_SET_1",
+    [LWCELL_CMD_CGATT_SET_0]            = "CGATT_SET_0",
+    [LWCELL_CMD_CGATT_SET_1]            = "CGATT_SET_1",
+    [LWCELL_CMD_NETWORK_ATTACH]         = "NETWORK_ATTACH",
+    [LWCELL_CMD_NETWORK_DETACH]         = "NETWORK_DETACH",
+    [LWCELL_CMD_CIPMUX_SET]             = "CIPMUX_SET",
+    [LWCELL_CMD_CIPRXGET_SET]           = "CIPRXGET_SET",
+    [LWCELL_CMD_CSTT_SET]               = "CSTT_SET",
+    [LWCELL_CMD_PPP_START]              = "PPP_START",
+    [LWCELL_CMD_PPP_STOP]               = "PPP_STOP",
+    [LWCELL_CMD_CGDCONT]                = "CGDCONT",
+    [LWCELL_CMD_PPP_DIAL]               = "PPP_DIAL",
+    [LWCELL_CMD_PPP_ESCAPE]             = "PPP_ESCAPE",
+    [LWCELL_CMD_PPP_RESUME]             = "PPP_RESUME",
+    [LWCELL_CMD_PPP_HANGUP]             = "PPP_HANGUP",
+    [LWCELL_CMD_CALL_ENABLE]            = "CALL_ENABLE",
+    [LWCELL_CMD_A]                      = "A",
+    [LWCELL_CMD_ATA]                    = "ATA",
+    [LWCELL_CMD_ATD]                    = "ATD",
+    [LWCELL_CMD_ATD_N]                  = "ATD_N",
+    [LWCELL_CMD_ATD_STR]                = "ATD_STR",
+    [LWCELL_CMD_ATDL]                   = "ATDL",
+    [LWCELL_CMD_ATE]                    = "ATE",
+    [LWCELL_CMD_ATH]                    = "ATH",
+    [LWCELL_CMD_ATI]                    = "ATI",
+    [LWCELL_CMD_ATL]                    = "ATL",
+    [LWCELL_CMD_ATM]                    = "ATM",
+    [LWCELL_CMD_PPP]                    = "PPP",
+    [LWCELL_CMD_ATO]                    = "ATO",
+    [LWCELL_CMD_ATP]                    = "ATP",
+    [LWCELL_CMD_ATQ]                    = "ATQ",
+    [LWCELL_CMD_ATS0]                   = "ATS0",
+    [LWCELL_CMD_ATS3]                   = "ATS3",
+    [LWCELL_CMD_ATS4]                   = "ATS4",
+    [LWCELL_CMD_ATS5]                   = "ATS5",
+    [LWCELL_CMD_ATS6]                   = "ATS6",
+    [LWCELL_CMD_ATS7]                   = "ATS7",
+    [LWCELL_CMD_ATS8]                   = "ATS8",
+    [LWCELL_CMD_ATS10]                  = "ATS10",
+    [LWCELL_CMD_ATT]                    = "ATT",
+    [LWCELL_CMD_ATV]                    = "ATV",
+    [LWCELL_CMD_ATX]                    = "ATX",
+    [LWCELL_CMD_ATZ]                    = "ATZ",
+    [LWCELL_CMD_AT_C]                   = "AT_C",
+    [LWCELL_CMD_AT_D]                   = "AT_D",
+    [LWCELL_CMD_AT_F]                   = "AT_F",
+    [LWCELL_CMD_AT_V]                   = "AT_V",
+    [LWCELL_CMD_AT_W]                   = "AT_W",
+    [LWCELL_CMD_GCAP]                   = "GCAP",
+    [LWCELL_CMD_GMI]                    = "GMI",
+    [LWCELL_CMD_GMM]                    = "GMM",
+    [LWCELL_CMD_GMR]                    = "GMR",
+    [LWCELL_CMD_GOI]                    = "GOI",
+    [LWCELL_CMD_GSN]                    = "GSN",
+    [LWCELL_CMD_ICF]                    = "ICF",
+    [LWCELL_CMD_IFC]                    = "IFC",
+    [LWCELL_CMD_IPR]                    = "IPR",
+    [LWCELL_CMD_HVOIC]                  = "HVOIC",
+    [LWCELL_CMD_COPS_SET]               = "COPS_SET",
+    [LWCELL_CMD_COPS_GET]               = "COPS_GET",
+    [LWCELL_CMD_COPS_GET_OPT]           = "COPS_GET_OPT",
+    [LWCELL_CMD_CPAS]                   = "CPAS",
+    [LWCELL_CMD_CGMI_GET]               = "CGMI_GET",
+    [LWCELL_CMD_CGMM_GET]               = "CGMM_GET",
+    [LWCELL_CMD_CGMR_GET]               = "CGMR_GET",
+    [LWCELL_CMD_CGSN_GET]               = "CGSN_GET",
+    [LWCELL_CMD_CLCC_SET]               = "CLCC_SET",
+    [LWCELL_CMD_CLCK]                   = "CLCK",
+    [LWCELL_CMD_CACM]                   = "CACM",
+    [LWCELL_CMD_CAMM]                   = "CAMM",
+    [LWCELL_CMD_CAOC]                   = "CAOC",
+    [LWCELL_CMD_CBST]                   = "CBST",
+    [LWCELL_CMD_CCFC]                   = "CCFC",
+    [LWCELL_CMD_CCWA]                   = "CCWA",
+    [LWCELL_CMD_CEER]                   = "CEER",
+    [LWCELL_CMD_CSCS]                   = "CSCS",
+    [LWCELL_CMD_CSTA]                   = "CSTA",
+    [LWCELL_CMD_CHLD]                   = "CHLD",
+    [LWCELL_CMD_CIMI]                   = "CIMI",
+    [LWCELL_CMD_CLIP]                   = "CLIP",
+    [LWCELL_CMD_CLIR]                   = "CLIR",
+    [LWCELL_CMD_CMEE_SET]               = "CMEE_SET",
+    [LWCELL_CMD_COLP]                   = "COLP",
+    [LWCELL_CMD_PHONEBOOK_ENABLE]       = "PHONEBOOK_ENABLE",
+    [LWCELL_CMD_CPBF]                   = "CPBF",
+    [LWCELL_CMD_CPBR]                   = "CPBR",
+    [LWCELL_CMD_CPBS_SET]               = "CPBS_SET",
+    [LWCELL_CMD_CPBS_GET]               = "CPBS_GET",
+    [LWCELL_CMD_CPBS_GET_OPT]           = "CPBS_GET_OPT",
+    [LWCELL_CMD_CPBW_SET]               = "CPBW_SET",
+    [LWCELL_CMD_CPBW_GET_OPT]           = "CPBW_GET_OPT",
+    [LWCELL_CMD_SIM_PROCESS_BASIC_CMDS] = "SIM_PROCESS_BASIC_CMDS",
+    [LWCELL_CMD_CPIN_SET]               = "CPIN_SET",
+    [LWCELL_CMD_CPIN_GET]               = "CPIN_GET",
+    [LWCELL_CMD_CPIN_ADD]               = "CPIN_ADD",
+    [LWCELL_CMD_CPIN_CHANGE]            = "CPIN_CHANGE",
+    [LWCELL_CMD_CPIN_REMOVE]            = "CPIN_REMOVE",
+    [LWCELL_CMD_CPUK_SET]               = "CPUK_SET",
+    [LWCELL_CMD_CSQ_GET]                = "CSQ_GET",
+    [LWCELL_CMD_CFUN_SET]               = "CFUN_SET",
+    [LWCELL_CMD_CFUN_GET]               = "CFUN_GET",
+    [LWCELL_CMD_CREG_SET]               = "CREG_SET",
+    [LWCELL_CMD_CREG_GET]               = "CREG_GET",
+    [LWCELL_CMD_CBC]                    = "CBC",
+    [LWCELL_CMD_CNUM]                   = "CNUM",
+    [LWCELL_CMD_CPWD]                   = "CPWD",
+    [LWCELL_CMD_CR]                     = "CR",
+    [LWCELL_CMD_CRC]                    = "CRC",
+    [LWCELL_CMD_CRLP]                   = "CRLP",
+    [LWCELL_CMD_CRSM]                   = "CRSM",
+    [LWCELL_CMD_VTD]                    = "VTD",
+    [LWCELL_CMD_VTS]                    = "VTS",
+    [LWCELL_CMD_CMUX]                   = "CMUX",
+    [LWCELL_CMD_CPOL]                   = "CPOL",
+    [LWCELL_CMD_COPN]                   = "COPN",
+    [LWCELL_CMD_CCLK]                   = "CCLK",
+    [LWCELL_CMD_CSIM]                   = "CSIM",
+    [LWCELL_CMD_CALM]                   = "CALM",
+    [LWCELL_CMD_CALS]                   = "CALS",
+    [LWCELL_CMD_CRSL]                   = "CRSL",
+    [LWCELL_CMD_CLVL]                   = "CLVL",
+    [LWCELL_CMD_CMUT]                   = "CMUT",
+    [LWCELL_CMD_CPUC]                   = "CPUC",
+    [LWCELL_CMD_CCWE]                   = "CCWE",
+    [LWCELL_CMD_CUSD_SET]               = "CUSD_SET",
+    [LWCELL_CMD_CUSD_GET]               = "CUSD_GET",
+    [LWCELL_CMD_CUSD]                   = "CUSD",
+    [LWCELL_CMD_CSSN]                   = "CSSN",
+    [LWCELL_CMD_CIPMUX]                 = "CIPMUX",
+    [LWCELL_CMD_CIPSTART]               = "CIPSTART",
+    [LWCELL_CMD_CIPSEND]                = "CIPSEND",
+    [LWCELL_CMD_CIPQSEND]               = "CIPQSEND",
+    [LWCELL_CMD_CIPACK]                 = "CIPACK",
+    [LWCELL_CMD_CIPCLOSE]               = "CIPCLOSE",
+    [LWCELL_CMD_CIPSHUT]                = "CIPSHUT",
+    [LWCELL_CMD_CLPORT]                 = "CLPORT",
+    [LWCELL_CMD_CSTT]                   = "CSTT",
+    [LWCELL_CMD_CIICR]                  = "CIICR",
+    [LWCELL_CMD_CIFSR]                  = "CIFSR",
+    [LWCELL_CMD_CIPSTATUS]              = "CIPSTATUS",
+    [LWCELL_CMD_CDNSCFG]                = "CDNSCFG",
+    [LWCELL_CMD_CDNSGIP]                = "CDNSGIP",
+    [LWCELL_CMD_CIPHEAD]                = "CIPHEAD",
+    [LWCELL_CMD_CIPATS]                 = "CIPATS",
+    [LWCELL_CMD_CIPSPRT]                = "CIPSPRT",
+    [LWCELL_CMD_CIPSERVER]              = "CIPSERVER",
+    [LWCELL_CMD_CIPCSGP]                = "CIPCSGP",
+    [LWCELL_CMD_CIPSRIP]                = "CIPSRIP",
+    [LWCELL_CMD_CIPDPDP]                = "CIPDPDP",
+    [LWCELL_CMD_CIPMODE]                = "CIPMODE",
+    [LWCELL_CMD_CIPCCFG]                = "CIPCCFG",
+    [LWCELL_CMD_CIPSHOWTP]              = "CIPSHOWTP",
+    [LWCELL_CMD_CIPUDPMODE]             = "CIPUDPMODE",
+    [LWCELL_CMD_CIPRXGET]               = "CIPRXGET",
+    [LWCELL_CMD_CIPSCONT]               = "CIPSCONT",
+    [LWCELL_CMD_CIPRDTIMER]             = "CIPRDTIMER",
+    [LWCELL_CMD_CIPSGTXT]               = "CIPSGTXT",
+    [LWCELL_CMD_CIPTKA]                 = "CIPTKA",
+    [LWCELL_CMD_CIPSSL]                 = "CIPSSL",
+    [LWCELL_CMD_SMS_ENABLE]             = "SMS_ENABLE",
+    [LWCELL_CMD_CMGD]                   = "CMGD",
+    [LWCELL_CMD_CMGF]                   = "CMGF",
+    [LWCELL_CMD_CMGL]                   = "CMGL",
+    [LWCELL_CMD_CMGR]                   = "CMGR",
+    [LWCELL_CMD_CMGS]                   = "CMGS",
+    [LWCELL_CMD_CMGW]                   = "CMGW",
+    [LWCELL_CMD_CMSS]                   = "CMSS",
+    [LWCELL_CMD_CMGDA]                  = "CMGDA",
+    [LWCELL_CMD_CNMI]                   = "CNMI",
+    [LWCELL_CMD_CPMS_SET]               = "CPMS_SET",
+    [LWCELL_CMD_CPMS_GET]               = "CPMS_GET",
+    [LWCELL_CMD_CPMS_GET_OPT]           = "CPMS_GET_OPT",
+    [LWCELL_CMD_CRES]                   = "CRES",
+    [LWCELL_CMD_CSAS]                   = "CSAS",
+    [LWCELL_CMD_CSCA]                   = "CSCA",
+    [LWCELL_CMD_CSCB]                   = "CSCB",
+    [LWCELL_CMD_CSDH]                   = "CSDH",
+    [LWCELL_CMD_CSMP]                   = "CSMP",
+    [LWCELL_CMD_CSMS]                   = "CSMS",
+};
+
+/**
+ * \brief           Get command name as string
+ * \param[in]       cmd: Command to get name for
+ * \return          Command name without `LWCELL_CMD_` prefix or empty string for unknown command
+ */
 const char*
 lwcelli_dbg_msg_to_string(lwcell_cmd_t cmd) {
-    static char tmp_arr[100];
-    if (cmd) {
-        sprintf(tmp_arr, "%d", (int)cmd);
-        return tmp_arr;
+    if ((size_t)cmd < LWCELL_ARRAYSIZE(cmd_names) && cmd_names[cmd] != NULL) {
+        return cmd_names[cmd];
     }
     return "";
 }
 
-#endif /* LWCELL_CFG_DBG || __DOXYGEN__ */
+#endif /* LWCELL_CFG_DBG || LWCELL_CFG_CMD_STATS || __DOXYGEN__ */
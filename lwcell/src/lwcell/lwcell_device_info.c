@@ -137,3 +137,22 @@ lwcell_device_get_serial_number(char* serial, size_t len, const lwcell_api_cmd_e
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
+
+/**
+ * \brief           Get device limits selected from device model
+ *
+ * Values are limited by \ref LWCELL_CFG_MAX_CONNS and \ref LWCELL_CFG_CONN_MAX_DATA_LEN
+ * and fall back to them until device is identified, or when device is unknown.
+ *
+ * \param[out]      limits: Structure to copy limits to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_device_get_limits(lwcell_device_limits_t* limits) {
+    LWCELL_ASSERT(limits != NULL);
+
+    lwcell_core_lock();
+    *limits = lwcell.m.limits;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
@@ -34,17 +34,59 @@
 #include "lwcell/lwcell_evt.h"
 #include "lwcell/lwcell_private.h"
 
+#if LWCELL_CFG_EVT_MASK || __DOXYGEN__
+
 /**
- * \brief           Register callback function for global (non-connection based) events
+ * \brief           Rebuild per-type dispatch table from registered callback list
+ * \note            On memory failure table is removed
+ *                  and \ref lwcelli_send_cb walks the list with mask check instead
+ */
+static void
+prv_evt_dispatch_build(void) {
+    lwcell_evt_func_t* func;
+    lwcell_evt_fn* disp;
+    size_t cnt = 0, idx = 0;
+
+    for (func = lwcell.evt_func; func != NULL; func = func->next) {
+        for (size_t type = 0; type < LWCELL_EVT_END; ++type) {
+            cnt += (func->mask & LWCELL_EVT_MASK(type)) != 0;
+        }
+    }
+    disp = lwcell_mem_malloc(LWCELL_MAX(cnt, 1) * sizeof(*disp));
+    lwcell_mem_free_s((void**)&lwcell.evt_disp);
+    if (disp == NULL) {
+        return;
+    }
+
+    /* Group callbacks by type, keep registration order within each type */
+    for (size_t type = 0; type < LWCELL_EVT_END; ++type) {
+        lwcell.evt_disp_idx[type] = (uint16_t)idx;
+        for (func = lwcell.evt_func; func != NULL; func = func->next) {
+            if (func->mask & LWCELL_EVT_MASK(type)) {
+                disp[idx++] = func->fn;
+            }
+        }
+    }
+    lwcell.evt_disp_idx[LWCELL_EVT_END] = (uint16_t)idx;
+    lwcell.evt_disp = disp;
+}
+
+#endif /* LWCELL_CFG_EVT_MASK || __DOXYGEN__ */
+
+/**
+ * \brief           Add callback function to the end of the list
  * \param[in]       fn: Callback function to call on specific event
+ * \param[in]       mask: Subscribed event types
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
-lwcellr_t
-lwcell_evt_register(lwcell_evt_fn fn) {
+static lwcellr_t
+prv_evt_register(lwcell_evt_fn fn, lwcell_evt_mask_t mask) {
     lwcellr_t res = lwcellOK;
     lwcell_evt_func_t *func, *new_func;
 
-    LWCELL_ASSERT(fn != NULL);
+#if !LWCELL_CFG_EVT_MASK
+    LWCELL_UNUSED(mask);
+#endif /* !LWCELL_CFG_EVT_MASK */
 
     lwcell_core_lock();
 
@@ -61,10 +103,16 @@ lwcell_evt_register(lwcell_evt_fn fn) {
         if (new_func != NULL) {
             LWCELL_MEMSET(new_func, 0x00, sizeof(*new_func));
             new_func->fn = fn; /* Set function pointer */
+#if LWCELL_CFG_EVT_MASK
+            new_func->mask = mask; /* Set subscribed events */
+#endif                             /* LWCELL_CFG_EVT_MASK */
             for (func = lwcell.evt_func; func != NULL && func->next != NULL; func = func->next) {}
             if (func != NULL) {
                 func->next = new_func; /* Set new function as next */
                 res = lwcellOK;
+#if LWCELL_CFG_EVT_MASK
+                prv_evt_dispatch_build();
+#endif /* LWCELL_CFG_EVT_MASK */
             } else {
                 lwcell_mem_free_s((void**)&new_func);
                 res = lwcellERRMEM;
@@ -77,6 +125,42 @@ lwcell_evt_register(lwcell_evt_fn fn) {
     return res;
 }
 
+/**
+ * \brief           Register callback function for global (non-connection based) events
+ * \param[in]       fn: Callback function to call on specific event
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_evt_register(lwcell_evt_fn fn) {
+    LWCELL_ASSERT(fn != NULL);
+
+    return prv_evt_register(fn, LWCELL_EVT_MASK_ALL);
+}
+
+#if LWCELL_CFG_EVT_MASK || __DOXYGEN__
+
+/**
+ * \brief           Register callback function for selected global events only
+ *
+ * Callback is not called for event types missing in the mask,
+ * such as periodic \ref LWCELL_EVT_KEEP_ALIVE or connection data events.
+ *
+ * \note            Function is available when \ref LWCELL_CFG_EVT_MASK is enabled
+ * \param[in]       fn: Callback function to call on specific event
+ * \param[in]       mask: Bitwise OR of \ref LWCELL_EVT_MASK values of events to receive,
+ *                      or \ref LWCELL_EVT_MASK_ALL for all events
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_evt_register_mask(lwcell_evt_fn fn, lwcell_evt_mask_t mask) {
+    LWCELL_ASSERT(fn != NULL);
+    LWCELL_ASSERT(mask > 0);
+
+    return prv_evt_register(fn, mask);
+}
+
+#endif /* LWCELL_CFG_EVT_MASK || __DOXYGEN__ */
+
 /**
  * \brief           Unregister callback function for global (non-connection based) events
  * \note            Function must be first registered using \ref lwcell_evt_register
@@ -93,6 +177,9 @@ lwcell_evt_unregister(lwcell_evt_fn fn) {
         if (func->fn == fn) {
             prev->next = func->next;
             lwcell_mem_free_s((void**)&func);
+#if LWCELL_CFG_EVT_MASK
+            prv_evt_dispatch_build();
+#endif /* LWCELL_CFG_EVT_MASK */
             break;
         }
     }
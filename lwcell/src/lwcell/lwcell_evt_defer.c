@@ -0,0 +1,301 @@
+/**
+ * \file            lwcell_evt_defer.c
+ * \brief           Deferred event dispatch
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_evt_defer.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_EVT_DEFER || __DOXYGEN__
+
+/**
+ * \brief           Event waiting in worker queue
+ */
+typedef struct {
+    lwcell_evt_fn fn; /*!< Callback function to call */
+    lwcell_evt_t evt; /*!< Copy of event data */
+    uint32_t time;    /*!< Time when event was queued */
+    int16_t conn_num; /*!< Connection slot reserved until delivery, `-1` for global event */
+
+    union {
+        lwcell_operator_curr_t operator_current; /*!< Current operator, at the time event was queued */
+#if LWCELL_CFG_CALL
+        lwcell_call_t call; /*!< Call information, at the time event was queued */
+#endif                      /* LWCELL_CFG_CALL */
+    } state;                /*!< Copy of library state event points to, as it may change before delivery */
+} lwcell_evt_defer_entry_t;
+
+static lwcell_sys_mbox_t defer_mbox[LWCELL_CFG_EVT_DEFER_THREADS];
+static lwcell_sys_thread_t defer_thread[LWCELL_CFG_EVT_DEFER_THREADS];
+static lwcell_evt_func_t* defer_exclude; /* Callback functions always called synchronously */
+static lwcell_evt_defer_stats_t defer_stats;
+#if LWCELL_CFG_CONN
+static uint16_t defer_conn_pending[LWCELL_CFG_MAX_CONNS]; /* Number of queued events for each connection slot */
+#endif                                                    /* LWCELL_CFG_CONN */
+
+/**
+ * \brief           Worker thread delivering queued events
+ * \param[in]       arg: Message queue of the thread
+ */
+static void
+prv_evt_defer_thread(void* const arg) {
+    lwcell_sys_mbox_t* mbox = arg;
+    lwcell_evt_defer_entry_t* entry;
+    uint32_t latency;
+
+    while (1) {
+        lwcell_sys_mbox_get(mbox, (void**)&entry, 0);
+        latency = lwcell_sys_now() - entry->time;
+
+        entry->fn(&entry->evt); /* Call user callback, without core lock */
+
+        lwcell_core_lock();
+        --defer_stats.pending;
+        ++defer_stats.delivered;
+        defer_stats.latency_sum += latency;
+        if (latency > defer_stats.latency_max) {
+            defer_stats.latency_max = latency;
+        }
+#if LWCELL_CFG_CONN
+        if (entry->evt.type == LWCELL_EVT_CONN_RECV) {
+            lwcell_pbuf_free(entry->evt.evt.conn_data_recv.buff); /* Release reference taken when queued */
+        }
+        if (entry->conn_num >= 0) {
+            --defer_conn_pending[entry->conn_num]; /* Slot may be used for new connection again */
+        }
+#endif /* LWCELL_CFG_CONN */
+        lwcell_mem_free_s((void**)&entry);
+        lwcell_core_unlock();
+    }
+}
+
+/**
+ * \brief           Check if event can be delivered from worker thread
+ *
+ * Events pointing to memory of application or API call, such as entry arrays
+ * or host name, are only valid until the command finishes and are never deferred
+ *
+ * \param[in]       type: Event type
+ * \return          `1` if event can be queued, `0` otherwise
+ */
+static uint8_t
+prv_is_deferrable(lwcell_evt_type_t type) {
+    switch (type) {
+        case LWCELL_EVT_OPERATOR_SCAN:
+#if LWCELL_CFG_CONN
+        case LWCELL_EVT_CONN_ERROR:
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_SMS
+        case LWCELL_EVT_SMS_READ:
+        case LWCELL_EVT_SMS_LIST:
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_PHONEBOOK
+        case LWCELL_EVT_PB_LIST:
+        case LWCELL_EVT_PB_SEARCH:
+#endif /* LWCELL_CFG_PHONEBOOK */
+            return 0;
+        default: return 1;
+    }
+}
+
+/**
+ * \brief           Create worker queues and threads
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_evt_defer_init(void) {
+    for (size_t i = 0; i < LWCELL_CFG_EVT_DEFER_THREADS; ++i) {
+        if (lwcell_sys_mbox_isvalid(&defer_mbox[i])) {
+            continue; /* Already created on previous init */
+        }
+        if (!lwcell_sys_mbox_create(&defer_mbox[i], LWCELL_CFG_EVT_DEFER_QUEUE_LEN)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                          "[LWCELL EVT] Cannot allocate deferred event mbox queue!\r\n");
+            return 0;
+        }
+        if (!lwcell_sys_thread_create(&defer_thread[i], "lwcell_evt", prv_evt_defer_thread, &defer_mbox[i],
+                                      LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                          "[LWCELL EVT] Cannot create deferred event thread!\r\n");
+            lwcell_sys_mbox_delete(&defer_mbox[i]);
+            lwcell_sys_mbox_invalid(&defer_mbox[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Queue current event for callback function to worker thread
+ * \note            Function must be called with core locked, event prepared in `lwcell.evt`
+ * \param[in]       fn: Callback function to call
+ * \param[in]       conn: Connection of the event, or `NULL` for global event
+ * \return          `1` if event has been queued, `0` if caller must call function synchronously
+ */
+uint8_t
+lwcelli_evt_defer(lwcell_evt_fn fn, lwcell_conn_t* conn) {
+    lwcell_evt_defer_entry_t* entry;
+    lwcell_sys_mbox_t* mbox;
+
+    mbox = &defer_mbox[conn != NULL ? (conn->num % LWCELL_CFG_EVT_DEFER_THREADS) : 0];
+    if (!lwcell_sys_mbox_isvalid(mbox) || !prv_is_deferrable(lwcell.evt.type)) {
+        return 0;
+    }
+    for (lwcell_evt_func_t* func = defer_exclude; func != NULL; func = func->next) {
+        if (func->fn == fn) {
+            return 0;
+        }
+    }
+
+    entry = lwcell_mem_malloc(sizeof(*entry));
+    if (entry == NULL) {
+        ++defer_stats.full;
+        return 0;
+    }
+    entry->fn = fn;
+    entry->time = lwcell_sys_now();
+    entry->conn_num = -1;
+    LWCELL_MEMCPY(&entry->evt, &lwcell.evt, sizeof(entry->evt));
+
+    /* Event must not point to library state, which processing thread modifies before delivery */
+    switch (entry->evt.type) {
+        case LWCELL_EVT_NETWORK_OPERATOR_CURRENT: {
+            entry->state.operator_current = *lwcell.evt.evt.operator_current.operator_current;
+            entry->evt.evt.operator_current.operator_current = &entry->state.operator_current;
+            break;
+        }
+#if LWCELL_CFG_CALL
+        case LWCELL_EVT_CALL_CHANGED: {
+            entry->state.call = *lwcell.evt.evt.call_changed.call;
+            entry->evt.evt.call_changed.call = &entry->state.call;
+            break;
+        }
+#endif /* LWCELL_CFG_CALL */
+        default: break;
+    }
+#if LWCELL_CFG_CONN
+    if (entry->evt.type == LWCELL_EVT_CONN_RECV) {
+        lwcell_pbuf_ref(entry->evt.evt.conn_data_recv.buff); /* Worker holds reference until callback returns */
+    }
+#endif /* LWCELL_CFG_CONN */
+    if (!lwcell_sys_mbox_putnow(mbox, entry)) {
+#if LWCELL_CFG_CONN
+        if (entry->evt.type == LWCELL_EVT_CONN_RECV) {
+            lwcell_pbuf_free(entry->evt.evt.conn_data_recv.buff);
+        }
+#endif /* LWCELL_CFG_CONN */
+        lwcell_mem_free_s((void**)&entry);
+        ++defer_stats.full;
+        return 0;
+    }
+#if LWCELL_CFG_CONN
+    if (conn != NULL) {
+        /* Connection handle in event stays valid, slot is not reused until event is delivered */
+        entry->conn_num = LWCELL_I16(conn - lwcell.m.conns);
+        ++defer_conn_pending[entry->conn_num];
+    }
+#endif /* LWCELL_CFG_CONN */
+    ++defer_stats.queued;
+    if (++defer_stats.pending > defer_stats.pending_max) {
+        defer_stats.pending_max = defer_stats.pending;
+    }
+    return 1;
+}
+
+#if LWCELL_CFG_CONN || __DOXYGEN__
+
+/**
+ * \brief           Check if connection slot has events waiting for delivery
+ * \note            Function must be called with core locked
+ * \param[in]       num: Connection number
+ * \return          `1` if slot must not be used for new connection yet, `0` otherwise
+ */
+uint8_t
+lwcelli_evt_defer_conn_pending(size_t num) {
+    return defer_conn_pending[num] > 0;
+}
+
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+/**
+ * \brief           Exclude callback function from deferred dispatch
+ *
+ * Function is always called synchronously on processing thread, with core locked.
+ * Use it for callbacks which must act before library continues,
+ * or which share state with other code protected by core lock.
+ *
+ * \param[in]       fn: Global or connection callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_evt_defer_exclude(lwcell_evt_fn fn) {
+    lwcellr_t res = lwcellOK;
+    lwcell_evt_func_t* func;
+
+    LWCELL_ASSERT(fn != NULL);
+
+    lwcell_core_lock();
+    for (func = defer_exclude; func != NULL; func = func->next) {
+        if (func->fn == fn) {
+            break;
+        }
+    }
+    if (func == NULL) {
+        func = lwcell_mem_malloc(sizeof(*func));
+        if (func != NULL) {
+            LWCELL_MEMSET(func, 0x00, sizeof(*func));
+            func->fn = fn;
+            func->next = defer_exclude;
+            defer_exclude = func;
+        } else {
+            res = lwcellERRMEM;
+        }
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get deferred dispatch statistics
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_evt_defer_get_stats(lwcell_evt_defer_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(stats, &defer_stats, sizeof(*stats));
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_EVT_DEFER || __DOXYGEN__ */
@@ -0,0 +1,129 @@
+/**
+ * \file            lwcell_flow.c
+ * \brief           Hardware flow control and receive error accounting
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_flow.h"
+#include "lwcell/lwcell_buff.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_FLOW_CONTROL || __DOXYGEN__
+
+/* Buffer levels in units of bytes, usable size is one byte less than buffer size */
+#define FLOW_HIGH_WATER (((size_t)LWCELL_CFG_RCV_BUFF_SIZE - 1) * LWCELL_CFG_FLOW_CONTROL_HIGH_WATER / 100)
+#define FLOW_LOW_WATER  (((size_t)LWCELL_CFG_RCV_BUFF_SIZE - 1) * LWCELL_CFG_FLOW_CONTROL_LOW_WATER / 100)
+
+/* Counters are written from low-level interrupt context, without core lock */
+static volatile lwcell_flow_stats_t flow_stats;
+
+/**
+ * \brief           Device replied to flow control settings in reset sequence
+ * \note            Function must be called with core locked
+ * \param[in]       is_enabled: Set to `1` when device accepted settings
+ */
+void
+lwcelli_flow_enabled(uint8_t is_enabled) {
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING, !is_enabled,
+                  "[LWCELL FLOW] Device did not accept hardware flow control\r\n");
+    flow_stats.is_enabled = is_enabled;
+}
+
+#if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
+
+/**
+ * \brief           Account data written to input buffer and pause device at high-water mark
+ * \note            Function is called from \ref lwcell_input, possibly from interrupt context
+ * \param[in]       written: Number of bytes written to buffer
+ * \param[in]       len: Number of received bytes
+ */
+void
+lwcelli_flow_input(size_t written, size_t len) {
+    size_t full = lwcell_buff_get_full(&lwcell.buff);
+
+    if (written < len) {
+        flow_stats.dropped += LWCELL_U32(len - written);
+    }
+    if (full > flow_stats.buff_max) {
+        flow_stats.buff_max = full;
+    }
+    if (!flow_stats.is_paused && full >= FLOW_HIGH_WATER && lwcell.ll.rts_fn != NULL) {
+        flow_stats.is_paused = 1;
+        ++flow_stats.pauses;
+        lwcell.ll.rts_fn(0);
+    }
+}
+
+/**
+ * \brief           Resume paused device once input buffer drained below low-water mark
+ *
+ * Processing thread is woken up after every write to input buffer,
+ * so pause set during processing is always checked again
+ *
+ * \note            Function is called from processing thread
+ */
+void
+lwcelli_flow_processed(void) {
+    if (flow_stats.is_paused && lwcell_buff_get_full(&lwcell.buff) <= FLOW_LOW_WATER) {
+        flow_stats.is_paused = 0;
+        lwcell.ll.rts_fn(1);
+    }
+}
+
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
+
+/**
+ * \brief           Report receive error detected by UART
+ * \note            Function may be called from interrupt context
+ * \param[in]       err: Error type
+ */
+void
+lwcell_flow_rx_error(lwcell_flow_err_t err) {
+    if (err < LWCELL_FLOW_ERR_END) {
+        ++flow_stats.errors[err];
+    }
+}
+
+/**
+ * \brief           Get flow control statistics
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_flow_get_stats(lwcell_flow_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(stats, (const void*)&flow_stats, sizeof(*stats));
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_FLOW_CONTROL || __DOXYGEN__ */
@@ -35,9 +35,6 @@
 #include "lwcell/lwcell_buff.h"
 #include "lwcell/lwcell_private.h"
 
-static uint32_t lwcell_recv_total_len;
-static uint32_t lwcell_recv_calls;
-
 #if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
 
 /**
@@ -52,10 +49,15 @@ lwcell_input(const void* data, size_t len) {
     if (!lwcell.status.f.initialized || lwcell.buff.buff == NULL) {
         return lwcellERR;
     }
-    lwcell_buff_write(&lwcell.buff, data, len);         /* Write data to buffer */
-    lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL); /* Write empty box, don't care if write fails */
-    lwcell_recv_total_len += len;                       /* Update total number of received bytes */
-    ++lwcell_recv_calls;                                /* Update number of calls */
+#if LWCELL_CFG_FLOW_CONTROL
+    lwcelli_flow_input(lwcell_buff_write(&lwcell.buff, data, len), len); /* Pause device when buffer is full */
+#else                                                                     /* LWCELL_CFG_FLOW_CONTROL */
+    lwcell_buff_write(&lwcell.buff, data, len); /* Write data to buffer */
+#endif                                                                    /* !LWCELL_CFG_FLOW_CONTROL */
+    LWCELL_METRICS_RX(len);
+
+    lwcelli_process_wakeup(); /* Wake up process thread */
+    LWCELL_TRACE(MBOX_PROCESS_PUT, len, 0, 0, 0);
     return lwcellOK;
 }
 
@@ -82,10 +84,12 @@ lwcell_input_process(const void* data, size_t len) {
         return lwcellERR;
     }
 
-    lwcell_recv_total_len += len; /* Update total number of received bytes */
-    ++lwcell_recv_calls;          /* Update number of calls */
+    LWCELL_METRICS_RX(len);
 
     lwcell_core_lock();
+#if LWCELL_CFG_CAPTURE
+    lwcelli_capture(LWCELL_CAPTURE_DIR_RX, data, len);
+#endif                                /* LWCELL_CFG_CAPTURE */
     res = lwcelli_process(data, len); /* Process input data */
     lwcell_core_unlock();
     return res;
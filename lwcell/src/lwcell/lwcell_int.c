@@ -69,11 +69,17 @@ typedef struct {
 #define RECV_IDX(index)             recv_buff.data[index]
 
 /* Send data over AT port */
-#define AT_PORT_SEND_STR(str)       lwcell.ll.send_fn((const void*)(str), (size_t)strlen(str))
-#define AT_PORT_SEND_CONST_STR(str) lwcell.ll.send_fn((const void*)(str), (size_t)(sizeof(str) - 1))
-#define AT_PORT_SEND_CHR(ch)        lwcell.ll.send_fn((const void*)(ch), (size_t)1)
-#define AT_PORT_SEND_FLUSH()        lwcell.ll.send_fn(NULL, 0)
-#define AT_PORT_SEND(d, l)          lwcell.ll.send_fn((const void*)(d), (size_t)(l))
+#if LWCELL_CFG_CAPTURE || LWCELL_CFG_METRICS || LWCELL_CFG_CMUX
+#define AT_PORT_SEND_FN lwcelli_at_port_send
+#else /* LWCELL_CFG_CAPTURE || LWCELL_CFG_METRICS || LWCELL_CFG_CMUX */
+#define AT_PORT_SEND_FN lwcell.ll.send_fn
+#endif /* !(LWCELL_CFG_CAPTURE || LWCELL_CFG_METRICS || LWCELL_CFG_CMUX) */
+
+#define AT_PORT_SEND_STR(str)       AT_PORT_SEND_FN((const void*)(str), (size_t)strlen(str))
+#define AT_PORT_SEND_CONST_STR(str) AT_PORT_SEND_FN((const void*)(str), (size_t)(sizeof(str) - 1))
+#define AT_PORT_SEND_CHR(ch)        AT_PORT_SEND_FN((const void*)(ch), (size_t)1)
+#define AT_PORT_SEND_FLUSH()        AT_PORT_SEND_FN(NULL, 0)
+#define AT_PORT_SEND(d, l)          AT_PORT_SEND_FN((const void*)(d), (size_t)(l))
 #define AT_PORT_SEND_WITH_FLUSH(d, l)                                                                                  \
     do {                                                                                                               \
         AT_PORT_SEND((d), (l));                                                                                        \
@@ -81,6 +87,24 @@ typedef struct {
     } while (0)
 
 /* Beginning and end of every AT command */
+#if LWCELL_CFG_AT_BATCH
+/* Commands of the batch, except the first and the last one, are separated with semicolon on the same line */
+#define AT_PORT_SEND_BEGIN_AT()                                                                                        \
+    do {                                                                                                               \
+        if (batch.cmds != NULL && batch.pos > 0) {                                                                     \
+            AT_PORT_SEND_CONST_STR(";");                                                                               \
+        } else {                                                                                                       \
+            AT_PORT_SEND_CONST_STR("AT");                                                                              \
+        }                                                                                                              \
+    } while (0)
+#define AT_PORT_SEND_END_AT()                                                                                          \
+    do {                                                                                                               \
+        if (batch.cmds == NULL || batch.pos + 1 == batch.len) {                                                        \
+            AT_PORT_SEND(CRLF, CRLF_LEN);                                                                              \
+            AT_PORT_SEND(NULL, 0);                                                                                     \
+        }                                                                                                              \
+    } while (0)
+#else /* LWCELL_CFG_AT_BATCH */
 #define AT_PORT_SEND_BEGIN_AT()                                                                                        \
     do {                                                                                                               \
         AT_PORT_SEND_CONST_STR("AT");                                                                                  \
@@ -90,6 +114,7 @@ typedef struct {
         AT_PORT_SEND(CRLF, CRLF_LEN);                                                                                  \
         AT_PORT_SEND(NULL, 0);                                                                                         \
     } while (0)
+#endif /* !LWCELL_CFG_AT_BATCH */
 
 /* Send special characters over AT port with condition */
 #define AT_PORT_SEND_QUOTE_COND(q)                                                                                     \
@@ -114,10 +139,609 @@ typedef struct {
 /* Send special characters */
 #define AT_PORT_SEND_CTRL_Z() AT_PORT_SEND_STR("\x1A")
 #define AT_PORT_SEND_ESC()    AT_PORT_SEND_STR("\x1B")
+
+/* Reset sequence step after error reporting setup, flow control is enabled only when lines are connected */
+#if LWCELL_CFG_FLOW_CONTROL
+#define RESET_CMD_AFTER_CMEE (lwcell.ll.uart.flow_control ? LWCELL_CMD_IFC_SET : LWCELL_CMD_CGMI_GET)
+#else /* LWCELL_CFG_FLOW_CONTROL */
+#define RESET_CMD_AFTER_CMEE LWCELL_CMD_CGMI_GET
+#endif /* !LWCELL_CFG_FLOW_CONTROL */
 #endif /* !__DOXYGEN__ */
 
 static lwcell_recv_t recv_buff;
+static uint8_t ch_prev1, ch_prev2;
+static lwcell_unicode_t unicode;
 static lwcellr_t lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat);
+static void prv_process(const void* data, size_t data_len);
+
+#if LWCELL_CFG_CMUX
+/**
+ * \brief           Processing context of multiplexer channel
+ *
+ * Context of selected channel lives in global stack structure and parser variables,
+ * contexts of other channels are kept here
+ */
+typedef struct {
+    lwcell_msg_t* msg;        /*!< Message executed on channel */
+    lwcell_recv_t recv;       /*!< Received line */
+    lwcell_unicode_t unicode; /*!< Unicode decoding state */
+    uint8_t ch_prev1;         /*!< Previously received character */
+    uint8_t ch_prev2;         /*!< Character received before previous one */
+#if LWCELL_CFG_CONN
+    lwcell_ipd_t ipd; /*!< Connection data reading state */
+#endif                /* LWCELL_CFG_CONN */
+} lwcell_channel_t;
+
+static lwcell_channel_t channels[LWCELL_CMUX_CH_END];
+static uint8_t channel_cur; /*!< Selected channel, control channel whenever core is not processing other one */
+
+/**
+ * \brief           Select processing context of multiplexer channel
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel to select, member of \ref lwcell_cmux_ch_t
+ * \return          Previously selected channel, to be selected again when done
+ */
+uint8_t
+lwcelli_channel_select(uint8_t ch) {
+    uint8_t prev = channel_cur;
+    lwcell_channel_t* c;
+
+    if (ch == prev) {
+        return prev;
+    }
+
+    /* Save context of selected channel */
+    c = &channels[prev];
+    c->msg = lwcell.msg;
+    LWCELL_MEMCPY(&c->recv, &recv_buff, sizeof(recv_buff));
+    c->unicode = unicode;
+    c->ch_prev1 = ch_prev1;
+    c->ch_prev2 = ch_prev2;
+#if LWCELL_CFG_CONN
+    c->ipd = lwcell.m.ipd;
+#endif /* LWCELL_CFG_CONN */
+
+    /* Load context of new channel */
+    c = &channels[ch];
+    lwcell.msg = c->msg;
+    LWCELL_MEMCPY(&recv_buff, &c->recv, sizeof(recv_buff));
+    unicode = c->unicode;
+    ch_prev1 = c->ch_prev1;
+    ch_prev2 = c->ch_prev2;
+#if LWCELL_CFG_CONN
+    lwcell.m.ipd = c->ipd;
+#endif /* LWCELL_CFG_CONN */
+    channel_cur = ch;
+    return prev;
+}
+
+/**
+ * \brief           Reset processing context of channels other than control channel
+ *
+ * Command active on data channel is finished with error, as it cannot complete anymore
+ *
+ * \note            Function must be called with core locked and control channel selected
+ */
+void
+lwcelli_channel_reset(void) {
+    lwcell_msg_t* msg = channels[LWCELL_CMUX_CH_DATA].msg;
+
+    if (msg != NULL && !msg->is_done) {
+        msg->res = lwcellERR;
+        msg->is_done = 1;
+        lwcell_sys_sem_release(&lwcell.sem_sync_data);
+    }
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(channels); ++i) {
+        if (i != channel_cur) {
+            msg = channels[i].msg;
+            LWCELL_MEMSET(&channels[i], 0x00, sizeof(channels[i]));
+            channels[i].msg = msg; /* Producer thread finishes message itself */
+        }
+    }
+}
+
+/**
+ * \brief           Get message executed on channel
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t
+ * \return          Message handle or `NULL` if channel is idle
+ */
+lwcell_msg_t*
+lwcelli_channel_msg(uint8_t ch) {
+    return ch == channel_cur ? lwcell.msg : channels[ch].msg;
+}
+
+#define CHANNEL_CUR() channel_cur
+#else /* LWCELL_CFG_CMUX */
+#define CHANNEL_CUR() 0
+#endif /* !LWCELL_CFG_CMUX */
+
+#if LWCELL_CFG_AT_BATCH
+/* Sub-command sequences sent as single command line. Only last command may have side effects in sub-command processing */
+static const lwcell_cmd_t batch_device_info[] = {LWCELL_CMD_CGMI_GET, LWCELL_CMD_CGMM_GET, LWCELL_CMD_CGSN_GET,
+                                                 LWCELL_CMD_CGMR_GET};
+static const lwcell_cmd_t batch_reg_sim[] = {LWCELL_CMD_CREG_SET, LWCELL_CMD_CLCC_SET, LWCELL_CMD_CPIN_GET};
+
+static struct {
+    const lwcell_cmd_t* cmds; /*!< Commands of active batch, `NULL` when no batch is active */
+    uint8_t len;              /*!< Number of commands in active batch */
+    uint8_t pos;              /*!< Index of command being sent or command whose response is expected */
+    uint8_t disabled;         /*!< Set to `1` when device rejected batched line, commands are sent one by one */
+} batch;
+
+/**
+ * \brief           Send sub-command, combined with the rest of its batch when it starts one
+ * \param[in]       msg: Message with new sub-command already set
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_batch_send(lwcell_msg_t* msg) {
+    lwcellr_t res;
+
+    if (!batch.disabled) {
+        if (msg->cmd == batch_device_info[0]) {
+            batch.cmds = batch_device_info;
+            batch.len = LWCELL_U8(LWCELL_ARRAYSIZE(batch_device_info));
+        } else if (msg->cmd == batch_reg_sim[0]) {
+            batch.cmds = batch_reg_sim;
+            batch.len = LWCELL_U8(LWCELL_ARRAYSIZE(batch_reg_sim));
+        }
+    }
+    if (batch.cmds == NULL) {
+        return msg->fn(msg);
+    }
+    for (batch.pos = 0, res = lwcellOK; res == lwcellOK && batch.pos < batch.len; ++batch.pos) {
+        msg->cmd = batch.cmds[batch.pos];
+        res = msg->fn(msg);
+    }
+    batch.pos = 0;
+    msg->cmd = batch.cmds[0]; /* First response belongs to first command */
+    if (res != lwcellOK) {
+        batch.cmds = NULL;
+    }
+    return res;
+}
+
+/**
+ * \brief           Route next response line to next command of active batch
+ */
+static void
+prv_batch_next(void) {
+    if (batch.cmds != NULL && batch.pos + 1 < batch.len) {
+        lwcell.msg->cmd = batch.cmds[++batch.pos];
+    }
+}
+
+/**
+ * \brief           Finish active batch on final response
+ *
+ * On success, sequence continues after the last command of the batch.
+ * When device rejected combined line, batching is disabled and batch is repeated command by command
+ *
+ * \param[in]       msg: Current message
+ * \param[in,out]   stat: Status of final response
+ * \param[out]      n_cmd: Command to send next
+ * \return          `1` when batch is repeated and sequence processing must be skipped, `0` otherwise
+ */
+static uint8_t
+prv_batch_finish(lwcell_msg_t* msg, lwcell_status_flags_t* stat, lwcell_cmd_t* n_cmd) {
+    const lwcell_cmd_t* cmds = batch.cmds;
+
+    if (cmds == NULL) {
+        return 0;
+    }
+    batch.cmds = NULL;
+    if (stat->is_error) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL BATCH] Batched command line rejected, sending commands one by one\r\n");
+        batch.disabled = 1;
+        stat->is_error = 0;
+        *n_cmd = cmds[0];
+        return 1;
+    }
+    msg->cmd = cmds[batch.len - 1];
+    return 0;
+}
+#endif /* LWCELL_CFG_AT_BATCH */
+
+#if LWCELL_CFG_RESET_WARM_START
+static struct {
+    uint8_t active;    /*!< Set to `1` when device answered settings query and sequence skips matching settings */
+    uint8_t echo_seen; /*!< Set to `1` when settings query was echoed by device */
+    uint8_t echo;      /*!< Set to `1` when echo mode matches configuration */
+    uint8_t cfun;      /*!< Set to `1` when device is in full functionality mode */
+    uint8_t cmee;      /*!< Set to `1` when detailed error reporting is enabled */
+    uint8_t creg;      /*!< Set to `1` when network registration indication is enabled */
+} warm;
+
+/**
+ * \brief           Parse response line to settings query
+ * \param[in]       rcv: Received line
+ */
+static void
+prv_warm_parse(const lwcell_recv_t* rcv) {
+    const char* str = &rcv->data[7];
+
+    if (!strncmp(rcv->data, "AT+CFUN?", 8)) {
+        warm.echo_seen = 1;
+    } else if (!strncmp(rcv->data, "+CFUN: ", 7)) {
+        warm.cfun = lwcelli_parse_number(&str) == 1;
+    } else if (!strncmp(rcv->data, "+CMEE: ", 7)) {
+        warm.cmee = lwcelli_parse_number(&str) == 1;
+    } else if (!strncmp(rcv->data, "+CREG: ", 7)) {
+        warm.creg = lwcelli_parse_number(&str) == 1;
+    }
+}
+
+/**
+ * \brief           Skip reset sequence settings device kept from before
+ * \param[in]       cmd: Next command of reset sequence
+ * \return          First command of reset sequence that has to be sent
+ */
+static lwcell_cmd_t
+prv_warm_skip(lwcell_cmd_t cmd) {
+    while (warm.active) {
+        switch (cmd) {
+            case LWCELL_CMD_ATE0:
+            case LWCELL_CMD_ATE1: {
+                if (!warm.echo) {
+                    return cmd;
+                }
+                cmd = LWCELL_CMD_CFUN_SET;
+                break;
+            }
+            case LWCELL_CMD_CFUN_SET: {
+                if (!warm.cfun) {
+                    return cmd;
+                }
+                cmd = LWCELL_CMD_CMEE_SET;
+                break;
+            }
+            case LWCELL_CMD_CMEE_SET: {
+                if (!warm.cmee) {
+                    return cmd;
+                }
+                cmd = RESET_CMD_AFTER_CMEE;
+                break;
+            }
+            case LWCELL_CMD_CREG_SET: {
+                if (!warm.creg) {
+                    return cmd;
+                }
+                cmd = LWCELL_CMD_CLCC_SET;
+                break;
+            }
+            default: return cmd;
+        }
+    }
+    return cmd;
+}
+#endif /* LWCELL_CFG_RESET_WARM_START */
+
+static struct {
+    lwcell_cmd_t cmd; /*!< Command to continue with once delay expires */
+    uint32_t ms;      /*!< Delay in units of milliseconds */
+    uint8_t reset_hw; /*!< Hardware reset step, `1` when reset is asserted, `2` when released */
+} cmd_delay;
+
+/**
+ * \brief           Continue command sequence after delay, without blocking processing
+ * \param[in]       cmd: Command to continue with
+ * \param[in]       ms: Delay in units of milliseconds
+ * \return          \ref LWCELL_CMD_DELAY to set as next command
+ */
+static lwcell_cmd_t
+prv_cmd_delay(lwcell_cmd_t cmd, uint32_t ms) {
+    cmd_delay.cmd = cmd;
+    cmd_delay.ms = ms;
+    return LWCELL_CMD_DELAY;
+}
+
+/**
+ * \brief           Delay before next command of sequence has expired
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_cmd_delay_fn(void* arg) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    LWCELL_UNUSED(arg);
+    if (msg != NULL && !msg->is_done && CMD_IS_CUR(LWCELL_CMD_DELAY)) {
+        msg->cmd = cmd_delay.cmd;
+#if LWCELL_CFG_AT_BATCH
+        prv_batch_send(msg); /* On failure, message finishes on its timeout */
+#else                        /* LWCELL_CFG_AT_BATCH */
+        msg->fn(msg); /* On failure, message finishes on its timeout */
+#endif                       /* !LWCELL_CFG_AT_BATCH */
+    }
+}
+
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+static struct {
+    uint32_t target;     /*!< Baudrate requested from device */
+    lwcell_cmd_t resume; /*!< Reset sequence command to continue with after negotiation */
+    uint8_t verified;    /*!< Number of successful verification commands */
+    uint8_t is_fallback; /*!< Set to `1` when falling back to last working baudrate */
+    uint8_t is_restore;  /*!< Set to `1` when restoring default baudrate before reset */
+    size_t scan;         /*!< Index of next candidate to scan when device does not respond at default baudrate */
+} baud;
+
+/**
+ * \brief           Start baudrate negotiation
+ * \param[in]       target: Baudrate to request from device or `0` to skip negotiation
+ * \param[in]       resume: Reset sequence command to continue with after negotiation
+ * \return          Command to send next
+ */
+static lwcell_cmd_t
+prv_baud_begin(uint32_t target, lwcell_cmd_t resume) {
+    if (target == 0) {
+        return resume;
+    }
+    baud.target = target;
+    baud.resume = resume;
+    baud.is_fallback = 0;
+    return LWCELL_CMD_UART;
+}
+
+/**
+ * \brief           Process response to baudrate negotiation command
+ * \param[in]       is_ok: Set to `1` when device responded with OK
+ * \return          Command to send next
+ */
+static lwcell_cmd_t
+prv_baud_next(uint8_t is_ok) {
+    if (CMD_IS_CUR(LWCELL_CMD_UART_SCAN)) {
+        uint32_t rate;
+
+        if (is_ok) {
+            if (lwcell.ll.uart.baudrate == LWCELL_CFG_AT_PORT_BAUDRATE) {
+                return baud.resume;
+            }
+            /* Device kept baudrate from before host restart, return it to default */
+            lwcelli_baudrate_found(lwcell.ll.uart.baudrate);
+            baud.is_restore = 1;
+            return prv_baud_begin(LWCELL_CFG_AT_PORT_BAUDRATE, baud.resume);
+        }
+        while ((rate = lwcelli_baudrate_candidate(baud.scan++)) == LWCELL_CFG_AT_PORT_BAUDRATE) {}
+        if (rate == 0) { /* Device does not respond at any baudrate, continue at default */
+            lwcelli_baudrate_set(LWCELL_CFG_AT_PORT_BAUDRATE);
+            return baud.resume;
+        }
+        lwcelli_baudrate_set(rate);
+        return LWCELL_CMD_UART_SCAN;
+    }
+    if (CMD_IS_CUR(LWCELL_CMD_UART)) {
+        if (baud.is_restore) {
+            /* Device may have restarted already, continue at default baudrate in any case */
+            baud.is_restore = 0;
+            lwcelli_baudrate_set(LWCELL_CFG_AT_PORT_BAUDRATE);
+            return baud.resume;
+        }
+        if (!is_ok) { /* Device rejected baudrate or did not respond */
+            if (baud.is_fallback) {
+                /* Device may have never left last working baudrate, continue there */
+                lwcelli_baudrate_set(baud.target);
+            } else {
+                lwcelli_baudrate_verified(lwcelli_baudrate_failed(baud.target), 1);
+            }
+            return baud.resume;
+        }
+        lwcelli_baudrate_set(baud.target);
+        baud.verified = 0;
+        return prv_cmd_delay(LWCELL_CMD_UART_VERIFY, 20); /* Give device time to reconfigure its port */
+    }
+
+    /* Verification command */
+    if (is_ok && ++baud.verified < LWCELL_CFG_AT_BAUDRATE_VERIFY) {
+        return LWCELL_CMD_UART_VERIFY;
+    }
+    if (is_ok) {
+        return prv_baud_begin(lwcelli_baudrate_verified(baud.target, baud.is_fallback), baud.resume);
+    }
+    if (baud.is_fallback) {
+        /* Device may have never left last working baudrate, continue there */
+        lwcelli_baudrate_set(baud.target);
+        return baud.resume;
+    }
+    baud.target = lwcelli_baudrate_failed(baud.target);
+    baud.is_fallback = 1;
+    return LWCELL_CMD_UART; /* Request last working baudrate on current link */
+}
+
+/**
+ * \brief           Baudrate negotiation command was not answered in time
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_baud_timeout_fn(void* arg) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    LWCELL_UNUSED(arg);
+    if (msg != NULL && !msg->is_done
+        && (CMD_IS_CUR(LWCELL_CMD_UART) || CMD_IS_CUR(LWCELL_CMD_UART_VERIFY) || CMD_IS_CUR(LWCELL_CMD_UART_SCAN))) {
+        msg->cmd = prv_baud_next(0);
+        msg->fn(msg); /* On failure, reset message finishes on its timeout */
+    }
+}
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+
+#if LWCELL_CFG_RESET_PROBE
+static struct {
+    uint32_t start;      /*!< Time when probing started */
+    uint8_t active;      /*!< Set to `1` while device readiness is probed */
+    uint8_t after_reset; /*!< Set to `1` when probing after reset command, `0` before it */
+    uint8_t urc;         /*!< Set to `1` when boot indication was received during probing */
+} probe;
+
+/**
+ * \brief           Get command to continue with after probe
+ * \param[in]       is_ok: Set to `1` when device responded with OK
+ * \param[in]       responded: Set to `1` when device responded at all, `0` on probe timeout
+ * \return          Next command of reset sequence, \ref LWCELL_CMD_RESET_PROBE to probe again
+ *                      or \ref LWCELL_CMD_DELAY to probe again after interval
+ */
+static lwcell_cmd_t
+prv_probe_next(uint8_t is_ok, uint8_t responded) {
+    uint32_t elapsed = lwcell_sys_now() - probe.start;
+
+    /*
+     * Device may acknowledge first probe after reset just before it restarts.
+     * Without boot indication, accept it only after minimal time
+     */
+    if ((is_ok && (!probe.after_reset || probe.urc || elapsed >= LWCELL_CFG_RESET_PROBE_MIN))
+        || elapsed >= LWCELL_CFG_RESET_PROBE_MAX) {
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING, !is_ok,
+                      "[LWCELL PROBE] Device not ready in %d ms, continuing anyway\r\n", (int)elapsed);
+        probe.active = 0;
+        if (!probe.after_reset) {
+#if LWCELL_CFG_RESET_WARM_START
+            if (lwcell.msg->msg.reset.warm) {
+                return LWCELL_CMD_RESET_WARM_CHECK;
+            }
+#endif /* LWCELL_CFG_RESET_WARM_START */
+            return LWCELL_CMD_RESET;
+        }
+        probe.after_reset = 0;
+        return LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0;
+    }
+    if (responded) { /* Device is alive but still starting */
+        return prv_cmd_delay(LWCELL_CMD_RESET_PROBE, LWCELL_CFG_RESET_PROBE_INTERVAL);
+    }
+    return LWCELL_CMD_RESET_PROBE;
+}
+
+/**
+ * \brief           Probe was not answered in time
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_probe_timeout_fn(void* arg) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    LWCELL_UNUSED(arg);
+    if (msg != NULL && !msg->is_done && CMD_IS_CUR(LWCELL_CMD_RESET_PROBE)) {
+        msg->cmd = prv_probe_next(0, 0);
+        msg->fn(msg); /* On failure, reset message finishes on its timeout */
+    }
+}
+#endif /* LWCELL_CFG_RESET_PROBE */
+
+#if LWCELL_CFG_CMUX
+/**
+ * \brief           Opening of multiplexer channels finished
+ * \note            Function must be called with core locked
+ * \param[in]       is_ok: Set to `1` when all channels are open, `0` when device stays in plain AT mode
+ */
+void
+lwcelli_cmux_opened(uint8_t is_ok) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    LWCELL_UNUSED(is_ok);
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING, !is_ok,
+                  "[LWCELL CMUX] Channels not confirmed, continuing on plain AT port\r\n");
+    if (msg != NULL && !msg->is_done && CMD_IS_CUR(LWCELL_CMD_CMUX_OPEN)) {
+        msg->cmd = LWCELL_CMD_CREG_SET; /* Continue with network setup */
+#if LWCELL_CFG_AT_BATCH
+        prv_batch_send(msg); /* On failure, reset message finishes on its timeout */
+#else                        /* LWCELL_CFG_AT_BATCH */
+        msg->fn(msg); /* On failure, reset message finishes on its timeout */
+#endif                       /* !LWCELL_CFG_AT_BATCH */
+    }
+}
+#endif /* LWCELL_CFG_CMUX */
+
+#if LWCELL_CFG_CAPTURE || LWCELL_CFG_METRICS || LWCELL_CFG_CMUX
+/**
+ * \brief           Send data to device through low-level send function
+ *                  and account it for capture and metrics
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes sent, as returned by low-level send function
+ */
+#if LWCELL_CFG_CMUX
+size_t
+lwcelli_at_port_write(const void* data, size_t len) {
+#else  /* LWCELL_CFG_CMUX */
+static size_t
+lwcelli_at_port_send(const void* data, size_t len) {
+#endif /* !LWCELL_CFG_CMUX */
+#if LWCELL_CFG_CAPTURE
+    lwcelli_capture(LWCELL_CAPTURE_DIR_TX, data, len);
+#endif /* LWCELL_CFG_CAPTURE */
+#if LWCELL_CFG_METRICS
+    if (len > 0) {
+        LWCELL_METRICS_ADD(TX_BYTES, len);
+        LWCELL_METRICS_ADD(TX_CALLS, 1);
+    }
+#endif /* LWCELL_CFG_METRICS */
+    return lwcell.ll.send_fn(data, len);
+}
+
+#if LWCELL_CFG_CMUX
+/**
+ * \brief           Send command data to device, on active channel when multiplexer is running
+ * \param[in]       data: Pointer to data to send or `NULL` to flush
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes sent
+ */
+static size_t
+lwcelli_at_port_send(const void* data, size_t len) {
+    if (lwcelli_cmux_is_active()) {
+        return lwcelli_cmux_send(channel_cur, data, len);
+    }
+    return lwcelli_at_port_write(data, len);
+}
+#endif /* LWCELL_CFG_CMUX */
+#endif /* LWCELL_CFG_CAPTURE || LWCELL_CFG_METRICS || LWCELL_CFG_CMUX */
+
+#if LWCELL_CFG_PPP
+/* Command executed while device is temporarily in command mode during PPP session */
+static struct {
+    lwcell_cmd_t resume; /*!< Command to continue with once device confirms escape */
+    lwcellr_t res;       /*!< Result of command, reported after device returns to data mode */
+} ppp_esc;
+
+/**
+ * \brief           Send data on channel of PPP session
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t, `0` when multiplexer is not used
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes sent
+ */
+size_t
+lwcelli_ppp_send(uint8_t ch, const void* data, size_t len) {
+#if LWCELL_CFG_CMUX
+    uint8_t prev = lwcelli_channel_select(ch);
+#else  /* LWCELL_CFG_CMUX */
+    LWCELL_UNUSED(ch);
+#endif /* !LWCELL_CFG_CMUX */
+    AT_PORT_SEND_WITH_FLUSH(data, len);
+#if LWCELL_CFG_CMUX
+    lwcelli_channel_select(prev);
+#endif /* LWCELL_CFG_CMUX */
+    return len;
+}
+
+/**
+ * \brief           Send escape sequence once there was no data for guard time
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_ppp_escape_fn(void* arg) {
+#if LWCELL_CFG_CMUX
+    uint8_t ch = lwcelli_channel_select(lwcelli_ppp_channel());
+#endif /* LWCELL_CFG_CMUX */
+
+    LWCELL_UNUSED(arg);
+    if (CMD_IS_CUR(LWCELL_CMD_PPP_ESCAPE)) {
+        AT_PORT_SEND_WITH_FLUSH("+++", 3); /* Device confirms with OK after another guard time */
+    }
+#if LWCELL_CFG_CMUX
+    lwcelli_channel_select(ch);
+#endif /* LWCELL_CFG_CMUX */
+}
+#endif /* LWCELL_CFG_PPP */
 
 /**
  * \brief           Memory mapping
@@ -136,8 +760,8 @@ const size_t lwcell_dev_mem_map_size = LWCELL_ARRAYSIZE(lwcell_dev_mem_map);
  * \brief           List of supported devices
  */
 const lwcell_dev_model_map_t lwcell_dev_model_map[] = {
-#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native)                                        \
-    {LWCELL_DEVICE_MODEL_##name, str_id, is_2g, is_lte, has_mqtt_native},
+#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native, conns_max, send_max, baudrate_max)     \
+    {LWCELL_DEVICE_MODEL_##name, str_id, is_2g, is_lte, has_mqtt_native, conns_max, send_max, baudrate_max},
 #include "lwcell/lwcell_models.h"
 };
 
@@ -146,6 +770,39 @@ const lwcell_dev_model_map_t lwcell_dev_model_map[] = {
  */
 const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
 
+/**
+ * \brief           Select device limits from device model
+ *
+ * Configuration limits apply when device is unknown, and they are upper bound
+ * for device limits, as they set size of connection table and buffers.
+ */
+static void
+prv_device_limits_set(void) {
+    lwcell_device_limits_t* l = &lwcell.m.limits;
+    size_t conns_max = LWCELL_CFG_MAX_CONNS, send_max = LWCELL_CFG_CONN_MAX_DATA_LEN;
+    uint32_t baudrate_max = 0;
+
+    for (size_t i = 0; i < lwcell_dev_model_map_size; ++i) {
+        if (lwcell_dev_model_map[i].model == lwcell.m.model) {
+            conns_max = lwcell_dev_model_map[i].conns_max;
+            send_max = lwcell_dev_model_map[i].send_max;
+            baudrate_max = lwcell_dev_model_map[i].baudrate_max;
+            break;
+        }
+    }
+    if (conns_max > LWCELL_CFG_MAX_CONNS || send_max > LWCELL_CFG_CONN_MAX_DATA_LEN) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_WARNING | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL LIMITS] Device supports %d connections and send length %d, limited by configuration\r\n",
+                      (int)conns_max, (int)send_max);
+    }
+    l->conns_max = LWCELL_MIN(conns_max, LWCELL_CFG_MAX_CONNS);
+    l->send_max = LWCELL_MIN(send_max, LWCELL_CFG_CONN_MAX_DATA_LEN);
+    l->baudrate_max = baudrate_max;
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE,
+                  "[LWCELL LIMITS] Connections: %d, send length: %d, baudrate: %lu\r\n", (int)l->conns_max,
+                  (int)l->send_max, (unsigned long)l->baudrate_max);
+}
+
 /**
  * \brief           Free connection send data memory
  * \param[in]       m: Send data message type
@@ -491,6 +1148,9 @@ lwcelli_reset_everything(uint8_t forced) {
         lwcelli_send_cb(LWCELL_EVT_NETWORK_DETACHED);
     }
 #endif /* LWCELL_CFG_NETWORK */
+#if LWCELL_CFG_PPP
+    lwcelli_ppp_closed(1); /* Device leaves data mode on reset */
+#endif                     /* LWCELL_CFG_PPP */
 
     /* Invalid GSM modules */
     LWCELL_MEMSET(&lwcell.m, 0x00, sizeof(lwcell.m));
@@ -498,8 +1158,22 @@ lwcelli_reset_everything(uint8_t forced) {
     /* Manually set states */
     lwcell.m.sim.state = (lwcell_sim_state_t)-1;
     lwcell.m.model = LWCELL_DEVICE_MODEL_UNKNOWN;
+    prv_device_limits_set();
+    lwcelli_state_changed();
 }
 
+#if LWCELL_CFG_EVT_DEFER
+/* Queue global event to worker thread, or call function directly when not possible */
+#define EVT_CALL_FN(fn)                                                                                                \
+    do {                                                                                                               \
+        if (!lwcelli_evt_defer((fn), NULL)) {                                                                          \
+            (fn)(&lwcell.evt);                                                                                         \
+        }                                                                                                              \
+    } while (0)
+#else  /* LWCELL_CFG_EVT_DEFER */
+#define EVT_CALL_FN(fn) (fn)(&lwcell.evt)
+#endif /* !LWCELL_CFG_EVT_DEFER */
+
 /**
  * \brief           Process callback function to user with specific type
  * \param[in]       type: Callback event type
@@ -509,9 +1183,25 @@ lwcellr_t
 lwcelli_send_cb(lwcell_evt_type_t type) {
     lwcell.evt.type = type; /* Set callback type to process */
 
+#if LWCELL_CFG_EVT_MASK
+    /* Call only callbacks subscribed to this type. Table may be rebuilt from within callback */
+    if (lwcell.evt_disp != NULL) {
+        for (size_t i = lwcell.evt_disp_idx[type]; lwcell.evt_disp != NULL && i < lwcell.evt_disp_idx[type + 1];
+             ++i) {
+            EVT_CALL_FN(lwcell.evt_disp[i]);
+        }
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_EVT_MASK */
+
     /* Call callback function for all registered functions */
     for (lwcell_evt_func_t* link = lwcell.evt_func; link != NULL; link = link->next) {
-        link->fn(&lwcell.evt);
+#if LWCELL_CFG_EVT_MASK
+        if (!(link->mask & LWCELL_EVT_MASK(type))) {
+            continue;
+        }
+#endif /* LWCELL_CFG_EVT_MASK */
+        EVT_CALL_FN(link->fn);
     }
     return lwcellOK;
 }
@@ -523,7 +1213,8 @@ lwcelli_send_cb(lwcell_evt_type_t type) {
  * \note            Before calling function, callback structure must be prepared
  * \param[in]       conn: Pointer to connection to use as callback
  * \param[in]       evt: Event callback function for connection
- * \return          Member of \ref lwcellr_t enumeration
+ * \return          Member of \ref lwcellr_t enumeration.
+ *                  \ref lwcellOK when callback is queued to worker thread with \ref LWCELL_CFG_EVT_DEFER
  */
 lwcellr_t
 lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn evt) {
@@ -535,7 +1226,12 @@ lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn evt) {
     if (evt != NULL) {                                   /* Try with user connection */
         return evt(&lwcell.evt);                         /* Call temporary function */
     } else if (conn != NULL && conn->evt_func != NULL) { /* Connection custom callback? */
-        return conn->evt_func(&lwcell.evt);              /* Process callback function */
+#if LWCELL_CFG_EVT_DEFER
+        if (lwcelli_evt_defer(conn->evt_func, conn)) {
+            return lwcellOK; /* Callback is called from worker thread, its return value is not available */
+        }
+#endif                                      /* LWCELL_CFG_EVT_DEFER */
+        return conn->evt_func(&lwcell.evt); /* Process callback function */
     } else if (conn == NULL) {
         return lwcellOK;
     }
@@ -570,7 +1266,8 @@ lwcelli_tcpip_process_send_data(void) {
         CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellCLOSED);
         return lwcellERR;
     }
-    lwcell.msg->msg.conn_send.sent = LWCELL_MIN(lwcell.msg->msg.conn_send.btw, LWCELL_CFG_CONN_MAX_DATA_LEN);
+    lwcell.msg->msg.conn_send.sent = LWCELL_MIN(lwcell.msg->msg.conn_send.btw, lwcell.m.limits.send_max);
+    LWCELL_TRACE(CIPSEND_START, c->num, lwcell.msg->msg.conn_send.sent, lwcell.msg->msg.conn_send.btw, 0);
 
     AT_PORT_SEND_BEGIN_AT();
     AT_PORT_SEND_CONST_STR("+CIPSEND=");
@@ -596,6 +1293,8 @@ lwcelli_tcpip_process_send_data(void) {
  */
 static uint8_t
 lwcelli_tcpip_process_data_sent(uint8_t sent) {
+    LWCELL_TRACE(CIPSEND_SENT, lwcell.msg->msg.conn_send.conn->num, lwcell.msg->msg.conn_send.sent,
+                 lwcell.msg->msg.conn_send.sent_all, sent);
     if (sent) { /* Data were successfully sent */
         lwcell.msg->msg.conn_send.sent_all += lwcell.msg->msg.conn_send.sent;
         lwcell.msg->msg.conn_send.btw -= lwcell.msg->msg.conn_send.sent;
@@ -611,7 +1310,12 @@ lwcelli_tcpip_process_data_sent(uint8_t sent) {
             return 1;                         /* Return 1 and indicate error */
         }
     }
-    if (lwcell.msg->msg.conn_send.btw > 0) {                 /* Do we still have data to send? */
+    if (lwcell.msg->msg.conn_send.btw > 0) { /* Do we still have data to send? */
+#if LWCELL_CFG_CMD_CANCEL
+        if (lwcell.msg->is_cancelled) { /* Stop between segments, already sent data are reported */
+            return 1;
+        }
+#endif                                                       /* LWCELL_CFG_CMD_CANCEL */
         if (lwcelli_tcpip_process_send_data() != lwcellOK) { /* Check if we can continue */
             return 1;                                        /* Finish at this point */
         }
@@ -633,6 +1337,13 @@ lwcelli_process_cipsend_response(lwcell_recv_t* rcv, lwcell_status_flags_t* stat
             if (!strncmp(&rcv->data[3], "SEND OK" CRLF, 7 + CRLF_LEN)) {
                 lwcell.msg->msg.conn_send.wait_send_ok_err = 0;
                 stat->is_ok = lwcelli_tcpip_process_data_sent(1); /* Process as data were sent */
+#if LWCELL_CFG_CMD_CANCEL
+                if (stat->is_ok && lwcell.msg->is_cancelled && lwcell.msg->msg.conn_send.btw > 0) {
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                    CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERRCANCELED);
+                } else
+#endif /* LWCELL_CFG_CMD_CANCEL */
                 if (stat->is_ok && lwcell.msg->msg.conn_send.conn->status.f.active) {
                     CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellOK);
                 }
@@ -698,6 +1409,7 @@ lwcelli_conn_closed_process(uint8_t conn_num, uint8_t forced) {
     lwcell_conn_t* conn = &lwcell.m.conns[conn_num];
 
     conn->status.f.active = 0;
+    lwcelli_state_changed();
 
     /* Check if write buffer is set */
     if (conn->buff.buff != NULL) {
@@ -751,25 +1463,48 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
         }
     }
 
+#if LWCELL_CFG_RESET_PROBE
+    /* Boot indication while probing, device is ready to accept commands */
+    if (probe.active
+        && (!strcmp(rcv->data, "RDY" CRLF) || !strcmp(rcv->data, "Call Ready" CRLF)
+            || !strcmp(rcv->data, "SMS Ready" CRLF))) {
+        probe.urc = 1;
+    }
+#endif /* LWCELL_CFG_RESET_PROBE */
+#if LWCELL_CFG_RESET_WARM_START
+    if (CMD_IS_CUR(LWCELL_CMD_RESET_WARM_CHECK)) {
+        prv_warm_parse(rcv);
+    }
+#endif /* LWCELL_CFG_RESET_WARM_START */
+
     /* Scan received strings which start with '+' */
     if (rcv->data[0] == '+') {
         if (!strncmp(rcv->data, "+CSQ", 4)) {
             lwcelli_parse_csq(rcv->data); /* Parse +CSQ response */
+            LWCELL_CACHE_SET(RSSI);
 #if LWCELL_CFG_NETWORK
         } else if (!strncmp(rcv->data, "+PDP: DEACT", 11)) {
             /* PDP has been deactivated */
+            LWCELL_CACHE_INVALIDATE(OPERATOR);
+            LWCELL_CACHE_INVALIDATE(RSSI);
             lwcell_network_check_status(NULL, NULL, 0); /* Update status */
 #endif                                                  /* LWCELL_CFG_NETWORK */
 #if LWCELL_CFG_CONN
         } else if (!strncmp(rcv->data, "+RECEIVE", 8)) {
             lwcelli_parse_ipd(rcv->data);                                              /* Parse IPD */
 #endif                                                                                 /* LWCELL_CFG_CONN */
-        } else if (!strncmp(rcv->data, "+CREG", 5)) {                                  /* Check for +CREG indication */
-            lwcelli_parse_creg(rcv->data, LWCELL_U8(CMD_IS_CUR(LWCELL_CMD_CREG_GET))); /* Parse +CREG response */
+        } else if (!strncmp(rcv->data, "+CREG", 5)) { /* Check for +CREG indication */
+            LWCELL_CACHE_INVALIDATE(OPERATOR);        /* Operator is queried again on registration */
+            LWCELL_CACHE_INVALIDATE(RSSI);
+            lwcelli_parse_creg(rcv->data, LWCELL_U8(CMD_IS_CUR(LWCELL_CMD_CREG_GET)
+                                                    || CMD_IS_CUR(LWCELL_CMD_RESET_WARM_CHECK))); /* Parse +CREG response */
         } else if (!strncmp(rcv->data, "+CPIN", 5)) { /* Check for +CPIN indication for SIM */
+            LWCELL_CACHE_INVALIDATE(OPERATOR);
+            LWCELL_CACHE_INVALIDATE(RSSI);
             lwcelli_parse_cpin(rcv->data, 1 /* !CMD_IS_DEF(LWCELL_CMD_CPIN_SET) */); /* Parse +CPIN response */
         } else if (CMD_IS_CUR(LWCELL_CMD_COPS_GET) && !strncmp(rcv->data, "+COPS", 5)) {
             lwcelli_parse_cops(rcv->data); /* Parse current +COPS */
+            LWCELL_CACHE_SET(OPERATOR);
 #if LWCELL_CFG_SMS
         } else if (CMD_IS_CUR(LWCELL_CMD_CMGS) && !strncmp(rcv->data, "+CMGS", 5)) {
             lwcelli_parse_cmgs(rcv->data, &lwcell.msg->msg.sms_send.pos); /* Parse +CMGS response */
@@ -816,6 +1551,15 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
     } else {
         if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SHUT OK" CRLF, 7 + CRLF_LEN)) {
             stat.is_ok = 1;
+#if LWCELL_CFG_PPP
+        } else if ((CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) || CMD_IS_CUR(LWCELL_CMD_PPP_RESUME))
+                   && !strncmp(rcv->data, "CONNECT", 7)) {
+            stat.is_ok = 1; /* Device entered data mode */
+        } else if ((CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) || CMD_IS_CUR(LWCELL_CMD_PPP_RESUME))
+                   && (!strcmp(rcv->data, "NO CARRIER" CRLF) || !strcmp(rcv->data, "BUSY" CRLF)
+                       || !strcmp(rcv->data, "NO DIALTONE" CRLF))) {
+            stat.is_error = 1;
+#endif /* LWCELL_CFG_PPP */
 #if LWCELL_CFG_CONN
         } else if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' '
                    && (!strncmp(&rcv->data[3], "CLOSE OK" CRLF, 8 + CRLF_LEN)
@@ -862,6 +1606,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
             size_t tocopy;
             if (CMD_IS_CUR(LWCELL_CMD_CGMI_GET)) { /* Check device manufacturer */
                 lwcelli_parse_string(&tmp, lwcell.m.model_manufacturer, sizeof(lwcell.m.model_manufacturer), 1);
+                LWCELL_CACHE_SET(MANUFACTURER);
                 if (CMD_IS_DEF(LWCELL_CMD_CGMI_GET)) {
                     tocopy = LWCELL_MIN(sizeof(lwcell.m.model_manufacturer), lwcell.msg->msg.device_info.len);
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_manufacturer, tocopy);
@@ -869,6 +1614,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                 }
             } else if (CMD_IS_CUR(LWCELL_CMD_CGMM_GET)) { /* Check device model number */
                 lwcelli_parse_string(&tmp, lwcell.m.model_number, sizeof(lwcell.m.model_number), 1);
+                LWCELL_CACHE_SET(MODEL);
                 if (CMD_IS_DEF(LWCELL_CMD_CGMM_GET)) {
                     tocopy = LWCELL_MIN(sizeof(lwcell.m.model_number), lwcell.msg->msg.device_info.len);
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_number, tocopy);
@@ -877,11 +1623,13 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                 for (size_t i = 0; i < lwcell_dev_model_map_size; ++i) {
                     if (strstr(lwcell.m.model_number, lwcell_dev_model_map[i].id_str) != NULL) {
                         lwcell.m.model = lwcell_dev_model_map[i].model;
+                        lwcelli_state_changed();
                         break;
                     }
                 }
             } else if (CMD_IS_CUR(LWCELL_CMD_CGSN_GET)) { /* Check device serial number */
                 lwcelli_parse_string(&tmp, lwcell.m.model_serial_number, sizeof(lwcell.m.model_serial_number), 1);
+                LWCELL_CACHE_SET(SERIAL_NUMBER);
                 if (CMD_IS_DEF(LWCELL_CMD_CGSN_GET)) {
                     tocopy = LWCELL_MIN(sizeof(lwcell.m.model_serial_number), lwcell.msg->msg.device_info.len);
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_serial_number, tocopy);
@@ -892,15 +1640,20 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                     tmp += 9;
                 }
                 lwcelli_parse_string(&tmp, lwcell.m.model_revision, sizeof(lwcell.m.model_revision), 1);
+                LWCELL_CACHE_SET(REVISION);
                 if (CMD_IS_DEF(LWCELL_CMD_CGMR_GET)) {
                     tocopy = LWCELL_MIN(sizeof(lwcell.m.model_revision), lwcell.msg->msg.device_info.len);
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_revision, tocopy);
                     lwcell.msg->msg.device_info.str[tocopy - 1] = 0;
                 }
             }
+#if LWCELL_CFG_AT_BATCH
+            prv_batch_next(); /* Each command of the batch responds with single line */
+#endif                        /* LWCELL_CFG_AT_BATCH */
         } else if (CMD_IS_CUR(LWCELL_CMD_CIFSR) && LWCELL_CHARISNUM(rcv->data[0])) {
             const char* tmp = rcv->data;
             lwcelli_parse_ip(&tmp, &lwcell.m.network.ip_addr); /* Parse IP address */
+            lwcelli_state_changed();
 
             stat.is_ok = 1; /* Manually set OK flag as we don't expect OK in CIFSR command */
         }
@@ -917,6 +1670,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
              */
             if (stat.is_error == 10) {
                 lwcell.m.sim.state = LWCELL_SIM_STATE_NOT_INSERTED;
+                lwcelli_state_changed();
                 lwcelli_send_cb(LWCELL_EVT_SIM_STATE_CHANGED);
             }
 #if LWCELL_CFG_SMS
@@ -936,7 +1690,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                     processed = 1;
                     lwcelli_parse_cipstatus_conn(rcv->data, 1, &continueScan);
 
-                    if (lwcell.m.active_conns_cur_parse_num == (LWCELL_CFG_MAX_CONNS - 1)) {
+                    if (lwcell.m.active_conns_cur_parse_num == (lwcell.m.limits.conns_max - 1)) {
                         stat.is_ok = 1;
                     }
                 } else if (!strncmp(rcv->data, "STATE:", 6)) {
@@ -971,6 +1725,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
 
                         /* Set connection parameters */
                         conn->status.f.client = 1;
+                        lwcelli_state_changed();
                         conn->evt_func = lwcell.msg->msg.conn_start.evt_func;
                         conn->arg = lwcell.msg->msg.conn_start.arg;
 
@@ -1014,7 +1769,8 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
      */
     if (stat.is_ok || stat.is_error) {
         lwcellr_t res = lwcellOK;
-        if (lwcell.msg != NULL) { /* Do we have active message? */
+        /* Late responses are not for sequence waiting for its delay to expire */
+        if (lwcell.msg != NULL && !CMD_IS_CUR(LWCELL_CMD_DELAY)) { /* Do we have active message? */
             res = lwcelli_process_sub_cmd(lwcell.msg, &stat);
             if (res != lwcellCONT) { /* Shall we continue with next subcommand under this one? */
                 if (stat.is_ok) {    /* Check OK status */
@@ -1028,11 +1784,21 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
 
             /*
              * When the command is finished,
-             * release synchronization semaphore
-             * from user thread and start with next command
+             * signal completion to producer thread waiting on synchronization semaphore.
+             * Completion is signalled only once, not after producer already gave up on timeout
              */
-            if (res != lwcellCONT) {                      /* Do we have to continue to wait for command? */
+            if (res != lwcellCONT && !lwcell.msg->is_done) {
+                lwcell.msg->is_done = 1;
+#if LWCELL_CFG_SINGLE_THREAD
+#if LWCELL_CFG_INPUT_USE_PROCESS
+                lwcelli_process_wakeup(); /* Data are processed outside loop, wake it up to finish command */
+#endif                                    /* LWCELL_CFG_INPUT_USE_PROCESS */
+#elif LWCELL_CFG_CMUX                     /* LWCELL_CFG_SINGLE_THREAD */
+                /* Producer of data channel waits on its own semaphore */
+                lwcell_sys_sem_release(channel_cur == LWCELL_CMUX_CH_DATA ? &lwcell.sem_sync_data : &lwcell.sem_sync);
+#else                                     /* LWCELL_CFG_CMUX */
                 lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore */
+#endif                                    /* !LWCELL_CFG_SINGLE_THREAD */
             }
         }
     }
@@ -1061,6 +1827,10 @@ lwcelli_process_buffer(void) {
              */
             data = lwcell_buff_get_linear_block_read_address(&lwcell.buff);
 
+#if LWCELL_CFG_CAPTURE
+            lwcelli_capture(LWCELL_CAPTURE_DIR_RX, data, len);
+#endif /* LWCELL_CFG_CAPTURE */
+
             /* Process actual received data */
             lwcelli_process(data, len);
 
@@ -1069,6 +1839,9 @@ lwcelli_process_buffer(void) {
              * the buffer memory and start over
              */
             lwcell_buff_skip(&lwcell.buff, len);
+#if LWCELL_CFG_FLOW_CONTROL
+            lwcelli_flow_processed(); /* Resume device once buffer drained */
+#endif                                /* LWCELL_CFG_FLOW_CONTROL */
         }
     } while (len > 0);
     return lwcellOK;
@@ -1083,16 +1856,54 @@ lwcelli_process_buffer(void) {
  */
 lwcellr_t
 lwcelli_process(const void* data, size_t data_len) {
+    /* Check status if device is available */
+    if (!lwcell.status.f.dev_present) {
+        return lwcellERRNODEVICE;
+    }
+#if LWCELL_CFG_CMUX
+    if (lwcelli_cmux_is_active()) {
+        lwcelli_cmux_input(data, data_len); /* Frames are processed per channel */
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_CMUX */
+    prv_process(data, data_len);
+    return lwcellOK;
+}
+
+#if LWCELL_CFG_CMUX
+/**
+ * \brief           Process payload received on multiplexer channel
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t
+ * \param[in]       data: Pointer to data to process
+ * \param[in]       len: Length of data to process in units of bytes
+ */
+void
+lwcelli_channel_process(uint8_t ch, const void* data, size_t len) {
+    uint8_t prev = lwcelli_channel_select(ch);
+
+    prv_process(data, len);
+    lwcelli_channel_select(prev);
+}
+#endif /* LWCELL_CFG_CMUX */
+
+/**
+ * \brief           Process input data with parser state of selected channel
+ * \param[in]       data: Pointer to data to process
+ * \param[in]       data_len: Length of data to process in units of bytes
+ */
+static void
+prv_process(const void* data, size_t data_len) {
     uint8_t ch;
     const uint8_t* d = data;
     size_t d_len = data_len;
-    static uint8_t ch_prev1, ch_prev2;
-    static lwcell_unicode_t unicode;
 
-    /* Check status if device is available */
-    if (!lwcell.status.f.dev_present) {
-        return lwcellERRNODEVICE;
+#if LWCELL_CFG_PPP
+    if (lwcelli_ppp_is_online(CHANNEL_CUR())) {
+        lwcelli_ppp_input(data, data_len); /* Data mode, bytes belong to host PPP implementation */
+        return;
     }
+#endif /* LWCELL_CFG_PPP */
 
     while (d_len > 0) { /* Read entire set of characters from buffer */
         ch = *d;        /* Get next character */
@@ -1115,6 +1926,9 @@ lwcelli_process(const void* data, size_t data_len) {
                              LWCELL_MIN(lwcell.m.ipd.rem_len, lwcell.m.ipd.buff != NULL
                                                                   ? (lwcell.m.ipd.buff->len - lwcell.m.ipd.buff_ptr)
                                                                   : lwcell.m.ipd.rem_len));
+            if (lwcell.m.ipd.buff == NULL) {
+                LWCELL_METRICS_ADD(IPD_SKIPPED, len + 1); /* Current character and bytes skipped below */
+            }
             LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] New length to read: %d bytes\r\n",
                           (int)len);
             if (len > 0) {
@@ -1130,6 +1944,7 @@ lwcelli_process(const void* data, size_t data_len) {
                 d += len;                     /* Skip remaining length */
                 lwcell.m.ipd.buff_ptr += len; /* Forward buffer pointer */
                 lwcell.m.ipd.rem_len -= len;  /* Decrease remaining length */
+                LWCELL_TRACE(IPD_DATA, lwcell.m.ipd.conn->num, len, lwcell.m.ipd.rem_len, 0);
             }
 
             /* Did we reach end of buffer or no more data? */
@@ -1152,10 +1967,13 @@ lwcelli_process(const void* data, size_t data_len) {
                     lwcell.evt.evt.conn_data_recv.buff = lwcell.m.ipd.buff;
                     lwcell.evt.evt.conn_data_recv.conn = lwcell.m.ipd.conn;
                     res = lwcelli_send_conn_cb(lwcell.m.ipd.conn, NULL);
+                    LWCELL_TRACE(IPD_RECV, lwcell.m.ipd.conn->num, lwcell.m.ipd.buff->tot_len, res, 0);
 
                     lwcell_pbuf_free(lwcell.m.ipd.buff); /* Free packet buffer at this point */
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] Free packet buffer\r\n");
+                    /* Deferred callback cannot stop the transfer, excluded callbacks are called synchronously */
                     if (res == lwcellOKIGNOREMORE) { /* We should ignore more data */
+                        LWCELL_METRICS_ADD(IPD_IGNORED, 1);
                         LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
                                       "[LWCELL IPD] Ignoring more data from this IPD if available\r\n");
                         lwcell.m.ipd.buff = NULL; /* Set to NULL to ignore more data if possibly available */
@@ -1182,6 +2000,9 @@ lwcelli_process(const void* data, size_t data_len) {
                         LWCELL_DEBUGW(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
                                       lwcell.m.ipd.buff == NULL,
                                       "[LWCELL IPD] Buffer allocation failed for %d bytes\r\n", (int)new_len);
+                        if (lwcell.m.ipd.buff == NULL) {
+                            LWCELL_TRACE(IPD_ALLOC_FAIL, lwcell.m.ipd.conn->num, lwcell.m.ipd.rem_len, 0, 0);
+                        }
                     } else {
                         lwcell.m.ipd.buff = NULL; /* Reset it */
                     }
@@ -1277,6 +2098,12 @@ lwcelli_process(const void* data, size_t data_len) {
                     if (ch == '\n') {
                         lwcelli_parse_received(&recv_buff); /* Parse received string */
                         RECV_RESET();                       /* Reset received string */
+#if LWCELL_CFG_PPP
+                        if (lwcelli_ppp_is_online(CHANNEL_CUR())) {
+                            lwcelli_ppp_input(d, d_len); /* Data following CONNECT belong to PPP session */
+                            return;
+                        }
+#endif /* LWCELL_CFG_PPP */
                     }
 
 #if LWCELL_CFG_CONN
@@ -1286,6 +2113,7 @@ lwcelli_process(const void* data, size_t data_len) {
                         LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
                                       "[LWCELL IPD] Data on connection %d with total size %d byte(s)\r\n",
                                       (int)lwcell.m.ipd.conn->num, (int)lwcell.m.ipd.tot_len);
+                        LWCELL_TRACE(IPD_START, lwcell.m.ipd.conn->num, lwcell.m.ipd.tot_len, 0, 0);
 
                         len = LWCELL_MIN(lwcell.m.ipd.rem_len, LWCELL_CFG_CONN_MAX_DATA_LEN);
 
@@ -1302,6 +2130,9 @@ lwcelli_process(const void* data, size_t data_len) {
                             LWCELL_DEBUGW(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
                                           lwcell.m.ipd.buff == NULL,
                                           "[LWCELL IPD] Buffer allocation failed for %d byte(s)\r\n", (int)len);
+                            if (lwcell.m.ipd.buff == NULL) {
+                                LWCELL_TRACE(IPD_ALLOC_FAIL, lwcell.m.ipd.conn->num, lwcell.m.ipd.tot_len, 0, 0);
+                            }
                         } else {
                             lwcell.m.ipd.buff = NULL; /* Ignore reading on closed connection */
                             LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
@@ -1369,7 +2200,6 @@ lwcelli_process(const void* data, size_t data_len) {
         ch_prev2 = ch_prev1; /* Save previous character as previous previous */
         ch_prev1 = ch;       /* Set current as previous */
     }
-    return lwcellOK;
 }
 
 /* Temporary macros, only available for inside lwcelli_process_sub_cmd function */
@@ -1398,18 +2228,63 @@ lwcelli_process(const void* data, size_t data_len) {
 static lwcellr_t
 lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
     lwcell_cmd_t n_cmd = LWCELL_CMD_IDLE;
+#if LWCELL_CFG_PPP
+    if (CMD_IS_CUR(LWCELL_CMD_PPP_ESCAPE)) {
+        if (stat->is_ok) {
+            SET_NEW_CMD(ppp_esc.resume); /* Device is in command mode, continue with actual command */
+        } else {
+            lwcelli_ppp_resume(); /* Device stays in data mode */
+        }
+    } else if (CMD_IS_CUR(LWCELL_CMD_PPP_RESUME)) {
+        if (stat->is_ok) {
+            lwcelli_ppp_resume();
+        } else {
+            lwcelli_ppp_closed(1); /* Session has been lost while in command mode */
+        }
+        /* Message reports result of command executed in command mode */
+        stat->is_ok = ppp_esc.res == lwcellOK;
+        stat->is_error = !stat->is_ok;
+    } else
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_AT_BATCH
+    if (prv_batch_finish(msg, stat, &n_cmd)) {
+        /* Rejected batch is repeated command by command */
+    } else
+#endif /* LWCELL_CFG_AT_BATCH */
     if (CMD_IS_DEF(LWCELL_CMD_RESET)) {
         switch (CMD_GET_CUR()) { /* Check current command */
+#if LWCELL_CFG_RESET_PROBE
+            case LWCELL_CMD_RESET_PROBE: {
+                lwcell_timeout_remove(prv_probe_timeout_fn);
+                SET_NEW_CMD(prv_probe_next(stat->is_ok, 1));
+                break;
+            }
+            case LWCELL_CMD_RESET: {
+                lwcelli_reset_everything(1);          /* Reset everything */
+                probe.after_reset = 1;
+                SET_NEW_CMD(LWCELL_CMD_RESET_PROBE); /* Wait until device restarts */
+                break;
+            }
+#else  /* LWCELL_CFG_RESET_PROBE */
             case LWCELL_CMD_RESET: {
-                lwcelli_reset_everything(1);                                         /* Reset everything */
-                SET_NEW_CMD(LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0); /* Set ECHO mode */
-                lwcell_delay(LWCELL_CFG_RESET_DELAY_AFTER); /* Delay for some time before we can continue after reset */
+                lwcelli_reset_everything(1); /* Reset everything */
+                /* Set ECHO mode once device had some time to restart */
+                SET_NEW_CMD(prv_cmd_delay(LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0,
+                                          LWCELL_CFG_RESET_DELAY_AFTER));
                 break;
             }
+#endif /* !LWCELL_CFG_RESET_PROBE */
             case LWCELL_CMD_ATE0:
             case LWCELL_CMD_ATE1: SET_NEW_CMD(LWCELL_CMD_CFUN_SET); break;     /* Set full functionality */
             case LWCELL_CMD_CFUN_SET: SET_NEW_CMD(LWCELL_CMD_CMEE_SET); break; /* Set detailed error reporting */
-            case LWCELL_CMD_CMEE_SET: SET_NEW_CMD(LWCELL_CMD_CGMI_GET); break; /* Get manufacturer */
+            case LWCELL_CMD_CMEE_SET: SET_NEW_CMD(RESET_CMD_AFTER_CMEE); break; /* Flow control or manufacturer */
+#if LWCELL_CFG_FLOW_CONTROL
+            case LWCELL_CMD_IFC_SET: {
+                lwcelli_flow_enabled(stat->is_ok); /* Device without flow control continues without it */
+                SET_NEW_CMD(LWCELL_CMD_CGMI_GET);
+                break;
+            }
+#endif /* LWCELL_CFG_FLOW_CONTROL */
             case LWCELL_CMD_CGMI_GET: SET_NEW_CMD(LWCELL_CMD_CGMM_GET); break; /* Get model */
             case LWCELL_CMD_CGMM_GET: SET_NEW_CMD(LWCELL_CMD_CGSN_GET); break; /* Get product serial number */
             case LWCELL_CMD_CGSN_GET: SET_NEW_CMD(LWCELL_CMD_CGMR_GET); break; /* Get product revision */
@@ -1419,16 +2294,67 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
                  * It is now time to send info to user
                  * to select between device drivers
                  */
+                prv_device_limits_set();
                 lwcelli_send_cb(LWCELL_EVT_DEVICE_IDENTIFIED);
 
+#if LWCELL_CFG_CMUX
+                SET_NEW_CMD(LWCELL_CMD_CMUX_SET); /* Start multiplexer before network setup */
+#else                                             /* LWCELL_CFG_CMUX */
                 SET_NEW_CMD(LWCELL_CMD_CREG_SET); /* Enable unsolicited code for CREG */
+#endif                                            /* !LWCELL_CFG_CMUX */
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+                /* Switch to best baudrate before continuing */
+                SET_NEW_CMD(prv_baud_begin(lwcelli_baudrate_start(), n_cmd));
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+                break;
+            }
+#if LWCELL_CFG_CMUX
+            case LWCELL_CMD_CMUX_SET: {
+                /* Device without multiplexer support continues on plain AT port */
+                SET_NEW_CMD(stat->is_ok ? LWCELL_CMD_CMUX_OPEN : LWCELL_CMD_CREG_SET);
                 break;
             }
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+            case LWCELL_CMD_UART:
+            case LWCELL_CMD_UART_VERIFY:
+            case LWCELL_CMD_UART_SCAN: {
+                lwcell_timeout_remove(prv_baud_timeout_fn);
+                SET_NEW_CMD(prv_baud_next(stat->is_ok));
+                break;
+            }
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
             case LWCELL_CMD_CREG_SET: SET_NEW_CMD(LWCELL_CMD_CLCC_SET); break; /* Set call state */
             case LWCELL_CMD_CLCC_SET: SET_NEW_CMD(LWCELL_CMD_CPIN_GET); break; /* Get SIM state */
+#if LWCELL_CFG_RESET_WARM_START
+            case LWCELL_CMD_RESET_WARM_CHECK: {
+                if (stat->is_ok) {
+                    warm.active = 1;
+                    warm.echo = warm.echo_seen == LWCELL_CFG_AT_ECHO;
+                    SET_NEW_CMD(LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0);
+                } else {
+                    LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                                  "[LWCELL WARM] Settings query failed, doing full reset\r\n");
+                    msg->msg.reset.warm = 0;
+                    SET_NEW_CMD(LWCELL_CMD_RESET);
+                }
+                break;
+            }
+#if LWCELL_CFG_CONN
+            /* Restore network and connection state device kept from before */
+            case LWCELL_CMD_CPIN_GET: SET_NEW_CMD(warm.active ? LWCELL_CMD_CIPSTATUS : LWCELL_CMD_IDLE); break;
+            case LWCELL_CMD_CIPSTATUS: break;
+#else  /* LWCELL_CFG_CONN */
+            case LWCELL_CMD_CPIN_GET: break;
+#endif /* !LWCELL_CFG_CONN */
+#else  /* LWCELL_CFG_RESET_WARM_START */
             case LWCELL_CMD_CPIN_GET: break;
+#endif /* !LWCELL_CFG_RESET_WARM_START */
             default: break;
         }
+#if LWCELL_CFG_RESET_WARM_START
+        n_cmd = prv_warm_skip(n_cmd);
+#endif /* LWCELL_CFG_RESET_WARM_START */
 
         /* Send event */
         if (n_cmd == LWCELL_CMD_IDLE) {
@@ -1439,6 +2365,8 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             lwcell.evt.evt.operator_current.operator_current = &lwcell.m.network.curr_operator;
             lwcelli_send_cb(LWCELL_EVT_NETWORK_OPERATOR_CURRENT);
         }
+    } else if (CMD_IS_DEF(LWCELL_CMD_COPS_SET)) {
+        LWCELL_CACHE_INVALIDATE(OPERATOR); /* Device may have changed operator, even on error */
     } else if (CMD_IS_DEF(LWCELL_CMD_COPS_GET_OPT)) {
         if (CMD_IS_CUR(LWCELL_CMD_COPS_GET_OPT)) {
             OPERATOR_SCAN_SEND_EVT(lwcell.msg, stat->is_ok ? lwcellOK : lwcellERR);
@@ -1450,8 +2378,7 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
                 /* Sometimes SIM is not ready just after PIN entered */
                 if (msg->msg.sim_info.cnum_tries < 5) {
                     ++msg->msg.sim_info.cnum_tries;
-                    SET_NEW_CMD(LWCELL_CMD_CNUM);
-                    lwcell_delay(1000);
+                    SET_NEW_CMD(prv_cmd_delay(LWCELL_CMD_CNUM, 1000));
                 }
             }
         }
@@ -1475,16 +2402,14 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
                      * while it allows slow modems to take more time to handle the situation
                      */
                     if ((stat->is_error || lwcell.m.sim.state != LWCELL_SIM_STATE_READY) && msg->i < 5) {
-                        lwcell_delay(500 * msg->i);
-                        SET_NEW_CMD(LWCELL_CMD_CPIN_GET);
+                        SET_NEW_CMD(prv_cmd_delay(LWCELL_CMD_CPIN_GET, 500 * msg->i));
                     }
                 }
                 break;
             }
             case LWCELL_CMD_CPIN_SET: { /* Set CPIN */
                 if (stat->is_ok) {
-                    lwcell_delay(500);
-                    SET_NEW_CMD(LWCELL_CMD_CPIN_GET);
+                    SET_NEW_CMD(prv_cmd_delay(LWCELL_CMD_CPIN_GET, 500));
                 }
                 break;
             }
@@ -1704,13 +2629,38 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
         }
         /* The rest is handled in one layer above */
 #endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_PPP
+    } else if (CMD_IS_DEF(LWCELL_CMD_PPP_START)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CGDCONT)) {
+            SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_PPP_DIAL);
+        } else if (CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) && stat->is_ok) {
+            lwcelli_ppp_connected(CHANNEL_CUR(), msg->msg.ppp_start.input_fn, msg->msg.ppp_start.input_arg);
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_PPP_STOP)) {
+        if (CMD_IS_CUR(LWCELL_CMD_PPP_HANGUP) && stat->is_ok) {
+            lwcelli_ppp_closed(0);
+        }
+#endif /* LWCELL_CFG_PPP */
     }
 
+#if LWCELL_CFG_PPP
+    /* Return device to data mode once command executed during session has finished */
+    if (n_cmd == LWCELL_CMD_IDLE && !CMD_IS_CUR(LWCELL_CMD_PPP_RESUME) && lwcelli_ppp_is_session()
+        && lwcelli_ppp_channel() == CHANNEL_CUR() && !lwcelli_ppp_is_online(CHANNEL_CUR())) {
+        ppp_esc.res = stat->is_ok ? lwcellOK : lwcellERR;
+        SET_NEW_CMD(LWCELL_CMD_PPP_RESUME);
+    }
+#endif /* LWCELL_CFG_PPP */
+
     /* Check if new command was set for execution */
     if (n_cmd != LWCELL_CMD_IDLE) {
         lwcellr_t res;
         msg->cmd = n_cmd;
+#if LWCELL_CFG_AT_BATCH
+        if ((res = prv_batch_send(msg)) == lwcellOK) {
+#else  /* LWCELL_CFG_AT_BATCH */
         if ((res = msg->fn(msg)) == lwcellOK) {
+#endif /* !LWCELL_CFG_AT_BATCH */
             return lwcellCONT;
         } else {
             stat->is_ok = 0;
@@ -1733,12 +2683,20 @@ lwcellr_t
 lwcelli_initiate_cmd(lwcell_msg_t* msg) {
     switch (CMD_GET_CUR()) {     /* Check current message we want to send over AT */
         case LWCELL_CMD_RESET: { /* Reset modem with AT commands */
-            /* Try with hardware reset */
-            if (lwcell.ll.reset_fn != NULL && lwcell.ll.reset_fn(1)) {
-                lwcell_delay(2);
+            /* Try with hardware reset, reset pulse and device start are timed with timeouts */
+            if (cmd_delay.reset_hw == 0 && lwcell.ll.reset_fn != NULL && lwcell.ll.reset_fn(1)) {
+                cmd_delay.reset_hw = 1;
+                msg->cmd = prv_cmd_delay(LWCELL_CMD_RESET, 2);
+                lwcell_timeout_add(cmd_delay.ms, prv_cmd_delay_fn, NULL);
+                break;
+            } else if (cmd_delay.reset_hw == 1) {
                 lwcell.ll.reset_fn(0);
-                lwcell_delay(500);
+                cmd_delay.reset_hw = 2;
+                msg->cmd = prv_cmd_delay(LWCELL_CMD_RESET, 500);
+                lwcell_timeout_add(cmd_delay.ms, prv_cmd_delay_fn, NULL);
+                break;
             }
+            cmd_delay.reset_hw = 0;
 
             /* Send manual AT command */
             AT_PORT_SEND_BEGIN_AT();
@@ -1746,11 +2704,111 @@ lwcelli_initiate_cmd(lwcell_msg_t* msg) {
             AT_PORT_SEND_END_AT();
             break;
         }
+        case LWCELL_CMD_DELAY: { /* Next command is started from timeout */
+            lwcell_timeout_add(cmd_delay.ms, prv_cmd_delay_fn, NULL);
+            break;
+        }
         case LWCELL_CMD_RESET_DEVICE_FIRST_CMD: { /* First command for device driver specific reset */
             AT_PORT_SEND_BEGIN_AT();
             AT_PORT_SEND_END_AT();
             break;
         }
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+        case LWCELL_CMD_UART: { /* Set AT port baudrate */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+IPR=");
+            lwcelli_send_number(baud.target, 0, 0);
+            AT_PORT_SEND_END_AT();
+            lwcell_timeout_add(LWCELL_CFG_AT_BAUDRATE_TIMEOUT, prv_baud_timeout_fn, NULL);
+            break;
+        }
+        case LWCELL_CMD_UART_VERIFY:
+        case LWCELL_CMD_UART_SCAN: { /* Check communication at current baudrate */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_END_AT();
+            lwcell_timeout_add(LWCELL_CFG_AT_BAUDRATE_TIMEOUT, prv_baud_timeout_fn, NULL);
+            break;
+        }
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+#if LWCELL_CFG_CMUX
+        case LWCELL_CMD_CMUX_SET: { /* Start multiplexer in basic option mode */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CMUX=0,0,,");
+            lwcelli_send_number(LWCELL_CFG_CMUX_FRAME_SIZE, 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CMUX_OPEN: { /* Open channels, sequence continues once device confirms them */
+            lwcelli_cmux_open();
+            break;
+        }
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_FLOW_CONTROL
+        case LWCELL_CMD_IFC_SET: { /* RTS/CTS flow control in both directions */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+IFC=2,2");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_FLOW_CONTROL */
+#if LWCELL_CFG_PPP
+        case LWCELL_CMD_CGDCONT: { /* Define PDP context for session */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CGDCONT=");
+            lwcelli_send_number(LWCELL_CFG_PPP_CID, 0, 0);
+            AT_PORT_SEND_CONST_STR(",\"IP\"");
+            lwcelli_send_string(msg->msg.ppp_start.apn, 1, 1, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_PPP_DIAL: { /* Enter data mode, device replies with CONNECT */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("D*99***");
+            lwcelli_send_number(LWCELL_CFG_PPP_CID, 0, 0);
+            AT_PORT_SEND_CONST_STR("#");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_PPP_ESCAPE: { /* Switch to command mode, escape sequence is sent after guard time */
+            lwcelli_ppp_suspend();   /* Host data must not break guard time */
+            lwcell_timeout_add(LWCELL_CFG_PPP_ESCAPE_GUARD, prv_ppp_escape_fn, NULL);
+            break;
+        }
+        case LWCELL_CMD_PPP_RESUME: { /* Return to data mode */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("O");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_PPP_HANGUP: { /* End session */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("H");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_RESET_WARM_START
+        case LWCELL_CMD_RESET_WARM_CHECK: { /* Query settings device may have kept from before */
+            LWCELL_MEMSET(&warm, 0x00, sizeof(warm));
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CFUN?;+CMEE?;+CREG?");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_RESET_WARM_START */
+#if LWCELL_CFG_RESET_PROBE
+        case LWCELL_CMD_RESET_PROBE: { /* Check if device accepts commands */
+            if (!probe.active) {
+                probe.active = 1;
+                probe.urc = 0;
+                probe.start = lwcell_sys_now();
+            }
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_END_AT();
+            lwcell_timeout_add(LWCELL_CFG_RESET_PROBE_INTERVAL, prv_probe_timeout_fn, NULL);
+            break;
+        }
+#endif /* LWCELL_CFG_RESET_PROBE */
         case LWCELL_CMD_ATE0:
         case LWCELL_CMD_ATE1: {
             AT_PORT_SEND_BEGIN_AT();
@@ -1944,8 +3002,13 @@ lwcelli_initiate_cmd(lwcell_msg_t* msg) {
             /* Do we have network connection? */
             /* Check if we are connected to network */
 
-            msg->msg.conn_start.num = 0;                              /* Start with max value = invalidated */
-            for (int16_t i = LWCELL_CFG_MAX_CONNS - 1; i >= 0; --i) { /* Find available connection */
+            msg->msg.conn_start.num = 0;                                               /* Start with max value = invalidated */
+            for (int16_t i = LWCELL_I16(lwcell.m.limits.conns_max) - 1; i >= 0; --i) { /* Find available connection */
+#if LWCELL_CFG_EVT_DEFER
+                if (lwcelli_evt_defer_conn_pending(i)) {
+                    continue; /* Worker threads still deliver events of previous connection on this slot */
+                }
+#endif /* LWCELL_CFG_EVT_DEFER */
                 if (!lwcell.m.conns[i].status.f.active) {
                     c = &lwcell.m.conns[i];
                     c->num = LWCELL_U8(i);
@@ -2272,6 +3335,10 @@ lwcelli_initiate_cmd(lwcell_msg_t* msg) {
 lwcellr_t
 lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwcell_msg_t*), uint32_t max_block_time) {
     lwcellr_t res = msg->res = lwcellOK;
+#if LWCELL_CFG_OS
+    const uint8_t is_blocking = msg->is_blocking; /* Non-blocking message may be released once queued */
+    lwcell_sys_mbox_t* mbox = &lwcell.mbox_producer;
+#endif                                            /* LWCELL_CFG_OS */
 
     /* Check here if stack is even enabled or shall we disable new command entry? */
     lwcell_core_lock();
@@ -2283,32 +3350,86 @@ lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwc
     if (res == lwcellOK && !lwcell.status.f.dev_present) {
         res = lwcellERRNODEVICE; /* No device connected */
     }
+#if LWCELL_CFG_CACHE
+    /* Answer query with fresh value without accessing device */
+    if (res == lwcellOK && lwcelli_cache_answer(msg)) {
+        lwcell_core_unlock();
+        LWCELL_MSG_VAR_FREE(msg);
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_CACHE */
+#if !LWCELL_CFG_OS
+    /* There is no other thread to execute command while caller waits */
+    if (res == lwcellOK && msg->is_blocking) {
+        res = lwcellERRBLOCKING;
+    }
+#endif /* !LWCELL_CFG_OS */
     lwcell_core_unlock();
     if (res != lwcellOK) {
         LWCELL_MSG_VAR_FREE(msg); /* Free memory and return */
         return res;
     }
 
+#if LWCELL_CFG_OS
     if (msg->is_blocking) {                         /* In case message is blocking */
         if (!lwcell_sys_sem_create(&msg->sem, 0)) { /* Create semaphore and lock it immediately */
             LWCELL_MSG_VAR_FREE(msg);               /* Release memory and return */
             return lwcellERRMEM;
         }
     }
+#endif                           /* LWCELL_CFG_OS */
     if (!msg->cmd) {             /* Set start command if not set by user */
         msg->cmd = msg->cmd_def; /* Set it as default */
     }
     msg->block_time = max_block_time; /* Set blocking status if necessary */
     msg->fn = process_fn;             /* Save processing function to be called as callback */
-    if (msg->is_blocking) {
-        lwcell_sys_mbox_put(&lwcell.mbox_producer, msg); /* Write message to producer queue and wait forever */
-    } else {
-        if (!lwcell_sys_mbox_putnow(&lwcell.mbox_producer, msg)) { /* Write message to producer queue immediately */
-            LWCELL_MSG_VAR_FREE(msg);                              /* Release message */
+#if LWCELL_CFG_CMD_STATS || LWCELL_CFG_CMD_PRIO || LWCELL_CFG_CMD_CANCEL
+    msg->time_queued = lwcell_sys_now();
+#endif /* LWCELL_CFG_CMD_STATS || LWCELL_CFG_CMD_PRIO || LWCELL_CFG_CMD_CANCEL */
+    LWCELL_TRACE(MBOX_PRODUCER_PUT, msg->cmd_def, msg->is_blocking, 0, 0);
+#if LWCELL_CFG_CMD_COALESCE
+    /* Identical query is already pending, message is completed together with it */
+    if (lwcelli_cmd_coalesce_attach(msg)) {
+        LWCELL_METRICS_ADD(CMD_COALESCED, 1);
+    } else
+#endif /* LWCELL_CFG_CMD_COALESCE */
+    {
+#if LWCELL_CFG_CMD_CANCEL
+        lwcelli_cmd_cancel_queued(msg);
+#endif /* LWCELL_CFG_CMD_CANCEL */
+#if LWCELL_CFG_CMUX
+        lwcell_core_lock();
+        msg->cmux_ch = lwcelli_cmux_channel(msg);
+        if (msg->cmux_ch == LWCELL_CMUX_CH_DATA) {
+            mbox = &lwcell.mbox_data; /* Executed in parallel to commands on control channel */
+        }
+        lwcell_core_unlock();
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_OS
+        if (msg->is_blocking) {
+            lwcell_sys_mbox_put(mbox, msg);           /* Write message to producer queue and wait forever */
+        } else if (!lwcell_sys_mbox_putnow(mbox, msg)) { /* Write message to producer queue immediately */
+#else                                                                     /* LWCELL_CFG_OS */
+        if (!lwcelli_msg_queue_put(msg)) { /* Write message to command queue */
+#endif                                                                    /* !LWCELL_CFG_OS */
+            LWCELL_TRACE(MBOX_PRODUCER_PUT, msg->cmd_def, msg->is_blocking, lwcellERRMEM, 0);
+            LWCELL_METRICS_ADD(PRODUCER_MBOX_FULL, 1);
+#if LWCELL_CFG_CMD_CANCEL
+            lwcelli_cmd_cancel_dequeued(msg);
+#endif /* LWCELL_CFG_CMD_CANCEL */
+#if LWCELL_CFG_CMD_COALESCE
+            lwcelli_cmd_coalesce_abort(msg, lwcellERRMEM); /* Fail queries attached in the meantime */
+#endif                                                     /* LWCELL_CFG_CMD_COALESCE */
+            LWCELL_MSG_VAR_FREE(msg);                      /* Release message */
             return lwcellERRMEM;
         }
+        LWCELL_METRICS_MBOX_PUT(PRODUCER);
+#if LWCELL_CFG_SINGLE_THREAD
+        lwcelli_process_wakeup(); /* Event loop picks up command from producer queue */
+#endif                            /* LWCELL_CFG_SINGLE_THREAD */
     }
-    if (res == lwcellOK && msg->is_blocking) { /* In case we have blocking request */
+#if LWCELL_CFG_OS
+    if (res == lwcellOK && is_blocking) { /* In case we have blocking request */
         uint32_t time;
         time = lwcell_sys_sem_wait(&msg->sem, 0); /* Wait forever for semaphore */
         if (time == LWCELL_SYS_TIMEOUT) {         /* If semaphore was not accessed within given time */
@@ -2318,9 +3439,237 @@ lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwc
         }
         LWCELL_MSG_VAR_FREE(msg); /* Release message */
     }
+#endif /* LWCELL_CFG_OS */
+    return res;
+}
+
+/**
+ * \brief           Clear state of sub-command sequences, that previous message may have left behind
+ *                  and prepare sequence of new message
+ * \param[in]       msg: Message to start
+ */
+static void
+prv_sequence_start(lwcell_msg_t* msg) {
+    lwcell_timeout_remove(prv_cmd_delay_fn); /* Delay of previous message may have been interrupted by timeout */
+    cmd_delay.reset_hw = 0;
+#if LWCELL_CFG_AT_BATCH
+    batch.cmds = NULL; /* Batch of previous message may have been interrupted by timeout */
+#endif                 /* LWCELL_CFG_AT_BATCH */
+#if LWCELL_CFG_RESET_PROBE
+    if (probe.active) { /* Probing of previous message may have been interrupted by timeout */
+        lwcell_timeout_remove(prv_probe_timeout_fn);
+        probe.active = 0;
+    }
+    probe.after_reset = 0;
+#endif /* LWCELL_CFG_RESET_PROBE */
+#if LWCELL_CFG_RESET_WARM_START
+    warm.active = 0;
+#endif /* LWCELL_CFG_RESET_WARM_START */
+#if LWCELL_CFG_CMUX
+    if (msg->cmd_def == LWCELL_CMD_RESET) {
+        lwcelli_cmux_close(); /* Every reset sequence starts in plain AT mode */
+    }
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+    lwcell_timeout_remove(prv_baud_timeout_fn); /* Negotiation of previous message may have been interrupted */
+    baud.is_restore = 0;
+    if (msg->cmd_def == LWCELL_CMD_RESET && lwcell.ll.uart.baudrate != LWCELL_CFG_AT_PORT_BAUDRATE) {
+        /* Every reset sequence starts at default baudrate, return device to it first */
+        msg->cmd = prv_baud_begin(LWCELL_CFG_AT_PORT_BAUDRATE, msg->cmd);
+        baud.is_restore = 1;
+    } else if (msg->cmd_def == LWCELL_CMD_RESET) {
+        /* Device may have kept negotiated baudrate over host restart, look for it when it does not respond */
+        baud.resume = msg->cmd;
+        baud.scan = 0;
+        msg->cmd = LWCELL_CMD_UART_SCAN;
+    }
+#endif /* LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+#if !LWCELL_CFG_CMUX && !LWCELL_CFG_AT_BAUDRATE_NEGOTIATE
+    LWCELL_UNUSED(msg);
+#endif /* !LWCELL_CFG_CMUX && !LWCELL_CFG_AT_BAUDRATE_NEGOTIATE */
+}
+
+/**
+ * \brief           Start execution of message taken from producer queue
+ * \note            Function must be called with core locked.
+ *                  Delay of reset command must be handled by caller
+ * \param[in]       msg: Message to start
+ * \return          \ref lwcellOK when command has been started and its completion is pending,
+ *                      member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcelli_msg_start(lwcell_msg_t* msg) {
+    lwcellr_t res = lwcellOK;
+#if LWCELL_CFG_CMUX
+    uint8_t ch = lwcelli_channel_select(msg->cmux_ch);
+#endif /* LWCELL_CFG_CMUX */
+
+    lwcell.msg = msg; /* Set message handle */
+#if LWCELL_CFG_CMUX
+    if (msg->cmux_ch == LWCELL_CMUX_CH_CTRL) /* Sub-command sequences only run on control channel */
+#endif                                       /* LWCELL_CFG_CMUX */
+    {
+        prv_sequence_start(msg);
+    }
+
+    /*
+     * This check is performed when adding command to queue
+     * Do it again here to prevent long timeouts,
+     * if device present flag changes
+     */
+    if (!lwcell.status.f.dev_present) {
+        res = lwcellERRNODEVICE;
+    }
+#if LWCELL_CFG_CMD_CANCEL
+    /* Drop stale or cancelled command before it reaches device */
+    if (res == lwcellOK) {
+        res = lwcelli_cmd_cancel_check(msg);
+    } else {
+        lwcelli_cmd_cancel_dequeued(msg);
+    }
+#endif /* LWCELL_CFG_CMD_CANCEL */
+#if LWCELL_CFG_PPP
+    if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_PPP_START && lwcelli_ppp_is_session()) {
+        res = lwcellERR; /* Only one session at a time */
+    } else if (res == lwcellOK && lwcelli_ppp_is_online(CHANNEL_CUR())) {
+        /* Device accepts commands only after escape to command mode */
+        ppp_esc.resume = msg->cmd;
+        msg->cmd = LWCELL_CMD_PPP_ESCAPE;
+    }
+#endif /* LWCELL_CFG_PPP */
+    if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_RESET) {
+        lwcelli_reset_everything(1); /* Reset stack before trying to reset */
+    }
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT
+    if (res == lwcellOK) {
+        lwcelli_cmd_adapt_timeout(msg); /* Shorten timeout based on observed latency */
+    }
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT */
+#if LWCELL_CFG_PPP
+    if (res == lwcellOK && msg->cmd == LWCELL_CMD_PPP_ESCAPE && msg->block_time > 0) {
+        msg->block_time += 3 * LWCELL_CFG_PPP_ESCAPE_GUARD; /* Guard times and return to data mode */
+    }
+#endif /* LWCELL_CFG_PPP */
+
+    /*
+     * Try to call function to process this message
+     * Usually it should be function to transmit data to AT port
+     */
+    if (res == lwcellOK) {
+        res = msg->fn != NULL ? msg->fn(msg) : lwcellERR;
+    }
+    if (res != lwcellOK) {
+        msg->is_done = 1; /* Command did not start, completion must not be signalled */
+    }
+#if LWCELL_CFG_CMUX
+    lwcelli_channel_select(ch);
+#endif /* LWCELL_CFG_CMUX */
     return res;
 }
 
+/**
+ * \brief           Finish execution of active message
+ *
+ * Notifies application about the result and releases blocking caller or frees the message
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to finish
+ * \param[in]       res: Result of execution. Use \ref lwcellOK when command finished in processing thread,
+ *                      to keep result set by the parser
+ * \param[in]       time_start: Time when message has been taken from producer queue
+ */
+void
+lwcelli_msg_finish(lwcell_msg_t* msg, lwcellr_t res, uint32_t time_start) {
+#if LWCELL_CFG_CMUX
+    uint8_t ch = lwcelli_channel_select(msg->cmux_ch);
+#endif /* LWCELL_CFG_CMUX */
+
+    /* Notify application on command timeout */
+    if (res == lwcellTIMEOUT) {
+        lwcelli_send_cb(LWCELL_EVT_CMD_TIMEOUT);
+    }
+
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE, res == lwcellTIMEOUT,
+                  "[LWCELL THREAD] Timeout in produce thread waiting for command to finish in process thread\r\n");
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE,
+                  res != lwcellOK && res != lwcellTIMEOUT, "[LWCELL THREAD] Could not start execution for command %d\r\n",
+                  (int)msg->cmd);
+
+    if (res != lwcellOK) {
+        /* Process global callbacks */
+        lwcelli_process_events_for_timeout_or_error(msg, res);
+
+        msg->res = res; /* Save response */
+    }
+#if LWCELL_CFG_PPP
+    if (msg->cmd == LWCELL_CMD_PPP_ESCAPE) {
+        lwcell_timeout_remove(prv_ppp_escape_fn);
+        lwcelli_ppp_resume(); /* Escape was not confirmed, device stays in data mode */
+    }
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_CMD_STATS
+    lwcelli_cmd_stats_record(msg->cmd_def, msg->res, time_start - msg->time_queued, lwcell_sys_now() - time_start);
+#endif /* LWCELL_CFG_CMD_STATS */
+#if LWCELL_CFG_CMD_ADAPT_TIMEOUT
+    /* Result passed to function tells if command started, message result tells how it finished */
+    lwcelli_cmd_adapt_record(msg->cmd_def, res == lwcellOK ? msg->res : res, lwcell_sys_now() - time_start);
+#endif /* LWCELL_CFG_CMD_ADAPT_TIMEOUT */
+#if !LWCELL_CFG_CMD_STATS && !LWCELL_CFG_CMD_ADAPT_TIMEOUT
+    LWCELL_UNUSED(time_start);
+#endif /* !LWCELL_CFG_CMD_STATS && !LWCELL_CFG_CMD_ADAPT_TIMEOUT */
+
+#if LWCELL_CFG_USE_API_FUNC_EVT
+    /* Send event function to user */
+    if (msg->evt_fn != NULL) {
+        msg->evt_fn(msg->res, msg->evt_arg); /* Send event with user argument */
+    }
+#endif /* LWCELL_CFG_USE_API_FUNC_EVT */
+#if LWCELL_CFG_CMD_COALESCE
+    lwcelli_cmd_coalesce_finish(msg); /* Complete identical queries attached to this one */
+#endif                                /* LWCELL_CFG_CMD_COALESCE */
+
+    /*
+     * In case message is blocking,
+     * release semaphore and notify finished with processing
+     * otherwise directly free memory of message structure
+     */
+#if LWCELL_CFG_OS
+    if (msg->is_blocking) {
+        lwcell_sys_sem_release(&msg->sem);
+    } else
+#endif /* LWCELL_CFG_OS */
+    {
+        LWCELL_MSG_VAR_FREE(msg);
+    }
+    lwcell.msg = NULL;
+#if LWCELL_CFG_CMUX
+    lwcelli_channel_select(ch);
+#endif /* LWCELL_CFG_CMUX */
+}
+
+/**
+ * \brief           Wake-up processing thread or event loop
+ *
+ * Called when new data are received, new timeout is added
+ * or, in single-thread mode, when new command is put to producer queue
+ */
+void
+lwcelli_process_wakeup(void) {
+#if LWCELL_CFG_OS && (!LWCELL_CFG_SINGLE_THREAD || LWCELL_CFG_LOOP_THREAD)
+    /* Write empty box to wake up thread, don't care if write fails */
+    if (lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL)) {
+        LWCELL_METRICS_MBOX_PUT(PROCESS);
+    } else {
+        LWCELL_METRICS_ADD(PROCESS_MBOX_FULL, 1);
+    }
+#endif /* LWCELL_CFG_OS && (!LWCELL_CFG_SINGLE_THREAD || LWCELL_CFG_LOOP_THREAD) */
+#if LWCELL_CFG_SINGLE_THREAD
+    if (lwcell.loop_wakeup_fn != NULL) {
+        lwcell.loop_wakeup_fn(lwcell.loop_wakeup_arg);
+    }
+#endif /* LWCELL_CFG_SINGLE_THREAD */
+}
+
 /**
  * \brief           Process events in case of timeout on command or invalid message (if device is not present)
  *
@@ -0,0 +1,171 @@
+/**
+ * \file            lwcell_lock.c
+ * \brief           Lock domains and statistics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_lock.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_LOCK_STATS || __DOXYGEN__
+
+/* Each entry is only modified with its own lock held */
+static lwcell_lock_stats_t lock_stats[LWCELL_LOCK_END];
+static uint32_t lock_hold_start[LWCELL_LOCK_END];
+
+/**
+ * \brief           Record outermost lock acquisition
+ * \note            Function must be called with lock held
+ * \param[in]       lock: Lock domain
+ * \param[in]       is_contended: Set to `1` when lock was held by other thread and caller had to wait
+ * \param[in]       req_time: Time when thread requested the lock
+ */
+void
+lwcelli_lock_acquired(lwcell_lock_t lock, uint8_t is_contended, uint32_t req_time) {
+    lwcell_lock_stats_t* st = &lock_stats[lock];
+    uint32_t now = LWCELL_LOCK_STATS_TIME(), wait = now - req_time;
+
+    ++st->acquired;
+    if (is_contended) {
+        ++st->contended;
+        st->wait_sum += wait;
+        if (wait > st->wait_max) {
+            st->wait_max = wait;
+        }
+    }
+    lock_hold_start[lock] = now;
+}
+
+/**
+ * \brief           Record outermost lock release
+ * \note            Function must be called with lock still held
+ * \param[in]       lock: Lock domain
+ */
+void
+lwcelli_lock_released(lwcell_lock_t lock) {
+    lwcell_lock_stats_t* st = &lock_stats[lock];
+    uint32_t hold = LWCELL_LOCK_STATS_TIME() - lock_hold_start[lock];
+
+    st->hold_sum += hold;
+    if (hold > st->hold_max) {
+        st->hold_max = hold;
+    }
+}
+
+/**
+ * \brief           Get lock statistics
+ * \param[in]       lock: Lock domain
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_lock_get_stats(lwcell_lock_t lock, lwcell_lock_stats_t* stats) {
+    LWCELL_ASSERT(lock < LWCELL_LOCK_END);
+    LWCELL_ASSERT(stats != NULL);
+
+    if (lock == LWCELL_LOCK_MEM) {
+        lwcelli_mem_lock();
+        LWCELL_MEMCPY(stats, &lock_stats[lock], sizeof(*stats));
+        lwcelli_mem_unlock();
+    } else {
+        lwcell_core_lock();
+        LWCELL_MEMCPY(stats, &lock_stats[lock], sizeof(*stats));
+        lwcell_core_unlock();
+    }
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_LOCK_STATS || __DOXYGEN__ */
+
+#if LWCELL_CFG_LOCK_DOMAINS || __DOXYGEN__
+
+static lwcell_sys_mutex_t mem_mutex; /*!< Memory lock, core lock is used until created */
+static size_t mem_locked_cnt;        /*!< Memory lock nesting counter */
+
+/**
+ * \brief           Create memory lock
+ * \note            Function is called from \ref lwcell_init, before library threads are started
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_lock_init(void) {
+    if (lwcell_sys_mutex_isvalid(&mem_mutex)) {
+        return 1;
+    }
+    return lwcell_sys_mutex_create(&mem_mutex);
+}
+
+/**
+ * \brief           Lock memory domain
+ */
+void
+lwcelli_mem_lock(void) {
+#if LWCELL_CFG_LOCK_STATS
+    uint32_t req_time = LWCELL_LOCK_STATS_TIME();
+    uint8_t is_contended = 0;
+#endif /* LWCELL_CFG_LOCK_STATS */
+
+    if (!lwcell_sys_mutex_isvalid(&mem_mutex)) {
+        lwcell_core_lock();
+        return;
+    }
+#if LWCELL_CFG_LOCK_STATS
+    if (!lwcell_sys_mutex_trylock(&mem_mutex)) {
+        is_contended = 1; /* Held by other thread, wait for it */
+        lwcell_sys_mutex_lock(&mem_mutex);
+    }
+#else  /* LWCELL_CFG_LOCK_STATS */
+    lwcell_sys_mutex_lock(&mem_mutex);
+#endif /* !LWCELL_CFG_LOCK_STATS */
+    if (++mem_locked_cnt == 1) {
+#if LWCELL_CFG_LOCK_STATS
+        lwcelli_lock_acquired(LWCELL_LOCK_MEM, is_contended, req_time);
+#endif /* LWCELL_CFG_LOCK_STATS */
+    }
+}
+
+/**
+ * \brief           Unlock memory domain
+ */
+void
+lwcelli_mem_unlock(void) {
+    if (!lwcell_sys_mutex_isvalid(&mem_mutex)) {
+        lwcell_core_unlock();
+        return;
+    }
+    if (mem_locked_cnt-- == 1) {
+#if LWCELL_CFG_LOCK_STATS
+        lwcelli_lock_released(LWCELL_LOCK_MEM);
+#endif /* LWCELL_CFG_LOCK_STATS */
+    }
+    lwcell_sys_mutex_unlock(&mem_mutex);
+}
+
+#endif /* LWCELL_CFG_LOCK_DOMAINS || __DOXYGEN__ */
@@ -0,0 +1,280 @@
+/**
+ * \file            lwcell_loop.c
+ * \brief           Single-thread event loop
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_loop.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__
+
+static lwcell_msg_t* delayed_msg; /*!< Reset message waiting for its start delay to expire */
+static uint32_t cmd_time;         /*!< Time when active command started or delayed message was taken */
+
+#if !LWCELL_CFG_OS || __DOXYGEN__
+
+static lwcell_msg_t* msg_queue[LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE]; /*!< Command queue without OS */
+static size_t msg_queue_r, msg_queue_cnt;                             /*!< Read index and number of entries */
+
+/**
+ * \brief           Put message to command queue, used instead of producer message queue without OS
+ * \param[in]       msg: Message to put to queue
+ * \return          `1` on success, `0` if queue is full
+ */
+uint8_t
+lwcelli_msg_queue_put(lwcell_msg_t* msg) {
+    uint8_t ret = 0;
+
+    lwcell_core_lock();
+    if (msg_queue_cnt < LWCELL_ARRAYSIZE(msg_queue)) {
+        msg_queue[(msg_queue_r + msg_queue_cnt) % LWCELL_ARRAYSIZE(msg_queue)] = msg;
+        ++msg_queue_cnt;
+        ret = 1;
+    }
+    lwcell_core_unlock();
+    return ret;
+}
+
+/**
+ * \brief           Get next message from command queue
+ * \param[out]      msg: Pointer to output message
+ * \return          `1` on success, `0` if queue is empty
+ */
+static uint8_t
+prv_msg_queue_get(lwcell_msg_t** msg) {
+    if (msg_queue_cnt == 0) {
+        return 0;
+    }
+    *msg = msg_queue[msg_queue_r];
+    msg_queue_r = (msg_queue_r + 1) % LWCELL_ARRAYSIZE(msg_queue);
+    --msg_queue_cnt;
+    return 1;
+}
+
+#endif /* !LWCELL_CFG_OS || __DOXYGEN__ */
+
+/**
+ * \brief           Get next message from producer queue
+ * \param[out]      msg: Pointer to output message
+ * \return          `1` on success, `0` if queue is empty
+ */
+static uint8_t
+prv_queue_getnow(lwcell_msg_t** msg) {
+#if LWCELL_CFG_OS
+    if (!lwcell_sys_mbox_getnow(&lwcell.mbox_producer, (void**)msg)) {
+#else  /* LWCELL_CFG_OS */
+    if (!prv_msg_queue_get(msg)) {
+#endif /* !LWCELL_CFG_OS */
+        return 0;
+    }
+    LWCELL_THREAD_PRODUCER_HOOK(); /* Execute producer thread hook */
+    LWCELL_METRICS_MBOX_GET(PRODUCER);
+    LWCELL_TRACE(MBOX_PRODUCER_GET, (*msg)->cmd_def, 0, 0, 0);
+    return 1;
+}
+
+/**
+ * \brief           Get next message to execute
+ * \param[out]      msg: Pointer to output message
+ * \return          `1` on success, `0` if there is no message waiting
+ */
+static uint8_t
+prv_msg_get(lwcell_msg_t** msg) {
+#if LWCELL_CFG_CMD_PRIO
+    lwcell_msg_t* m;
+
+    /* Sort queued messages to priority classes, up to producer queue size, and take the one to execute */
+    while (!lwcelli_cmd_prio_is_full() && prv_queue_getnow(&m)) {
+        lwcelli_cmd_prio_put(m);
+    }
+    return (*msg = lwcelli_cmd_prio_get()) != NULL;
+#else  /* LWCELL_CFG_CMD_PRIO */
+    return prv_queue_getnow(msg);
+#endif /* !LWCELL_CFG_CMD_PRIO */
+}
+
+/**
+ * \brief           Get remaining time from start time and duration
+ * \param[in]       now: Current time
+ * \param[in]       duration: Duration in units of milliseconds
+ * \return          Remaining time in units of milliseconds, `0` when expired
+ */
+static uint32_t
+prv_remaining(uint32_t now, uint32_t duration) {
+    uint32_t diff = now - cmd_time;
+    return diff >= duration ? 0 : duration - diff;
+}
+
+/**
+ * \brief           Check active command for completion or timeout
+ */
+static void
+prv_cmd_check_active(void) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    if (msg == NULL) {
+        return;
+    }
+    if (msg->is_done) {
+        lwcelli_msg_finish(msg, lwcellOK, cmd_time);
+    } else if (msg->block_time > 0 && prv_remaining(lwcell_sys_now(), msg->block_time) == 0) {
+        msg->is_done = 1; /* Ignore late response */
+        lwcelli_msg_finish(msg, lwcellTIMEOUT, cmd_time);
+    }
+}
+
+/**
+ * \brief           Start queued commands until one of them remains active
+ */
+static void
+prv_cmd_start_next(void) {
+    lwcell_msg_t* msg;
+    lwcellr_t res;
+
+    while (lwcell.msg == NULL) {
+        if (delayed_msg != NULL) {
+            if (prv_remaining(lwcell_sys_now(), delayed_msg->msg.reset.delay) > 0) {
+                return;
+            }
+            msg = delayed_msg;
+            delayed_msg = NULL;
+        } else {
+            if (!prv_msg_get(&msg)) {
+                return;
+            }
+
+            /* Reset message can have delay, loop must not block */
+            if (lwcell.status.f.dev_present && msg->cmd_def == LWCELL_CMD_RESET && msg->msg.reset.delay > 0) {
+                delayed_msg = msg;
+                cmd_time = lwcell_sys_now();
+                continue;
+            }
+        }
+
+        cmd_time = lwcell_sys_now();
+        res = lwcelli_msg_start(msg);
+        if (res != lwcellOK) {
+            lwcelli_msg_finish(msg, res, cmd_time);
+        } else if (msg->is_done) { /* Command may have finished already within start */
+            lwcelli_msg_finish(msg, lwcellOK, cmd_time);
+        }
+    }
+}
+
+/**
+ * \brief           Run single iteration of event loop
+ *
+ * Processes received data, expired timeouts, checks active command
+ * for completion or timeout and starts next command from producer queue.
+ * Function never blocks.
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_loop_process(void) {
+    if (!lwcell.status.f.initialized) {
+        return lwcellERR;
+    }
+    lwcell_core_lock();
+#if !LWCELL_CFG_INPUT_USE_PROCESS
+    lwcelli_process_buffer(); /* Process input data */
+#endif                        /* !LWCELL_CFG_INPUT_USE_PROCESS */
+    lwcelli_timeout_process_expired();
+    prv_cmd_check_active();
+    prv_cmd_start_next();
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Poll stack from application main loop
+ *
+ * Used in bare-metal mode, when \ref LWCELL_CFG_OS is disabled.
+ * It is the same as \ref lwcell_loop_process and can be called as often as application wants,
+ * at least each time wake-up function is called or when \ref lwcell_loop_get_next_timeout expires.
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_poll(void) {
+    return lwcell_loop_process();
+}
+
+/**
+ * \brief           Get maximal time loop may wait before \ref lwcell_loop_process must be called again
+ *
+ * Loop must also run earlier, each time wake-up function is called.
+ *
+ * \return          Time in units of milliseconds or \ref LWCELL_LOOP_NO_TIMEOUT
+ *                      when loop waits only for wake-up
+ */
+uint32_t
+lwcell_loop_get_next_timeout(void) {
+    uint32_t time, rem, now;
+
+    lwcell_core_lock();
+    now = lwcell_sys_now();
+    time = lwcelli_timeout_get_next();
+    if (lwcell.msg != NULL) {
+        if (lwcell.msg->is_done) {
+            time = 0;
+        } else if (lwcell.msg->block_time > 0) {
+            rem = prv_remaining(now, lwcell.msg->block_time);
+            time = LWCELL_MIN(time, rem);
+        }
+    } else if (delayed_msg != NULL) {
+        rem = prv_remaining(now, delayed_msg->msg.reset.delay);
+        time = LWCELL_MIN(time, rem);
+    }
+    lwcell_core_unlock();
+    return time;
+}
+
+/**
+ * \brief           Set function called when event loop has new work
+ *
+ * It is used to signal application pollable handle, when loop runs in application event loop.
+ * With built-in loop thread, function is called in addition to waking up the thread.
+ *
+ * \note            Function must be called before \ref lwcell_init,
+ *                  as wake-up function is used without core lock from any thread
+ * \param[in]       fn: Wake-up function. Set to `NULL` to disable
+ * \param[in]       arg: Custom user argument passed to wake-up function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_loop_set_wakeup_fn(lwcell_loop_wakeup_fn fn, void* arg) {
+    lwcell.loop_wakeup_arg = arg;
+    lwcell.loop_wakeup_fn = fn;
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__ */
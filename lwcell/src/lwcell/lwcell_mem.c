@@ -57,9 +57,11 @@ typedef struct mem_block {
 #define MEM_BLOCK_FROM_PTR(ptr)  ((mem_block_t*)(((uint8_t*)(ptr)) - MEMBLOCK_METASIZE))
 #define MEM_BLOCK_USER_SIZE(ptr) ((MEM_BLOCK_FROM_PTR(ptr)->size & ~MEM_ALLOC_BIT) - MEMBLOCK_METASIZE)
 
-static mem_block_t start_block;    /*!< First block data for allocations */
-static mem_block_t* end_block;     /*!< Pointer to last block in linked list */
-static size_t mem_available_bytes; /*!< Number of available bytes for allocations */
+static mem_block_t start_block;        /*!< First block data for allocations */
+static mem_block_t* end_block;         /*!< Pointer to last block in linked list */
+static size_t mem_available_bytes;     /*!< Number of available bytes for allocations */
+static size_t mem_total_bytes;         /*!< Number of bytes available after regions were assigned */
+static size_t mem_min_available_bytes; /*!< Minimal number of available bytes ever */
 
 /**
  * \brief           Insert a new block to linked list of free blocks
@@ -203,6 +205,8 @@ mem_assignmem(const lwcell_mem_region_t* regions, size_t len) {
         /* Set number of free bytes available to allocate in region */
         mem_available_bytes += first_block->size;
     }
+    mem_total_bytes = mem_available_bytes;
+    mem_min_available_bytes = mem_available_bytes;
 
     return 1; /* Regions set as expected */
 }
@@ -274,6 +278,9 @@ mem_alloc(size_t size) {
         curr->next = NULL;             /* Clear next free block pointer as there is no one */
 
         mem_available_bytes -= size;   /* Decrease available memory */
+        if (mem_available_bytes < mem_min_available_bytes) {
+            mem_min_available_bytes = mem_available_bytes;
+        }
     } else {
         /* Allocation failed, no free blocks of required size */
     }
@@ -362,9 +369,13 @@ mem_realloc(void* ptr, size_t size) {
 void*
 lwcell_mem_malloc(size_t size) {
     void* ptr;
-    lwcell_core_lock();
+    lwcelli_mem_lock();
     ptr = mem_calloc(1, size); /* Allocate memory and return pointer */
-    lwcell_core_unlock();
+    lwcelli_mem_unlock();
+    LWCELL_TRACE(MEM_ALLOC, LWCELL_TRACE_PTR(ptr), size, 0, 0);
+    if (ptr == NULL) {
+        LWCELL_METRICS_ADD(MEM_FAILED, 1);
+    }
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Allocation failed: %d bytes\r\n", (int)size);
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr != NULL,
@@ -383,9 +394,15 @@ lwcell_mem_malloc(size_t size) {
  */
 void*
 lwcell_mem_realloc(void* ptr, size_t size) {
-    lwcell_core_lock();
-    ptr = mem_realloc(ptr, size); /* Reallocate and return pointer */
-    lwcell_core_unlock();
+    void* new_ptr;
+    lwcelli_mem_lock();
+    new_ptr = mem_realloc(ptr, size); /* Reallocate and return pointer */
+    lwcelli_mem_unlock();
+    LWCELL_TRACE(MEM_REALLOC, LWCELL_TRACE_PTR(new_ptr), LWCELL_TRACE_PTR(ptr), size, 0);
+    ptr = new_ptr;
+    if (ptr == NULL && size > 0) {
+        LWCELL_METRICS_ADD(MEM_FAILED, 1);
+    }
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Reallocation failed: %d bytes\r\n", (int)size);
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr != NULL,
@@ -403,9 +420,13 @@ lwcell_mem_realloc(void* ptr, size_t size) {
 void*
 lwcell_mem_calloc(size_t num, size_t size) {
     void* ptr;
-    lwcell_core_lock();
+    lwcelli_mem_lock();
     ptr = mem_calloc(num, size); /* Allocate memory and clear it to 0. Then return pointer */
-    lwcell_core_unlock();
+    lwcelli_mem_unlock();
+    LWCELL_TRACE(MEM_ALLOC, LWCELL_TRACE_PTR(ptr), num * size, 0, 0);
+    if (ptr == NULL) {
+        LWCELL_METRICS_ADD(MEM_FAILED, 1);
+    }
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Callocation failed: %d bytes\r\n", (int)size * (int)num);
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr != NULL,
@@ -426,9 +447,10 @@ lwcell_mem_free(void* ptr) {
     }
     LWCELL_DEBUGF(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, "[LWCELL MEM] Free size: %d, address: %p\r\n",
                   (int)MEM_BLOCK_USER_SIZE(ptr), ptr);
-    lwcell_core_lock();
+    LWCELL_TRACE(MEM_FREE, LWCELL_TRACE_PTR(ptr), 0, 0, 0);
+    lwcelli_mem_lock();
     mem_free(ptr);
-    lwcell_core_unlock();
+    lwcelli_mem_unlock();
 }
 
 /**
@@ -446,6 +468,21 @@ lwcell_mem_assignmemory(const lwcell_mem_region_t* regions, size_t len) {
     return ret;
 }
 
+/**
+ * \brief           Get allocator memory statistics
+ * \param[out]      total: Total number of bytes available for allocations after regions were assigned
+ * \param[out]      available: Currently available number of bytes
+ * \param[out]      min_available: Minimal number of available bytes since regions were assigned
+ */
+void
+lwcelli_mem_get_stats(size_t* total, size_t* available, size_t* min_available) {
+    lwcelli_mem_lock();
+    *total = mem_total_bytes;
+    *available = mem_available_bytes;
+    *min_available = mem_min_available_bytes;
+    lwcelli_mem_unlock();
+}
+
 #endif /* !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__ */
 
 /**
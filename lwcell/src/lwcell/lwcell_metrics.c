@@ -0,0 +1,190 @@
+/**
+ * \file            lwcell_metrics.c
+ * \brief           I/O and queue metrics
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_metrics.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+
+/* Use C11 relaxed atomics when available, otherwise fall back to system protection */
+#if !defined(__STDC_NO_ATOMICS__) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#include <stdatomic.h>
+#define METRICS_USE_ATOMICS 1
+typedef _Atomic uint32_t metric_val_t;
+#define METRIC_LOAD(m)        atomic_load_explicit(&metrics[(m)], memory_order_relaxed)
+#define METRIC_STORE(m, v)    atomic_store_explicit(&metrics[(m)], (v), memory_order_relaxed)
+#define METRIC_FETCH_ADD(m, v) atomic_fetch_add_explicit(&metrics[(m)], (v), memory_order_relaxed)
+#else /* !defined(__STDC_NO_ATOMICS__) ... */
+#define METRICS_USE_ATOMICS 0
+typedef volatile uint32_t metric_val_t;
+#define METRIC_LOAD(m)         metrics[(m)]
+#define METRIC_STORE(m, v)     metrics[(m)] = (v)
+#define METRIC_FETCH_ADD(m, v) prv_fetch_add((m), (v))
+#endif /* !defined(__STDC_NO_ATOMICS__) ... */
+
+static metric_val_t metrics[LWCELL_METRIC_END]; /*!< Metric counters */
+
+#if !METRICS_USE_ATOMICS
+/**
+ * \brief           Add value to metric under system protection
+ * \param[in]       metric: Metric to update
+ * \param[in]       val: Value to add
+ * \return          Metric value before addition
+ */
+static uint32_t
+prv_fetch_add(lwcell_metric_t metric, uint32_t val) {
+    uint32_t old;
+
+    lwcell_sys_protect();
+    old = metrics[metric];
+    metrics[metric] = old + val;
+    lwcell_sys_unprotect();
+    return old;
+}
+#endif /* !METRICS_USE_ATOMICS */
+
+/**
+ * \brief           Raise metric to value if it is larger than current one
+ * \param[in]       metric: Metric to update
+ * \param[in]       val: New value candidate
+ */
+static void
+prv_set_max(lwcell_metric_t metric, uint32_t val) {
+#if METRICS_USE_ATOMICS
+    uint32_t cur = METRIC_LOAD(metric);
+
+    while (val > cur
+           && !atomic_compare_exchange_weak_explicit(&metrics[metric], &cur, val, memory_order_relaxed,
+                                                     memory_order_relaxed)) {}
+#else  /* METRICS_USE_ATOMICS */
+    lwcell_sys_protect();
+    if (val > metrics[metric]) {
+        metrics[metric] = val;
+    }
+    lwcell_sys_unprotect();
+#endif /* !METRICS_USE_ATOMICS */
+}
+
+/**
+ * \brief           Add value to metric counter
+ * \param[in]       metric: Metric to update
+ * \param[in]       val: Value to add. Use `(uint32_t)-1` to decrease counter
+ */
+void
+lwcelli_metrics_add(lwcell_metric_t metric, uint32_t val) {
+    METRIC_FETCH_ADD(metric, val);
+}
+
+/**
+ * \brief           Account data received from device
+ * \param[in]       len: Number of bytes received in single input call
+ */
+void
+lwcelli_metrics_rx(size_t len) {
+    size_t bin = 0;
+
+    METRIC_FETCH_ADD(LWCELL_METRIC_RX_BYTES, LWCELL_U32(len));
+    METRIC_FETCH_ADD(LWCELL_METRIC_RX_CALLS, 1);
+    prv_set_max(LWCELL_METRIC_RX_CALL_MAX, LWCELL_U32(len));
+    for (len >>= 2; len > 0 && bin < LWCELL_METRICS_RX_HIST_LEN - 1; len >>= 2) {
+        ++bin;
+    }
+    METRIC_FETCH_ADD((lwcell_metric_t)(LWCELL_METRIC_RX_CALL_HIST + bin), 1);
+}
+
+/**
+ * \brief           Account entry successfully written to message queue
+ * \param[in]       depth_metric: Depth metric of message queue,
+ *                      its high-water mark must follow immediately
+ */
+void
+lwcelli_metrics_mbox_put(lwcell_metric_t depth_metric) {
+    prv_set_max((lwcell_metric_t)(depth_metric + 1), METRIC_FETCH_ADD(depth_metric, 1) + 1);
+}
+
+/**
+ * \brief           Get snapshot of all metrics
+ * \param[out]      m: Output structure to fill
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_metrics_get(lwcell_metrics_t* m) {
+    LWCELL_ASSERT(m != NULL);
+
+    LWCELL_MEMSET(m, 0x00, sizeof(*m));
+    m->rx_bytes = METRIC_LOAD(LWCELL_METRIC_RX_BYTES);
+    m->rx_calls = METRIC_LOAD(LWCELL_METRIC_RX_CALLS);
+    m->rx_call_max = METRIC_LOAD(LWCELL_METRIC_RX_CALL_MAX);
+    for (size_t i = 0; i < LWCELL_METRICS_RX_HIST_LEN; ++i) {
+        m->rx_call_hist[i] = METRIC_LOAD(LWCELL_METRIC_RX_CALL_HIST + i);
+    }
+    m->tx_bytes = METRIC_LOAD(LWCELL_METRIC_TX_BYTES);
+    m->tx_calls = METRIC_LOAD(LWCELL_METRIC_TX_CALLS);
+    m->producer_mbox_depth = METRIC_LOAD(LWCELL_METRIC_PRODUCER_MBOX_DEPTH);
+    m->producer_mbox_max = METRIC_LOAD(LWCELL_METRIC_PRODUCER_MBOX_MAX);
+    m->producer_mbox_full = METRIC_LOAD(LWCELL_METRIC_PRODUCER_MBOX_FULL);
+    m->process_mbox_depth = METRIC_LOAD(LWCELL_METRIC_PROCESS_MBOX_DEPTH);
+    m->process_mbox_max = METRIC_LOAD(LWCELL_METRIC_PROCESS_MBOX_MAX);
+    m->process_mbox_full = METRIC_LOAD(LWCELL_METRIC_PROCESS_MBOX_FULL);
+    m->ipd_ignored = METRIC_LOAD(LWCELL_METRIC_IPD_IGNORED);
+    m->ipd_skipped = METRIC_LOAD(LWCELL_METRIC_IPD_SKIPPED);
+    m->pbuf_failed = METRIC_LOAD(LWCELL_METRIC_PBUF_FAILED);
+    m->mem_failed = METRIC_LOAD(LWCELL_METRIC_MEM_FAILED);
+    m->cmd_coalesced = METRIC_LOAD(LWCELL_METRIC_CMD_COALESCED);
+    m->cache_hits = METRIC_LOAD(LWCELL_METRIC_CACHE_HITS);
+    m->cmd_canceled = METRIC_LOAD(LWCELL_METRIC_CMD_CANCELED);
+    m->cmd_expired = METRIC_LOAD(LWCELL_METRIC_CMD_EXPIRED);
+#if !LWCELL_CFG_MEM_CUSTOM
+    lwcelli_mem_get_stats(&m->mem_total, &m->mem_available, &m->mem_min_available);
+#endif /* !LWCELL_CFG_MEM_CUSTOM */
+    return lwcellOK;
+}
+
+/**
+ * \brief           Reset all counters to zero
+ *
+ * Current queue depths are kept, high-water marks are reset to current depth.
+ * Memory figures are provided by allocator and are not affected
+ */
+void
+lwcell_metrics_reset(void) {
+    for (size_t i = 0; i < LWCELL_METRIC_END; ++i) {
+        if (i != LWCELL_METRIC_PRODUCER_MBOX_DEPTH && i != LWCELL_METRIC_PROCESS_MBOX_DEPTH) {
+            METRIC_STORE(i, 0);
+        }
+    }
+    prv_set_max(LWCELL_METRIC_PRODUCER_MBOX_MAX, METRIC_LOAD(LWCELL_METRIC_PRODUCER_MBOX_DEPTH));
+    prv_set_max(LWCELL_METRIC_PROCESS_MBOX_MAX, METRIC_LOAD(LWCELL_METRIC_PROCESS_MBOX_DEPTH));
+}
+
+#endif /* LWCELL_CFG_METRICS || __DOXYGEN__ */
@@ -321,6 +321,7 @@ lwcelli_parse_creg(const char* str, uint8_t skip_first) {
         lwcelli_parse_number(&str);
     }
     lwcell.m.network.status = (lwcell_network_reg_status_t)lwcelli_parse_number(&str);
+    lwcelli_state_changed();
 
     /*
      * In case we are connected to network,
@@ -362,7 +363,8 @@ lwcelli_parse_csq(const char* str) {
         rssi = 0;
     }
     lwcell.m.rssi = rssi;                 /* Save RSSI to global variable */
-    if (lwcell.msg->cmd_def == LWCELL_CMD_CSQ_GET && lwcell.msg->msg.csq.rssi != NULL) {
+    lwcelli_state_changed();
+    if (CMD_IS_DEF(LWCELL_CMD_CSQ_GET) && lwcell.msg->msg.csq.rssi != NULL) {
         *lwcell.msg->msg.csq.rssi = rssi; /* Save to user variable */
     }
 
@@ -402,6 +404,7 @@ lwcelli_parse_cpin(const char* str, uint8_t send_evt) {
     /* React only on change */
     if (state != lwcell.m.sim.state) {
         lwcell.m.sim.state = state;
+        lwcelli_state_changed();
         /*
          * In case SIM is ready,
          * start with basic info about SIM
@@ -451,6 +454,7 @@ lwcelli_parse_cops(const char* str) {
     } else {
         lwcell.m.network.curr_operator.format = LWCELL_OPERATOR_FORMAT_INVALID;
     }
+    lwcelli_state_changed();
 
     if (CMD_IS_DEF(LWCELL_CMD_COPS_GET)
         && lwcell.msg->msg.cops_get.curr != NULL) { /* Check and copy to user variable */
@@ -896,6 +900,7 @@ lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* con
         /* Check if we have to update status for application */
         if (lwcell.m.network.is_attached != tmp_pdp_state) {
             lwcell.m.network.is_attached = tmp_pdp_state;
+            lwcelli_state_changed();
 
             /* Notify upper layer */
             lwcelli_send_cb(lwcell.m.network.is_attached ? LWCELL_EVT_NETWORK_ATTACHED : LWCELL_EVT_NETWORK_DETACHED);
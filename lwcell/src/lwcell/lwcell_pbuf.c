@@ -80,7 +80,9 @@ lwcell_pbuf_new(size_t len) {
                   "[LWCELL PBUF] Failed to allocate %u bytes\r\n", (unsigned)len);
     LWCELL_DEBUGW(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, p != NULL, "[LWCELL PBUF] Allocated %u bytes on %p\r\n",
                   (unsigned)len, (void*)p);
-    if (p != NULL) {
+    if (p == NULL) {
+        LWCELL_METRICS_ADD(PBUF_FAILED, 1);
+    } else {
         p->next = NULL;                                        /* No next element in chain */
         p->tot_len = len;                                      /* Set total length of pbuf chain */
         p->len = len;                                          /* Set payload length */
@@ -114,9 +116,9 @@ lwcell_pbuf_free(lwcell_pbuf_p pbuf) {
      */
     cnt = 0;
     for (p = pbuf; p != NULL;) {
-        lwcell_core_lock();
+        lwcelli_mem_lock();
         ref = --p->ref; /* Decrease current value and save it */
-        lwcell_core_unlock();
+        lwcelli_mem_unlock();
         if (ref == 0) { /* Did we reach 0 and are ready to free it? */
             LWCELL_DEBUGF(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE,
                           "[LWCELL PBUF] Deallocating %p with len/tot_len: %u/%u\r\n", (void*)p, (unsigned)p->len,
@@ -267,7 +269,9 @@ lwcellr_t
 lwcell_pbuf_ref(lwcell_pbuf_p pbuf) {
     LWCELL_ASSERT(pbuf != NULL);
 
+    lwcelli_mem_lock();
     ++pbuf->ref; /* Increase reference count for pbuf */
+    lwcelli_mem_unlock();
     return lwcellOK;
 }
 
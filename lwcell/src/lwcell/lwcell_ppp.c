@@ -0,0 +1,288 @@
+/**
+ * \file            lwcell_ppp.c
+ * \brief           PPP data mode
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_ppp.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_PPP || __DOXYGEN__
+
+static const char no_carrier[] = CRLF "NO CARRIER" CRLF; /*!< Device left data mode */
+
+static struct {
+    uint8_t session;              /*!< Session is established, device may be temporarily in command mode */
+    uint8_t online;               /*!< Device is in data mode, received data bypass parser */
+    uint8_t ch;                   /*!< Channel of session, member of \ref lwcell_cmux_ch_t */
+    lwcell_ppp_input_fn input_fn; /*!< Function receiving data */
+    void* input_arg;              /*!< Custom argument for input function */
+    size_t nc_pos;                /*!< Number of matched characters of `NO CARRIER` indication */
+} ppp;
+static lwcell_ppp_stats_t ppp_stats; /*!< Session statistics */
+
+/**
+ * \brief           Check if device is in data mode on channel
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel, member of \ref lwcell_cmux_ch_t, `0` when multiplexer is not used
+ * \return          `1` if received data belong to PPP session, `0` otherwise
+ */
+uint8_t
+lwcelli_ppp_is_online(uint8_t ch) {
+    return ppp.online && ppp.ch == ch;
+}
+
+/**
+ * \brief           Check if session is established
+ * \note            Function must be called with core locked
+ * \return          `1` if session is established, `0` otherwise
+ */
+uint8_t
+lwcelli_ppp_is_session(void) {
+    return ppp.session;
+}
+
+/**
+ * \brief           Get channel of session
+ * \note            Function must be called with core locked
+ * \return          Member of \ref lwcell_cmux_ch_t, `0` when multiplexer is not used
+ */
+uint8_t
+lwcelli_ppp_channel(void) {
+    return ppp.ch;
+}
+
+/**
+ * \brief           Device entered data mode after dial command
+ * \note            Function must be called with core locked
+ * \param[in]       ch: Channel of session, member of \ref lwcell_cmux_ch_t, `0` when multiplexer is not used
+ * \param[in]       input_fn: Function receiving data
+ * \param[in]       input_arg: Custom argument for input function
+ */
+void
+lwcelli_ppp_connected(uint8_t ch, lwcell_ppp_input_fn input_fn, void* input_arg) {
+    ppp.session = 1;
+    ppp.online = 1;
+    ppp.ch = ch;
+    ppp.input_fn = input_fn;
+    ppp.input_arg = input_arg;
+    ppp.nc_pos = 0;
+    ++ppp_stats.sessions;
+}
+
+/**
+ * \brief           Device is being switched to command mode, session stays established
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_ppp_suspend(void) {
+    if (ppp.online) {
+        ppp.online = 0;
+        ++ppp_stats.escapes;
+    }
+}
+
+/**
+ * \brief           Device returned to data mode
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_ppp_resume(void) {
+    if (ppp.session) {
+        ppp.online = 1;
+        ppp.nc_pos = 0;
+    }
+}
+
+/**
+ * \brief           Session has ended
+ * \note            Function must be called with core locked
+ * \param[in]       by_device: Set to `1` when session was not ended by \ref lwcell_ppp_stop,
+ *                      to notify application with \ref LWCELL_EVT_PPP_DISCONNECTED event
+ */
+void
+lwcelli_ppp_closed(uint8_t by_device) {
+    if (!ppp.session) {
+        return;
+    }
+    ppp.session = 0;
+    ppp.online = 0;
+    if (by_device) {
+        lwcelli_send_cb(LWCELL_EVT_PPP_DISCONNECTED);
+    }
+}
+
+/**
+ * \brief           Process data received in data mode
+ * \note            Function must be called with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ */
+void
+lwcelli_ppp_input(const void* data, size_t len) {
+    const uint8_t* d = data;
+    uint8_t lost = 0;
+
+    if (len == 0) {
+        return;
+    }
+    ppp_stats.bytes_rx += LWCELL_U32(len);
+    if (ppp.input_fn != NULL) {
+        ppp.input_fn(data, len, ppp.input_arg);
+    }
+
+    /* Device reports end of session in plain text between frames */
+    for (size_t i = 0; i < len && !lost; ++i) {
+        if (d[i] == (uint8_t)no_carrier[ppp.nc_pos]) {
+            lost = ++ppp.nc_pos == sizeof(no_carrier) - 1;
+        } else {
+            ppp.nc_pos = d[i] == '\r' ? 1 : 0;
+        }
+    }
+    if (lost) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL PPP] Carrier lost, session ended by device\r\n");
+        ++ppp_stats.carrier_lost;
+        lwcelli_ppp_closed(1);
+    }
+}
+
+/**
+ * \brief           Start PPP session
+ *
+ * Device must be attached to network.
+ * Function finishes once device entered data mode,
+ * from that moment received data are passed to input function
+ *
+ * \param[in]       apn: APN address for PDP context or `NULL` to use context already defined in device
+ * \param[in]       input_fn: Function receiving data from device
+ * \param[in]       input_arg: Custom argument for input function
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_start(const char* apn, lwcell_ppp_input_fn input_fn, void* input_arg, const lwcell_api_cmd_evt_fn evt_fn,
+                 void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(input_fn != NULL);
+
+    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PPP_START;
+    LWCELL_MSG_VAR_REF(msg).cmd = apn != NULL ? LWCELL_CMD_CGDCONT : LWCELL_CMD_PPP_DIAL;
+    LWCELL_MSG_VAR_REF(msg).msg.ppp_start.apn = apn;
+    LWCELL_MSG_VAR_REF(msg).msg.ppp_start.input_fn = input_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.ppp_start.input_arg = input_arg;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Stop PPP session and return device to command mode
+ *
+ * Host PPP implementation should terminate link before, so that peer is notified
+ *
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_stop(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PPP_STOP;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_PPP_HANGUP;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Send data of host PPP implementation to device
+ *
+ * Data are dropped while device is in command mode, PPP retransmits them
+ *
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes sent
+ */
+size_t
+lwcell_ppp_output(const void* data, size_t len) {
+    size_t res = 0;
+
+    LWCELL_ASSERT0(data != NULL);
+
+    lwcell_core_lock();
+    if (ppp.online) {
+        res = lwcelli_ppp_send(ppp.ch, data, len);
+        ppp_stats.bytes_tx += LWCELL_U32(res);
+    } else {
+        ppp_stats.dropped_tx += LWCELL_U32(len);
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Check if device is in data mode
+ * \return          `1` if data mode is active, `0` otherwise
+ */
+uint8_t
+lwcell_ppp_is_online(void) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = ppp.online;
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get PPP statistics
+ * \param[out]      stats: Structure to copy statistics to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_get_stats(lwcell_ppp_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    *stats = ppp_stats;
+    stats->is_online = ppp.online;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_PPP || __DOXYGEN__ */
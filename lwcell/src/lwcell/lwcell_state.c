@@ -0,0 +1,160 @@
+/**
+ * \file            lwcell_state.c
+ * \brief           Modem state snapshot
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_state.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_STATE_SNAPSHOT || __DOXYGEN__
+
+/* Use C11 atomics for lock-free sequence lock when available, otherwise fall back to core lock */
+#if !defined(__STDC_NO_ATOMICS__) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#include <stdatomic.h>
+#define STATE_USE_ATOMICS 1
+typedef _Atomic uint32_t state_seq_t;
+#define STATE_LOAD(v, order)     atomic_load_explicit(&(v), (order))
+#define STATE_STORE(v, x, order) atomic_store_explicit(&(v), (x), (order))
+#define STATE_FENCE(order)       atomic_thread_fence(order)
+#else /* !defined(__STDC_NO_ATOMICS__) ... */
+#define STATE_USE_ATOMICS 0
+typedef volatile uint32_t state_seq_t;
+#define STATE_LOAD(v, order)     (v)
+#define STATE_STORE(v, x, order) (v) = (x)
+#define STATE_FENCE(order)
+#endif /* !defined(__STDC_NO_ATOMICS__) ... */
+
+/*
+ * Number of lock-free read attempts before reader takes core lock.
+ * Writer publishes with core locked, hence reader cannot spin forever
+ * when it preempted writer in the middle of an update
+ */
+#define STATE_READ_RETRIES 4
+
+static state_seq_t state_seq;   /*!< Sequence number, odd while snapshot is being written */
+static lwcell_state_t state;    /*!< Published snapshot */
+static uint8_t state_dirty = 1; /*!< Set when parser modified state included in snapshot */
+
+/**
+ * \brief           Collect current state
+ * \param[out]      st: Output state, `changes` field is not set
+ */
+static void
+prv_state_collect(lwcell_state_t* st) {
+    LWCELL_MEMSET(st, 0x00, sizeof(*st)); /* Clear padding too, snapshots are compared as memory */
+    st->dev_present = lwcell.status.f.dev_present;
+    st->model = lwcell.m.model;
+    st->sim_state = lwcell.m.sim.state;
+    st->reg_status = lwcell.m.network.status;
+    st->rssi = lwcell.m.rssi;
+    st->operator_current = lwcell.m.network.curr_operator;
+    st->is_attached = lwcell.m.network.is_attached;
+    st->ip = lwcell.m.network.ip_addr;
+#if LWCELL_CFG_CONN
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        st->conns[i].active = lwcell.m.conns[i].status.f.active;
+        st->conns[i].client = lwcell.m.conns[i].status.f.client;
+        st->conns[i].in_closing = lwcell.m.conns[i].status.f.in_closing;
+    }
+#endif /* LWCELL_CFG_CONN */
+}
+
+/**
+ * \brief           Mark state included in snapshot as modified
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_state_changed(void) {
+    state_dirty = 1;
+}
+
+/**
+ * \brief           Publish new snapshot if state changed
+ * \note            Function is called from \ref lwcell_core_unlock, before core is released.
+ *                  State is only collected when marked with \ref lwcelli_state_changed
+ */
+void
+lwcelli_state_publish(void) {
+    lwcell_state_t cur;
+    uint32_t seq;
+
+    if (!state_dirty) {
+        return;
+    }
+    state_dirty = 0;
+    prv_state_collect(&cur);
+    cur.changes = state.changes;
+    if (!memcmp(&cur, &state, sizeof(cur))) {
+        return;
+    }
+    ++cur.changes;
+
+    seq = STATE_LOAD(state_seq, memory_order_relaxed);
+    STATE_STORE(state_seq, seq + 1, memory_order_relaxed);
+    STATE_FENCE(memory_order_release);
+    LWCELL_MEMCPY(&state, &cur, sizeof(state));
+    STATE_STORE(state_seq, seq + 2, memory_order_release);
+}
+
+/**
+ * \brief           Get consistent snapshot of modem state
+ *
+ * Function does not lock the core when C11 atomics are available,
+ * unless snapshot is being updated during all read attempts
+ *
+ * \param[out]      st: Structure to copy state to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_state_get(lwcell_state_t* st) {
+    LWCELL_ASSERT(st != NULL);
+
+#if STATE_USE_ATOMICS
+    for (size_t i = 0; i < STATE_READ_RETRIES; ++i) {
+        uint32_t seq = STATE_LOAD(state_seq, memory_order_acquire);
+        if (seq & 0x01) {
+            continue; /* Writer is active */
+        }
+        LWCELL_MEMCPY(st, &state, sizeof(*st));
+        STATE_FENCE(memory_order_acquire);
+        if (STATE_LOAD(state_seq, memory_order_relaxed) == seq) {
+            return lwcellOK;
+        }
+    }
+#endif /* STATE_USE_ATOMICS */
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(st, &state, sizeof(*st));
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_STATE_SNAPSHOT || __DOXYGEN__ */
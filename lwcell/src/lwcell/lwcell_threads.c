@@ -38,6 +38,52 @@
 #include "lwcell/lwcell_timeout.h"
 #include "system/lwcell_sys.h"
 
+#if !LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__
+
+/**
+ * \brief           Execute message taken from producer queue and wait for its completion
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to execute
+ * \param[in]       sync: Semaphore released by processing thread when command finishes
+ */
+static void
+prv_msg_execute(lwcell_msg_t* msg, lwcell_sys_sem_t* sync) {
+    lwcellr_t res;
+    uint32_t time, time_start;
+
+    time_start = lwcell_sys_now();
+
+    /* For reset message, we can have delay! */
+    if (lwcell.status.f.dev_present && msg->cmd_def == LWCELL_CMD_RESET && msg->msg.reset.delay > 0) {
+        lwcell_delay(msg->msg.reset.delay);
+    }
+
+    /*
+     * Synchronization semaphore is always locked when no command is active.
+     * It is released once by processing thread when command finishes,
+     * so single wait is enough to synchronize with command completion
+     */
+    res = lwcelli_msg_start(msg); /* Process this message, check if command started at least */
+    if (res == lwcellOK) {        /* We have valid data and data were sent */
+        lwcell_core_unlock();
+        time = lwcell_sys_sem_wait(sync, msg->block_time); /* Wait for command to finish or timeout */
+        lwcell_core_lock();
+        if (time == LWCELL_SYS_TIMEOUT) {
+            if (msg->is_done) {
+                /*
+                 * Command finished after wait timed-out, but before core lock was acquired again.
+                 * Semaphore has been released, consume it to keep it locked for next command
+                 */
+                lwcell_sys_sem_wait(sync, 0);
+            } else {
+                msg->is_done = 1;    /* Prevent late release from processing thread */
+                res = lwcellTIMEOUT; /* Timeout on command */
+            }
+        }
+    }
+    lwcelli_msg_finish(msg, res, time_start);
+}
+
 /**
  * \brief           User thread to process input packets from API functions
  * \param[in]       arg: User argument. Semaphore to release when thread starts
@@ -47,7 +93,6 @@ lwcell_thread_produce(void* const arg) {
     lwcell_sys_sem_t* sem = arg;
     lwcell_t* e = &lwcell;
     lwcell_msg_t* msg;
-    lwcellr_t res;
     uint32_t time;
 
     /* Thread is running, unlock semaphore */
@@ -58,120 +103,80 @@ lwcell_thread_produce(void* const arg) {
     lwcell_core_lock();
     while (1) {
         lwcell_core_unlock();
-        do {
-            time = lwcell_sys_mbox_get(&e->mbox_producer, (void**)&msg, 0); /* Get message from queue */
-        } while (time == LWCELL_SYS_TIMEOUT || msg == NULL);
-        LWCELL_THREAD_PRODUCER_HOOK();                                      /* Execute producer thread hook */
+        msg = NULL;
+#if LWCELL_CFG_CMD_PRIO
+        /* Block for new message only when there is no command waiting in priority queues */
+        if (lwcelli_cmd_prio_is_empty())
+#endif /* LWCELL_CFG_CMD_PRIO */
+        {
+            do {
+                time = lwcell_sys_mbox_get(&e->mbox_producer, (void**)&msg, 0); /* Get message from queue */
+            } while (time == LWCELL_SYS_TIMEOUT || msg == NULL);
+            LWCELL_THREAD_PRODUCER_HOOK();                                      /* Execute producer thread hook */
+            LWCELL_METRICS_MBOX_GET(PRODUCER);
+            LWCELL_TRACE(MBOX_PRODUCER_GET, msg->cmd_def, time, 0, 0);
+        }
         lwcell_core_lock();
-
-        res = lwcellOK; /* Start with OK */
-        e->msg = msg;   /* Set message handle */
-
-        /*
-         * This check is performed when adding command to queue
-         * Do it again here to prevent long timeouts,
-         * if device present flag changes
-         */
-        if (!e->status.f.dev_present) {
-            res = lwcellERRNODEVICE;
+#if LWCELL_CFG_CMD_PRIO
+        /* Sort queued messages to priority classes, up to producer queue size, and take the one to execute */
+        if (msg != NULL) {
+            lwcelli_cmd_prio_put(msg);
         }
-
-        /* For reset message, we can have delay! */
-        if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_RESET) {
-            if (msg->msg.reset.delay > 0) {
-                lwcell_delay(msg->msg.reset.delay);
+        while (!lwcelli_cmd_prio_is_full() && lwcell_sys_mbox_getnow(&e->mbox_producer, (void**)&msg)) {
+            if (msg != NULL) {
+                LWCELL_METRICS_MBOX_GET(PRODUCER);
+                LWCELL_TRACE(MBOX_PRODUCER_GET, msg->cmd_def, 0, 0, 0);
+                lwcelli_cmd_prio_put(msg);
             }
-            lwcelli_reset_everything(1); /* Reset stack before trying to reset */
         }
+        msg = lwcelli_cmd_prio_get();
+#endif /* LWCELL_CFG_CMD_PRIO */
 
-        /*
-         * Try to call function to process this message
-         * Usually it should be function to transmit data to AT port
-         */
-        if (res == lwcellOK && msg->fn != NULL) { /* Check for callback processing function */
-            /*
-             * Obtain semaphore
-             * This code should not block at any point.
-             * If it blocks, severe problems occurred and program should
-             * immediate terminate
-             */
-            lwcell_core_unlock();
-            lwcell_sys_sem_wait(&e->sem_sync, 0); /* First call */
-            lwcell_core_lock();
-            res = msg->fn(msg);                   /* Process this message, check if command started at least */
-            time = ~LWCELL_SYS_TIMEOUT;           /* Reset time */
-            if (res == lwcellOK) {                /* We have valid data and data were sent */
-                lwcell_core_unlock();
-                time = lwcell_sys_sem_wait(
-                    &e->sem_sync,
-                    msg->block_time); /* Second call; Wait for synchronization semaphore from processing thread or timeout */
-                lwcell_core_lock();
-                if (time == LWCELL_SYS_TIMEOUT) { /* Sync timeout occurred? */
-                    res = lwcellTIMEOUT;          /* Timeout on command */
-                }
-            }
-
-            /* Notify application on command timeout */
-            if (res == lwcellTIMEOUT) {
-                lwcelli_send_cb(LWCELL_EVT_CMD_TIMEOUT);
-            }
+        prv_msg_execute(msg, &e->sem_sync);
+    }
+}
 
-            LWCELL_DEBUGW(
-                LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE, res == lwcellTIMEOUT,
-                "[LWCELL THREAD] Timeout in produce thread waiting for command to finish in process thread\r\n");
-            LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE,
-                          res != lwcellOK && res != lwcellTIMEOUT,
-                          "[LWCELL THREAD] Could not start execution for command %d\r\n", (int)msg->cmd);
-
-            /*
-             * Manually release semaphore in all cases:
-             *
-             * Case 1: msg->fn function fails, command did not start,
-             *           application needs to release previously acquired semaphore
-             * Case 2: If time == TIMEOUT, acquiring on second call was not successful,
-             *           application has to manually release semaphore, taken on first call
-             * Case 3: If time != TIMEOUT, acquiring on second call was successful,
-             *           which effectively means that another thread successfully released semaphore,
-             *           application has to release semaphore, now taken on second call
-             *
-             * If application would not manually release semaphore,
-             * and if command would return with timeout (or fail),
-             * it would not be possible to start a new command after,
-             * because semaphore would be still locked
-             */
-            lwcell_sys_sem_release(&e->sem_sync);
-        } else {
-            if (res == lwcellOK) {
-                res = lwcellERR; /* Simply set error message */
-            }
-        }
-        if (res != lwcellOK) {
-            /* Process global callbacks */
-            lwcelli_process_events_for_timeout_or_error(msg, res);
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+/**
+ * \brief           User thread to execute commands on multiplexer data channel
+ * \param[in]       arg: User argument. Semaphore to release when thread starts
+ * \sa              LWCELL_CFG_CMUX
+ */
+void
+lwcell_thread_produce_data(void* const arg) {
+    lwcell_sys_sem_t* sem = arg;
+    lwcell_t* e = &lwcell;
+    lwcell_msg_t* msg;
+    uint32_t time;
 
-            msg->res = res; /* Save response */
-        }
+    /* Thread is running, unlock semaphore */
+    if (lwcell_sys_sem_isvalid(sem)) {
+        lwcell_sys_sem_release(sem); /* Release semaphore */
+    }
 
-#if LWCELL_CFG_USE_API_FUNC_EVT
-        /* Send event function to user */
-        if (msg->evt_fn != NULL) {
-            msg->evt_fn(msg->res, msg->evt_arg); /* Send event with user argument */
-        }
-#endif                                           /* LWCELL_CFG_USE_API_FUNC_EVT */
+    lwcell_core_lock();
+    while (1) {
+        lwcell_core_unlock();
+        msg = NULL;
+        do {
+            time = lwcell_sys_mbox_get(&e->mbox_data, (void**)&msg, 0); /* Get message from queue */
+        } while (time == LWCELL_SYS_TIMEOUT || msg == NULL);
+        LWCELL_THREAD_PRODUCER_HOOK(); /* Execute producer thread hook */
+        lwcell_core_lock();
 
-        /*
-         * In case message is blocking,
-         * release semaphore and notify finished with processing
-         * otherwise directly free memory of message structure
-         */
-        if (msg->is_blocking) {
-            lwcell_sys_sem_release(&msg->sem);
-        } else {
-            LWCELL_MSG_VAR_FREE(msg);
+        /* Multiplexer has been closed since message was queued, execute it on control channel instead */
+        if (!lwcelli_cmux_is_active()) {
+            msg->cmux_ch = LWCELL_CMUX_CH_CTRL;
+            if (!lwcell_sys_mbox_putnow(&e->mbox_producer, msg)) {
+                msg->cmux_ch = LWCELL_CMUX_CH_DATA;
+                lwcelli_msg_finish(msg, lwcellERRMEM, lwcell_sys_now());
+            }
+            continue;
         }
-        e->msg = NULL;
+        prv_msg_execute(msg, &e->sem_sync_data);
     }
 }
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
 
 /**
  * \brief           Thread for processing received data from device
@@ -220,3 +225,44 @@ lwcell_thread_process(void* const arg) {
 #endif                            /* !LWCELL_CFG_INPUT_USE_PROCESS */
     }
 }
+
+#endif /* !LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__ */
+
+#if (LWCELL_CFG_SINGLE_THREAD && LWCELL_CFG_LOOP_THREAD) || __DOXYGEN__
+
+/**
+ * \brief           Thread running single-thread event loop
+ *
+ *                  Thread waits for wake-up message in process queue
+ *                  or until next timeout expires and runs the loop
+ *
+ * \param[in]       arg: User argument. Semaphore to release when thread starts
+ * \sa              LWCELL_CFG_SINGLE_THREAD
+ */
+void
+lwcell_thread_loop(void* const arg) {
+    lwcell_sys_sem_t* sem = arg;
+    lwcell_t* e = &lwcell;
+    void* msg;
+    uint32_t time;
+
+    /* Thread is running, unlock semaphore */
+    if (lwcell_sys_sem_isvalid(sem)) {
+        lwcell_sys_sem_release(sem); /* Release semaphore */
+    }
+
+    while (1) {
+        lwcell_loop_process();
+        time = lwcell_loop_get_next_timeout();
+        if (time > 0 && lwcell_sys_mbox_get(&e->mbox_process, &msg, time == LWCELL_LOOP_NO_TIMEOUT ? 0 : time)
+                            != LWCELL_SYS_TIMEOUT) {
+            /* Single loop run serves all pending wake-ups */
+            do {
+                LWCELL_METRICS_MBOX_GET(PROCESS);
+            } while (lwcell_sys_mbox_getnow(&e->mbox_process, &msg));
+        }
+        LWCELL_THREAD_PROCESS_HOOK(); /* Execute process thread hook */
+    }
+}
+
+#endif /* (LWCELL_CFG_SINGLE_THREAD && LWCELL_CFG_LOOP_THREAD) || __DOXYGEN__ */
@@ -79,11 +79,32 @@ process_next_timeout(void) {
          * adds a new timeout entry to list
          */
         first_timeout = first_timeout->next; /* Set next timeout on a list as first timeout */
+        LWCELL_TRACE(TIMEOUT_EXPIRE, LWCELL_TRACE_PTR(to->fn), 0, 0, 0);
         to->fn(to->arg);                     /* Call user callback function */
         lwcell_mem_free_s((void**)&to);
     }
 }
 
+#if LWCELL_CFG_OS || __DOXYGEN__
+
+/**
+ * \brief           Get entry from message queue and account it in metrics
+ * \param[in]       b: Pointer to message queue to get element
+ * \param[out]      m: Pointer to pointer to output variable
+ * \param[in]       timeout: Maximal time to wait for message (0 = wait until message received)
+ * \return          Time in milliseconds waited for message or \ref LWCELL_SYS_TIMEOUT
+ */
+static uint32_t
+mbox_get(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
+    uint32_t time = lwcell_sys_mbox_get(b, m, timeout);
+#if LWCELL_CFG_METRICS
+    if (time != LWCELL_SYS_TIMEOUT && b == &lwcell.mbox_process) {
+        LWCELL_METRICS_MBOX_GET(PROCESS);
+    }
+#endif /* LWCELL_CFG_METRICS */
+    return time;
+}
+
 /**
  * \brief           Get next entry from message queue
  * \param[in]       b: Pointer to message queue to get element
@@ -96,10 +117,10 @@ lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32
     uint32_t wait_time;
     do {
         if (first_timeout == NULL) {                   /* We have no timeouts ready? */
-            return lwcell_sys_mbox_get(b, m, timeout); /* Get entry from message queue */
+            return mbox_get(b, m, timeout); /* Get entry from message queue */
         }
         wait_time = get_next_timeout_diff();           /* Get time to wait for next timeout execution */
-        if (wait_time == 0 || lwcell_sys_mbox_get(b, m, wait_time) == LWCELL_SYS_TIMEOUT) {
+        if (wait_time == 0 || mbox_get(b, m, wait_time) == LWCELL_SYS_TIMEOUT) {
             lwcell_core_lock();
             process_next_timeout(); /* Process with next timeout */
             lwcell_core_unlock();
@@ -109,6 +130,33 @@ lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32
     return wait_time;
 }
 
+#endif /* LWCELL_CFG_OS || __DOXYGEN__ */
+
+#if LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__
+
+/**
+ * \brief           Get time until next timeout expires
+ * \note            Function must be called with core locked
+ * \return          Time in units of milliseconds or \ref LWCELL_LOOP_NO_TIMEOUT if there is no timeout
+ */
+uint32_t
+lwcelli_timeout_get_next(void) {
+    return get_next_timeout_diff();
+}
+
+/**
+ * \brief           Process all expired timeouts
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_timeout_process_expired(void) {
+    while (first_timeout != NULL && get_next_timeout_diff() == 0) {
+        process_next_timeout();
+    }
+}
+
+#endif /* LWCELL_CFG_SINGLE_THREAD || __DOXYGEN__ */
+
 /**
  * \brief           Add new timeout to processing list
  * \param[in]       time: Time in units of milliseconds for timeout execution
@@ -127,6 +175,7 @@ lwcell_timeout_add(uint32_t time, lwcell_timeout_fn fn, void* arg) {
     if ((to = lwcell_mem_calloc(1, sizeof(*to))) == NULL) {
         return lwcellERRMEM;
     }
+    LWCELL_TRACE(TIMEOUT_ADD, LWCELL_TRACE_PTR(fn), time, 0, 0);
 
     lwcell_core_lock();
     now = lwcell_sys_now(); /* Get current time */
@@ -181,7 +230,7 @@ lwcell_timeout_add(uint32_t time, lwcell_timeout_fn fn, void* arg) {
         }
     }
     lwcell_core_unlock();
-    lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL); /* Insert dummy value to wakeup process thread */
+    lwcelli_process_wakeup(); /* Wakeup process thread to recalculate its wait time */
     return lwcellOK;
 }
 
@@ -225,5 +274,6 @@ lwcell_timeout_remove(lwcell_timeout_fn fn) {
         }
     }
     lwcell_core_unlock();
+    LWCELL_TRACE(TIMEOUT_REMOVE, LWCELL_TRACE_PTR(fn), success, 0, 0);
     return success ? lwcellOK : lwcellERR;
 }
@@ -0,0 +1,303 @@
+/**
+ * \file            lwcell_trace.c
+ * \brief           Binary trace ring
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_trace.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_TRACE || __DOXYGEN__
+
+/* Use C11 atomics for lock-free slot reservation when available, otherwise fall back to system protection */
+#if !defined(__STDC_NO_ATOMICS__) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#include <stdatomic.h>
+#define TRACE_USE_ATOMICS 1
+typedef _Atomic uint32_t trace_idx_t;
+#define TRACE_LOAD(v, order)     atomic_load_explicit(&(v), (order))
+#define TRACE_STORE(v, x, order) atomic_store_explicit(&(v), (x), (order))
+#define TRACE_FENCE(order)       atomic_thread_fence(order)
+#else /* !defined(__STDC_NO_ATOMICS__) ... */
+#define TRACE_USE_ATOMICS 0
+typedef volatile uint32_t trace_idx_t;
+#define TRACE_LOAD(v, order)     (v)
+#define TRACE_STORE(v, x, order) (v) = (x)
+#define TRACE_FENCE(order)
+#endif /* !defined(__STDC_NO_ATOMICS__) ... */
+
+#define TRACE_RING_MASK (LWCELL_CFG_TRACE_RING_SIZE - 1)
+
+/**
+ * \brief           Single slot in trace ring
+ */
+typedef struct {
+    trace_idx_t seq;        /*!< Record index plus `1` when slot is valid, `0` while it is being written */
+    lwcell_trace_rec_t rec; /*!< Record data */
+} trace_slot_t;
+
+static trace_slot_t trace_ring[LWCELL_CFG_TRACE_RING_SIZE]; /*!< Trace ring */
+static trace_idx_t trace_widx;                              /*!< Index of next record to write */
+static trace_idx_t trace_ridx;                              /*!< Index of first record to read */
+
+/**
+ * \brief           Name and format for each event, used by decoder
+ */
+static const struct {
+    const char* name; /*!< Event name */
+    const char* fmt;  /*!< Arguments format */
+} trace_evts[] = {
+#define LWCELL_TRACE_EVT_ENTRY(name, fmt) {#name, fmt},
+#include "lwcell/lwcell_trace_evts.h"
+#undef LWCELL_TRACE_EVT_ENTRY
+};
+
+/**
+ * \brief           Write record to trace ring
+ *
+ * Function does not lock the core and may be called from any context
+ *
+ * \param[in]       id: Event ID, member of \ref lwcell_trace_evt_t enumeration
+ * \param[in]       a0: First argument
+ * \param[in]       a1: Second argument
+ * \param[in]       a2: Third argument
+ * \param[in]       a3: Fourth argument
+ */
+void
+lwcelli_trace(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    trace_slot_t* slot;
+    uint32_t idx;
+
+#if TRACE_USE_ATOMICS
+    idx = atomic_fetch_add_explicit(&trace_widx, 1, memory_order_relaxed);
+#else  /* TRACE_USE_ATOMICS */
+    lwcell_sys_protect();
+    idx = trace_widx++;
+#endif /* !TRACE_USE_ATOMICS */
+    slot = &trace_ring[idx & TRACE_RING_MASK];
+
+    /* Invalidate slot before writing, so that reader can detect concurrent update */
+    TRACE_STORE(slot->seq, 0, memory_order_relaxed);
+    TRACE_FENCE(memory_order_release);
+    slot->rec.time = lwcell_sys_now();
+    slot->rec.id = id;
+    slot->rec.args[0] = a0;
+    slot->rec.args[1] = a1;
+    slot->rec.args[2] = a2;
+    slot->rec.args[3] = a3;
+    TRACE_STORE(slot->seq, idx + 1, memory_order_release);
+#if !TRACE_USE_ATOMICS
+    lwcell_sys_unprotect();
+#endif /* !TRACE_USE_ATOMICS */
+}
+
+/**
+ * \brief           Copy record from ring slot
+ * \param[in]       idx: Record index
+ * \param[out]      rec: Output record
+ * \return          `1` if record is valid, `0` if it was overwritten or is being written
+ */
+static uint8_t
+prv_read_slot(uint32_t idx, lwcell_trace_rec_t* rec) {
+    trace_slot_t* slot = &trace_ring[idx & TRACE_RING_MASK];
+    uint32_t seq;
+
+    seq = TRACE_LOAD(slot->seq, memory_order_acquire);
+    if (seq != idx + 1) {
+        return 0;
+    }
+    *rec = slot->rec;
+    TRACE_FENCE(memory_order_acquire);
+    return TRACE_LOAD(slot->seq, memory_order_relaxed) == seq;
+}
+
+/**
+ * \brief           Get index range of records available in ring
+ * \param[out]      start: Index of first available record
+ * \return          Index of record after last available
+ */
+static uint32_t
+prv_get_range(uint32_t* start) {
+    uint32_t w, r;
+
+    w = TRACE_LOAD(trace_widx, memory_order_relaxed);
+    r = TRACE_LOAD(trace_ridx, memory_order_relaxed);
+    if ((uint32_t)(w - r) > LWCELL_CFG_TRACE_RING_SIZE) {
+        r = w - LWCELL_CFG_TRACE_RING_SIZE;
+    }
+    *start = r;
+    return w;
+}
+
+/**
+ * \brief           Read records from trace ring, oldest first
+ *
+ * Records are not removed from ring. When more records are available than requested,
+ * newest records are returned.
+ *
+ * \param[out]      recs: Array of records to fill
+ * \param[in]       max_recs: Maximal number of records to read
+ * \return          Number of records written to array
+ */
+size_t
+lwcell_trace_read(lwcell_trace_rec_t* recs, size_t max_recs) {
+    uint32_t start, end;
+    size_t cnt = 0;
+
+    LWCELL_ASSERT0(recs != NULL);
+
+    end = prv_get_range(&start);
+    if ((size_t)(uint32_t)(end - start) > max_recs) {
+        start = end - (uint32_t)max_recs;
+    }
+    for (; start != end; ++start) {
+        if (prv_read_slot(start, &recs[cnt])) {
+            ++cnt;
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Dump trace ring to user output in binary format
+ *
+ * Output can be decoded with \ref lwcell_trace_check_header and \ref lwcell_trace_parse_record
+ *
+ * \param[in]       write_fn: Output function
+ * \param[in]       arg: User argument passed to output function
+ * \return          Number of records written
+ */
+size_t
+lwcell_trace_dump(lwcell_trace_write_fn write_fn, void* arg) {
+    uint8_t hdr[LWCELL_TRACE_HDR_LEN] = {'L', 'W', 'C', 'T', LWCELL_TRACE_VERSION, 0, 0, 0};
+    uint8_t buff[LWCELL_TRACE_REC_LEN];
+    lwcell_trace_rec_t rec;
+    uint32_t start, end;
+    size_t cnt = 0;
+
+    LWCELL_ASSERT0(write_fn != NULL);
+
+    write_fn(hdr, sizeof(hdr), arg);
+    for (end = prv_get_range(&start); start != end; ++start) {
+        if (!prv_read_slot(start, &rec)) {
+            continue;
+        }
+        buff[0] = LWCELL_U8(rec.time);
+        buff[1] = LWCELL_U8(rec.time >> 8);
+        buff[2] = LWCELL_U8(rec.time >> 16);
+        buff[3] = LWCELL_U8(rec.time >> 24);
+        buff[4] = LWCELL_U8(rec.id);
+        buff[5] = LWCELL_U8(rec.id >> 8);
+        buff[6] = 0;
+        buff[7] = 0;
+        for (size_t i = 0; i < LWCELL_TRACE_ARGS_NUM; ++i) {
+            buff[8 + 4 * i] = LWCELL_U8(rec.args[i]);
+            buff[9 + 4 * i] = LWCELL_U8(rec.args[i] >> 8);
+            buff[10 + 4 * i] = LWCELL_U8(rec.args[i] >> 16);
+            buff[11 + 4 * i] = LWCELL_U8(rec.args[i] >> 24);
+        }
+        write_fn(buff, sizeof(buff), arg);
+        ++cnt;
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Discard all records currently in trace ring
+ */
+void
+lwcell_trace_reset(void) {
+    TRACE_STORE(trace_ridx, TRACE_LOAD(trace_widx, memory_order_relaxed), memory_order_relaxed);
+}
+
+/**
+ * \brief           Get event name
+ * \param[in]       id: Event ID, member of \ref lwcell_trace_evt_t enumeration
+ * \return          Event name or `NULL` for unknown event
+ */
+const char*
+lwcell_trace_evt_name(uint16_t id) {
+    return id < LWCELL_ARRAYSIZE(trace_evts) ? trace_evts[id].name : NULL;
+}
+
+/**
+ * \brief           Get event arguments format string
+ *
+ * Each format specifier consumes one `32-bit` unsigned argument
+ *
+ * \param[in]       id: Event ID, member of \ref lwcell_trace_evt_t enumeration
+ * \return          Format string or `NULL` for unknown event
+ */
+const char*
+lwcell_trace_evt_fmt(uint16_t id) {
+    return id < LWCELL_ARRAYSIZE(trace_evts) ? trace_evts[id].fmt : NULL;
+}
+
+/**
+ * \brief           Check if data start with valid trace dump header
+ * \param[in]       data: Pointer to dump data
+ * \param[in]       len: Length of data in units of bytes
+ * \return          `1` if header is valid, `0` otherwise
+ */
+uint8_t
+lwcell_trace_check_header(const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    return len >= LWCELL_TRACE_HDR_LEN && d[0] == 'L' && d[1] == 'W' && d[2] == 'C' && d[3] == 'T'
+           && d[4] == LWCELL_TRACE_VERSION;
+}
+
+/**
+ * \brief           Parse single record from trace dump
+ * \param[in]       data: Pointer to dump data, starting at record
+ * \param[in]       len: Length of available data in units of bytes
+ * \param[out]      rec: Output record
+ * \return          Number of bytes consumed by record or `0` if data do not contain full record
+ */
+size_t
+lwcell_trace_parse_record(const void* data, size_t len, lwcell_trace_rec_t* rec) {
+    const uint8_t* d = data;
+
+    LWCELL_ASSERT0(data != NULL);
+    LWCELL_ASSERT0(rec != NULL);
+
+    if (len < LWCELL_TRACE_REC_LEN) {
+        return 0;
+    }
+    rec->time = (uint32_t)d[0] | ((uint32_t)d[1] << 8) | ((uint32_t)d[2] << 16) | ((uint32_t)d[3] << 24);
+    rec->id = LWCELL_U16(d[4] | (d[5] << 8));
+    for (size_t i = 0; i < LWCELL_TRACE_ARGS_NUM; ++i) {
+        d += 4;
+        rec->args[i] =
+            (uint32_t)d[4] | ((uint32_t)d[5] << 8) | ((uint32_t)d[6] << 16) | ((uint32_t)d[7] << 24);
+    }
+    return LWCELL_TRACE_REC_LEN;
+}
+
+#endif /* LWCELL_CFG_TRACE || __DOXYGEN__ */
@@ -42,7 +42,12 @@
  * More about UART + RX DMA: https://github.com/MaJerle/stm32-usart-dma-rx-tx
  *
  * \ref LWCELL_CFG_INPUT_USE_PROCESS must be enabled in `lwcell_config.h` to use this driver.
+ *
+ * With \ref LWCELL_CFG_FLOW_CONTROL enabled and `LWCELL_USART_RTS_PIN` and `LWCELL_USART_CTS_PIN` defined,
+ * transmit is paused by CTS line in hardware and RTS line pauses device
+ * while thread processes backlog above high-water mark of DMA memory.
  */
+#include "lwcell/lwcell_flow.h"
 #include "lwcell/lwcell_input.h"
 #include "lwcell/lwcell_mem.h"
 #include "lwcell/lwcell_types.h"
@@ -68,6 +73,13 @@
 #define LWCELL_USART_RDR_NAME RDR
 #endif /* !defined(LWCELL_USART_RDR_NAME) */
 
+/* Flow control requires both lines */
+#if LWCELL_CFG_FLOW_CONTROL && defined(LWCELL_USART_RTS_PIN) && defined(LWCELL_USART_CTS_PIN)
+#define LWCELL_USART_FLOW_CONTROL 1
+#else
+#define LWCELL_USART_FLOW_CONTROL 0
+#endif /* LWCELL_CFG_FLOW_CONTROL && defined(LWCELL_USART_RTS_PIN) && defined(LWCELL_USART_CTS_PIN) */
+
 /* USART memory */
 static uint8_t usart_mem[LWCELL_USART_DMA_RX_BUFF_SIZE];
 static uint8_t is_running, initialized;
@@ -80,6 +92,21 @@ static osThreadId_t usart_ll_thread_id;
 /* Message queue */
 static osMessageQueueId_t usart_ll_mbox_id;
 
+#if LWCELL_USART_FLOW_CONTROL
+/**
+ * \brief           Set RTS line, active low
+ * \param[in]       ready: Set to `1` when device may send data, or `0` to pause it
+ */
+static void
+set_rts(uint8_t ready) {
+    if (ready) {
+        LL_GPIO_ResetOutputPin(LWCELL_USART_RTS_PORT, LWCELL_USART_RTS_PIN);
+    } else {
+        LL_GPIO_SetOutputPin(LWCELL_USART_RTS_PORT, LWCELL_USART_RTS_PIN);
+    }
+}
+#endif /* LWCELL_USART_FLOW_CONTROL */
+
 /**
  * \brief           USART data processing
  */
@@ -101,6 +128,15 @@ usart_ll_thread(void* arg) {
         pos = sizeof(usart_mem) - LL_DMA_GetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_RX_CH);
 #endif /* defined(LWCELL_USART_DMA_RX_STREAM) */
         if (pos != old_pos && is_running) {
+#if LWCELL_USART_FLOW_CONTROL
+            /* Pause device while backlog is processed, DMA would otherwise overwrite unprocessed data */
+            size_t pending = pos > old_pos ? (pos - old_pos) : (sizeof(usart_mem) - old_pos + pos);
+            uint8_t pause = pending >= sizeof(usart_mem) * LWCELL_CFG_FLOW_CONTROL_HIGH_WATER / 100;
+
+            if (pause) {
+                set_rts(0);
+            }
+#endif /* LWCELL_USART_FLOW_CONTROL */
             if (pos > old_pos) {
                 lwcell_input_process(&usart_mem[old_pos], pos - old_pos);
             } else {
@@ -113,6 +149,11 @@ usart_ll_thread(void* arg) {
             if (old_pos == sizeof(usart_mem)) {
                 old_pos = 0;
             }
+#if LWCELL_USART_FLOW_CONTROL
+            if (pause) {
+                set_rts(1);
+            }
+#endif /* LWCELL_USART_FLOW_CONTROL */
         }
     }
 }
@@ -136,6 +177,10 @@ configure_uart(uint32_t baudrate) {
 #if defined(LWCELL_RESET_PIN)
         LWCELL_RESET_PORT_CLK;
 #endif /* defined(LWCELL_RESET_PIN) */
+#if LWCELL_USART_FLOW_CONTROL
+        LWCELL_USART_RTS_PORT_CLK;
+        LWCELL_USART_CTS_PORT_CLK;
+#endif /* LWCELL_USART_FLOW_CONTROL */
 
         /* Global pin configuration */
         LL_GPIO_StructInit(&gpio_init);
@@ -150,6 +195,13 @@ configure_uart(uint32_t baudrate) {
         LL_GPIO_Init(LWCELL_RESET_PORT, &gpio_init);
 #endif /* defined(LWCELL_RESET_PIN) */
 
+#if LWCELL_USART_FLOW_CONTROL
+        /* Configure RTS pin, driven by software according to DMA memory level */
+        gpio_init.Pin = LWCELL_USART_RTS_PIN;
+        LL_GPIO_Init(LWCELL_USART_RTS_PORT, &gpio_init);
+        set_rts(1);
+#endif /* LWCELL_USART_FLOW_CONTROL */
+
         /* Configure USART pins */
         gpio_init.Mode = LL_GPIO_MODE_ALTERNATE;
 
@@ -163,12 +215,23 @@ configure_uart(uint32_t baudrate) {
         gpio_init.Pin = LWCELL_USART_RX_PIN;
         LL_GPIO_Init(LWCELL_USART_RX_PORT, &gpio_init);
 
+#if LWCELL_USART_FLOW_CONTROL
+        /* CTS PIN */
+        gpio_init.Alternate = LWCELL_USART_CTS_PIN_AF;
+        gpio_init.Pin = LWCELL_USART_CTS_PIN;
+        LL_GPIO_Init(LWCELL_USART_CTS_PORT, &gpio_init);
+#endif /* LWCELL_USART_FLOW_CONTROL */
+
         /* Configure UART */
         LL_USART_DeInit(LWCELL_USART);
         LL_USART_StructInit(&usart_init);
         usart_init.BaudRate = baudrate;
         usart_init.DataWidth = LL_USART_DATAWIDTH_8B;
+#if LWCELL_USART_FLOW_CONTROL
+        usart_init.HardwareFlowControl = LL_USART_HWCONTROL_CTS; /* Device pauses transmit */
+#else                                                            /* LWCELL_USART_FLOW_CONTROL */
         usart_init.HardwareFlowControl = LL_USART_HWCONTROL_NONE;
+#endif                                                           /* !LWCELL_USART_FLOW_CONTROL */
         usart_init.OverSampling = LL_USART_OVERSAMPLING_16;
         usart_init.Parity = LL_USART_PARITY_NONE;
         usart_init.StopBits = LL_USART_STOPBITS_1;
@@ -310,6 +373,10 @@ lwcell_ll_init(lwcell_ll_t* ll) {
 #if defined(LWCELL_RESET_PIN)
         ll->reset_fn = reset_device; /* Set callback for hardware reset */
 #endif                               /* defined(LWCELL_RESET_PIN) */
+#if LWCELL_USART_FLOW_CONTROL
+        ll->rts_fn = set_rts;
+        ll->uart.flow_control = 1; /* Device is configured for flow control in reset sequence */
+#endif                             /* LWCELL_USART_FLOW_CONTROL */
     }
 
     configure_uart(ll->uart.baudrate); /* Initialize UART for communication */
@@ -344,6 +411,21 @@ lwcell_ll_deinit(lwcell_ll_t* ll) {
  */
 void
 LWCELL_USART_IRQHANDLER(void) {
+#if LWCELL_CFG_FLOW_CONTROL
+    /* Account receive errors before flags are cleared */
+    if (LL_USART_IsActiveFlag_ORE(LWCELL_USART)) {
+        lwcell_flow_rx_error(LWCELL_FLOW_ERR_OVERRUN);
+    }
+    if (LL_USART_IsActiveFlag_FE(LWCELL_USART)) {
+        lwcell_flow_rx_error(LWCELL_FLOW_ERR_FRAMING);
+    }
+    if (LL_USART_IsActiveFlag_NE(LWCELL_USART)) {
+        lwcell_flow_rx_error(LWCELL_FLOW_ERR_NOISE);
+    }
+    if (LL_USART_IsActiveFlag_PE(LWCELL_USART)) {
+        lwcell_flow_rx_error(LWCELL_FLOW_ERR_PARITY);
+    }
+#endif /* LWCELL_CFG_FLOW_CONTROL */
     LL_USART_ClearFlag_IDLE(LWCELL_USART);
     LL_USART_ClearFlag_PE(LWCELL_USART);
     LL_USART_ClearFlag_FE(LWCELL_USART);
@@ -61,6 +61,11 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+uint8_t
+lwcell_sys_protect_try(void) {
+    return lwcell_sys_mutex_trylock(&sys_mutex);
+}
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     const osMutexAttr_t attr = {
@@ -80,6 +85,11 @@ lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
     return osMutexAcquire(*p, osWaitForever) == osOK;
 }
 
+uint8_t
+lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p) {
+    return osMutexAcquire(*p, 0) == osOK;
+}
+
 uint8_t
 lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
     return osMutexRelease(*p) == osOK;
@@ -67,6 +67,11 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+uint8_t
+lwcell_sys_protect_try(void) {
+    return lwcell_sys_mutex_trylock(&sys_mutex);
+}
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     *p = xSemaphoreCreateRecursiveMutex();
@@ -84,6 +89,11 @@ lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
     return xSemaphoreTakeRecursive(*p, portMAX_DELAY) == pdPASS;
 }
 
+uint8_t
+lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p) {
+    return xSemaphoreTakeRecursive(*p, 0) == pdPASS;
+}
+
 uint8_t
 lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
     return xSemaphoreGiveRecursive(*p) == pdPASS;
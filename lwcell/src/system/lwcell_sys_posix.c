@@ -0,0 +1,443 @@
+/**
+ * \file            lwcell_sys_posix.c
+ * \brief           System dependant functions for POSIX (pthread) based systems
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if !__DOXYGEN__
+
+/**
+ * \brief           Counting semaphore implementation for POSIX
+ *
+ * Count is limited to `1` to match binary semaphore behavior of other ports
+ */
+typedef struct {
+    pthread_mutex_t mutex; /*!< Mutex to protect count */
+    pthread_cond_t cond;   /*!< Condition variable signalled on release */
+    uint8_t cnt;           /*!< Current semaphore count */
+} posix_sem_t;
+
+/**
+ * \brief           Custom message queue implementation for POSIX
+ */
+typedef struct {
+    pthread_mutex_t mutex;         /*!< Mutex to lock access */
+    pthread_cond_t cond_not_empty; /*!< Condition indicates not empty */
+    pthread_cond_t cond_not_full;  /*!< Condition indicates not full */
+    size_t in, out, size;
+    void* entries[1];
+} posix_mbox_t;
+
+static struct timespec sys_start_time;
+static lwcell_sys_mutex_t sys_mutex; /* Mutex ID for main protection */
+
+static uint8_t
+mbox_is_full(posix_mbox_t* m) {
+    return ((m->in + 1) % m->size) == m->out;
+}
+
+static uint8_t
+mbox_is_empty(posix_mbox_t* m) {
+    return m->in == m->out;
+}
+
+/**
+ * \brief           Get absolute time for timed waits
+ * \param[out]      ts: Output time structure
+ * \param[in]       timeout: Timeout in units of milliseconds from now
+ */
+static void
+get_abs_time(struct timespec* ts, uint32_t timeout) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += timeout / 1000;
+    ts->tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ++ts->tv_sec;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+uint8_t
+lwcell_sys_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &sys_start_time);
+
+    lwcell_sys_mutex_create(&sys_mutex);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_now(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - sys_start_time.tv_sec) * 1000
+                      + (now.tv_nsec - sys_start_time.tv_nsec) / 1000000L);
+}
+
+uint8_t
+lwcell_sys_protect(void) {
+    lwcell_sys_mutex_lock(&sys_mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_unprotect(void) {
+    lwcell_sys_mutex_unlock(&sys_mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_protect_try(void) {
+    return lwcell_sys_mutex_trylock(&sys_mutex);
+}
+
+uint8_t
+lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
+    pthread_mutex_t* m;
+    pthread_mutexattr_t attr;
+
+    *p = NULL;
+    m = malloc(sizeof(*m));
+    if (m != NULL) {
+        /* Core protection may be nested, mutex must be recursive */
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        if (pthread_mutex_init(m, &attr) == 0) {
+            *p = m;
+        } else {
+            free(m);
+        }
+        pthread_mutexattr_destroy(&attr);
+    }
+    return *p != NULL;
+}
+
+uint8_t
+lwcell_sys_mutex_delete(lwcell_sys_mutex_t* p) {
+    pthread_mutex_destroy(*p);
+    free(*p);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
+    return pthread_mutex_lock(*p) == 0;
+}
+
+uint8_t
+lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p) {
+    return pthread_mutex_trylock(*p) == 0;
+}
+
+uint8_t
+lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
+    return pthread_mutex_unlock(*p) == 0;
+}
+
+uint8_t
+lwcell_sys_mutex_isvalid(lwcell_sys_mutex_t* p) {
+    return p != NULL && *p != NULL;
+}
+
+uint8_t
+lwcell_sys_mutex_invalid(lwcell_sys_mutex_t* p) {
+    *p = LWCELL_SYS_MUTEX_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_create(lwcell_sys_sem_t* p, uint8_t cnt) {
+    posix_sem_t* s;
+
+    *p = NULL;
+    s = malloc(sizeof(*s));
+    if (s != NULL) {
+        pthread_mutex_init(&s->mutex, NULL);
+        pthread_cond_init(&s->cond, NULL);
+        s->cnt = !!cnt;
+        *p = s;
+    }
+    return *p != NULL;
+}
+
+uint8_t
+lwcell_sys_sem_delete(lwcell_sys_sem_t* p) {
+    posix_sem_t* s = *p;
+
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->mutex);
+    free(s);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_sem_wait(lwcell_sys_sem_t* p, uint32_t timeout) {
+    posix_sem_t* s = *p;
+    struct timespec ts;
+    uint32_t time = lwcell_sys_now();
+
+    if (timeout > 0) {
+        get_abs_time(&ts, timeout);
+    }
+    pthread_mutex_lock(&s->mutex);
+    while (s->cnt == 0) {
+        if (timeout == 0) {
+            pthread_cond_wait(&s->cond, &s->mutex);
+        } else if (pthread_cond_timedwait(&s->cond, &s->mutex, &ts) == ETIMEDOUT && s->cnt == 0) {
+            pthread_mutex_unlock(&s->mutex);
+            return LWCELL_SYS_TIMEOUT;
+        }
+    }
+    s->cnt = 0;
+    pthread_mutex_unlock(&s->mutex);
+    return lwcell_sys_now() - time;
+}
+
+uint8_t
+lwcell_sys_sem_release(lwcell_sys_sem_t* p) {
+    posix_sem_t* s = *p;
+
+    pthread_mutex_lock(&s->mutex);
+    s->cnt = 1;
+    pthread_cond_signal(&s->cond);
+    pthread_mutex_unlock(&s->mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_isvalid(lwcell_sys_sem_t* p) {
+    return p != NULL && *p != NULL;
+}
+
+uint8_t
+lwcell_sys_sem_invalid(lwcell_sys_sem_t* p) {
+    *p = LWCELL_SYS_SEM_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
+    posix_mbox_t* mbox;
+
+    *b = NULL;
+
+    mbox = malloc(sizeof(*mbox) + size * sizeof(void*));
+    if (mbox != NULL) {
+        memset(mbox, 0x00, sizeof(*mbox));
+        mbox->size = size + 1; /* Set it to 1 more as cyclic buffer has only one less than size */
+        pthread_mutex_init(&mbox->mutex, NULL);
+        pthread_cond_init(&mbox->cond_not_empty, NULL);
+        pthread_cond_init(&mbox->cond_not_full, NULL);
+        *b = mbox;
+    }
+    return *b != NULL;
+}
+
+uint8_t
+lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
+    posix_mbox_t* mbox = *b;
+
+    pthread_cond_destroy(&mbox->cond_not_full);
+    pthread_cond_destroy(&mbox->cond_not_empty);
+    pthread_mutex_destroy(&mbox->mutex);
+    free(mbox);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_mbox_put(lwcell_sys_mbox_t* b, void* m) {
+    posix_mbox_t* mbox = *b;
+    uint32_t time = lwcell_sys_now();
+
+    pthread_mutex_lock(&mbox->mutex);
+    while (mbox_is_full(mbox)) {
+        pthread_cond_wait(&mbox->cond_not_full, &mbox->mutex);
+    }
+    mbox->entries[mbox->in] = m;
+    if (++mbox->in >= mbox->size) {
+        mbox->in = 0;
+    }
+    pthread_cond_signal(&mbox->cond_not_empty);
+    pthread_mutex_unlock(&mbox->mutex);
+    return lwcell_sys_now() - time;
+}
+
+uint32_t
+lwcell_sys_mbox_get(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
+    posix_mbox_t* mbox = *b;
+    struct timespec ts;
+    uint32_t time = lwcell_sys_now();
+
+    if (timeout > 0) {
+        get_abs_time(&ts, timeout);
+    }
+    pthread_mutex_lock(&mbox->mutex);
+    while (mbox_is_empty(mbox)) {
+        if (timeout == 0) {
+            pthread_cond_wait(&mbox->cond_not_empty, &mbox->mutex);
+        } else if (pthread_cond_timedwait(&mbox->cond_not_empty, &mbox->mutex, &ts) == ETIMEDOUT
+                   && mbox_is_empty(mbox)) {
+            pthread_mutex_unlock(&mbox->mutex);
+            return LWCELL_SYS_TIMEOUT;
+        }
+    }
+    *m = mbox->entries[mbox->out];
+    if (++mbox->out >= mbox->size) {
+        mbox->out = 0;
+    }
+    pthread_cond_signal(&mbox->cond_not_full);
+    pthread_mutex_unlock(&mbox->mutex);
+    return lwcell_sys_now() - time;
+}
+
+uint8_t
+lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
+    posix_mbox_t* mbox = *b;
+
+    pthread_mutex_lock(&mbox->mutex);
+    if (mbox_is_full(mbox)) {
+        pthread_mutex_unlock(&mbox->mutex);
+        return 0;
+    }
+    mbox->entries[mbox->in] = m;
+    if (++mbox->in >= mbox->size) {
+        mbox->in = 0;
+    }
+    pthread_cond_signal(&mbox->cond_not_empty);
+    pthread_mutex_unlock(&mbox->mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
+    posix_mbox_t* mbox = *b;
+
+    pthread_mutex_lock(&mbox->mutex);
+    if (mbox_is_empty(mbox)) {
+        pthread_mutex_unlock(&mbox->mutex);
+        return 0;
+    }
+    *m = mbox->entries[mbox->out];
+    if (++mbox->out >= mbox->size) {
+        mbox->out = 0;
+    }
+    pthread_cond_signal(&mbox->cond_not_full);
+    pthread_mutex_unlock(&mbox->mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_isvalid(lwcell_sys_mbox_t* b) {
+    return b != NULL && *b != NULL; /* Return status if message box is valid */
+}
+
+uint8_t
+lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
+    *b = LWCELL_SYS_MBOX_NULL; /* Invalidate message box */
+    return 1;
+}
+
+/**
+ * \brief           Thread start parameters, freed by started thread
+ */
+typedef struct {
+    lwcell_sys_thread_fn fn; /*!< Thread function */
+    void* arg;               /*!< Thread argument */
+} posix_thread_start_t;
+
+static void*
+thread_entry(void* arg) {
+    posix_thread_start_t start = *(posix_thread_start_t*)arg;
+
+    free(arg);
+    start.fn(start.arg);
+    return NULL;
+}
+
+uint8_t
+lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
+                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
+    pthread_t* h;
+    posix_thread_start_t* start;
+
+    LWCELL_UNUSED(name);
+    LWCELL_UNUSED(stack_size);
+    LWCELL_UNUSED(prio);
+
+    h = malloc(sizeof(*h));
+    start = malloc(sizeof(*start));
+    if (h == NULL || start == NULL) {
+        free(h);
+        free(start);
+        return 0;
+    }
+    start->fn = thread_func;
+    start->arg = arg;
+    if (pthread_create(h, NULL, thread_entry, start) != 0) {
+        free(h);
+        free(start);
+        return 0;
+    }
+    pthread_detach(*h);
+    if (t != NULL) {
+        *t = h;
+    } else {
+        free(h);
+    }
+    return 1;
+}
+
+uint8_t
+lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
+    if (t == NULL) { /* Shall we terminate ourself? */
+        pthread_exit(NULL);
+    } else {
+        pthread_cancel(*(pthread_t*)*t);
+        free(*t);
+        *t = NULL;
+    }
+    return 1;
+}
+
+uint8_t
+lwcell_sys_thread_yield(void) {
+    /* Not implemented */
+    return 1;
+}
+
+#endif /* !__DOXYGEN__ */
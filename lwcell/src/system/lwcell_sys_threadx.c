@@ -110,6 +110,11 @@ lwcell_sys_unprotect(void) {
     return lwcell_sys_mutex_unlock(&sys_mutex);
 }
 
+uint8_t
+lwcell_sys_protect_try(void) {
+    return lwcell_sys_mutex_trylock(&sys_mutex);
+}
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     return tx_mutex_create(p, TX_NULL, TX_INHERIT) == TX_SUCCESS ? 1 : 0;
@@ -125,6 +130,11 @@ lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
     return tx_mutex_get(p, TX_WAIT_FOREVER) == TX_SUCCESS ? 1 : 0;
 }
 
+uint8_t
+lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p) {
+    return tx_mutex_get(p, TX_NO_WAIT) == TX_SUCCESS ? 1 : 0;
+}
+
 uint8_t
 lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
     return tx_mutex_put(p) == TX_SUCCESS ? 1 : 0;
@@ -105,6 +105,11 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+uint8_t
+lwcell_sys_protect_try(void) {
+    return lwcell_sys_mutex_trylock(&sys_mutex);
+}
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     *p = CreateMutex(NULL, FALSE, NULL);
@@ -126,6 +131,11 @@ lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
     return 1;
 }
 
+uint8_t
+lwcell_sys_mutex_trylock(lwcell_sys_mutex_t* p) {
+    return WaitForSingleObject(*p, 0) == WAIT_OBJECT_0;
+}
+
 uint8_t
 lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
     return (uint8_t)ReleaseMutex(*p);